@@ -0,0 +1,756 @@
+/**
+ * @file async_scanner.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of classes for pipelined asynchronous scanning of TCP ports
+ */
+
+#include "async_scanner.hpp"
+#include "timing_wheel.hpp"
+#include "rtt_estimator.hpp"
+#include "scan_permutation.hpp"
+#include "socket_filter.hpp"
+#include "system_utils.hpp"
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <deque>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <exception>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netinet/ip.h>
+#include <netinet/ip6.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+
+// Constructors of asynchronous scanners
+
+AsyncTcpScanner::AsyncTcpScanner(const ScannerParams& params, int ipvType): Scanner(params), ipvType(ipvType), recvBatch(MAX_BUFFER_SIZE) {
+    this->srcAddr = this->plan.getSourceAddress(ipvType);
+    this->probeTemplate = ProbeTemplate(this->srcAddr);
+}
+TcpIpv4AsyncScanner::TcpIpv4AsyncScanner(const ScannerParams& params): AsyncTcpScanner(params, AF_INET) {}
+TcpIpv6AsyncScanner::TcpIpv6AsyncScanner(const ScannerParams& params): AsyncTcpScanner(params, AF_INET6) {}
+
+// Method for building SYN header of probe from template
+
+void AsyncTcpScanner::buildProbe(const ProbeKey& probe, struct tcphdr& tcpHeader) {
+    // Checksum is patched only by changed words of destination, ports and sequence number
+    this->probeTemplate.setDestination(probe.dst);
+    this->probeTemplate.buildTcpSyn(probe.srcPort, probe.dstPort, this->cookie.sequence(probe.dst, probe.dstPort), tcpHeader);
+}
+
+// Method for sending one SYN probe
+
+int AsyncTcpScanner::sendProbe(int fdSock, const ProbeKey& probe) {
+    struct tcphdr tcpHeader;
+    this->buildProbe(probe, tcpHeader);
+    // Create socket destination address for sending, port of raw socket must be zero for IPv6 and is not used for IPv4
+    struct sockaddr_storage sockDstAddr;
+    socklen_t sockDstAddrLen = probe.dst.toSockaddr(sockDstAddr, 0);
+
+    // In transmit ring mode complete frame is written to ring, destination without resolved next hop is sent by raw socket
+    if (this->txRing) {
+        auto nextHop = this->nextHopMacs.find(probe.dst);
+        if (nextHop != this->nextHopMacs.end()) {
+            char* frame = this->txRing->frame();
+            // All frames wait for sending
+            if (frame == nullptr) return this->txRing->flush() == -1 ? -1 : 0;
+            this->txRing->commit(this->buildFrame(probe, nextHop->second, frame));
+            return 1;
+        }
+    }
+    // In batch mode probe is queued, full queue is sent before
+    if (this->scanParams.isBatchMode()) {
+        if (this->sendBatch.full() && this->flushProbes(fdSock) == -1) return -1;
+        return this->sendBatch.add(&tcpHeader, sizeof(struct tcphdr), sockDstAddr, sockDstAddrLen) ? 1 : 0;
+    }
+    if (sendto(fdSock, &tcpHeader, sizeof(struct tcphdr), 0, (struct sockaddr*)&sockDstAddr, sockDstAddrLen) == -1) {
+        // Broadcast address of scanned block is refused by kernel, probe stays without reply -> filtered
+        if (errno == EACCES) return 1;
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) ? 0 : -1;
+    }
+    return 1;
+}
+
+// Method for sending probes queued in batch mode
+
+int AsyncTcpScanner::flushProbes(int fdSock) {
+    // Frames written to ring are sent by one call
+    if (this->txRing) {
+        int flushed = this->txRing->flush();
+        if (flushed != 1) return flushed;
+    }
+    if (this->sendBatch.empty()) return 1;
+    if (this->sendBatch.flush(fdSock) == -1) return -1;
+    return this->sendBatch.empty() ? 1 : 0;
+}
+
+// Method for building complete link layer frame of probe
+
+size_t AsyncTcpScanner::buildFrame(const ProbeKey& probe, const MacAddress& dstMac, char* frame) {
+    // Ethernet header
+    struct ethhdr* ethHeader = (struct ethhdr*)frame;
+    memcpy(ethHeader->h_dest, dstMac.bytes, ETH_ALEN);
+    memcpy(ethHeader->h_source, this->localMac.bytes, ETH_ALEN);
+    ethHeader->h_proto = htons(this->ipvType == AF_INET ? ETH_P_IP : ETH_P_IPV6);
+    // IP header and TCP header after it
+    size_t ipHeaderLen = this->buildIpHeader(probe, frame + sizeof(struct ethhdr), sizeof(struct tcphdr));
+    struct tcphdr tcpHeader;
+    this->buildProbe(probe, tcpHeader);
+    memcpy(frame + sizeof(struct ethhdr) + ipHeaderLen, &tcpHeader, sizeof(struct tcphdr));
+    return sizeof(struct ethhdr) + ipHeaderLen + sizeof(struct tcphdr);
+}
+
+// Method for scanning, creates descriptors and runs stateful or stateless loop
+
+void AsyncTcpScanner::scan() {
+    // In threaded mode scan is split to shards, each of them is scanned by own scanner object
+    if (this->scanParams.getThreads() > 1 && this->shardCount == 1) {
+        this->scanThreaded();
+        return;
+    }
+    // Finished stage of resumed scan is skipped
+    if (this->checkpoint && this->checkpoint->progress(Checkpoint::stageName(this->ipvType, IPPROTO_TCP)).done) return;
+
+    // Create and bind socket to interface
+    int fdSock = this->createSocket(this->ipvType, IPPROTO_TCP);
+    if (fdSock == -1) throw std::runtime_error("Could not create or bind socket!");
+    // Socket is non-blocking, so sending and receiving never stops the loop
+    if (!SystemUtils::setNonBlocking(fdSock)) {
+        this->closeSocket(fdSock);
+        throw std::runtime_error("Could not set socket non-blocking!");
+    }
+    // Replies of whole window can arrive before they are read, default receive buffer is too small for them
+    int recvBuffer = SOCKET_RECV_BUFFER;
+    if (setsockopt(fdSock, SOL_SOCKET, SO_RCVBUFFORCE, &recvBuffer, sizeof(recvBuffer)) == -1) {
+        setsockopt(fdSock, SOL_SOCKET, SO_RCVBUF, &recvBuffer, sizeof(recvBuffer));
+    }
+
+    // In ring mode replies are received by packet ring of interface, raw socket is used only for sending
+    int recvFd = fdSock;
+    if (this->scanParams.isRxRingMode()) {
+        try {
+            this->rxRing = std::make_unique<RxRing>(this->plan.getInterfaceName(), this->ipvType == AF_INET ? ETH_P_IP : ETH_P_IPV6);
+        } catch (...) {
+            this->closeSocket(fdSock);
+            throw;
+        }
+        // Raw socket would queue copies of all replies, so it drops everything, ring gets only replies
+        SocketFilter::attach(fdSock, SocketFilter::dropAll());
+        SocketFilter::attach(this->rxRing->fd(), SocketFilter::tcpReplies(this->ipvType, true, DEFAULT_SOURCE_PORT, MAX_SOURCE_PORT, this->shardIndex, this->shardCount));
+        recvFd = this->rxRing->fd();
+    } else if (this->shardCount > 1) {
+        // Socket of shard gets only replies to source ports of shard
+        if (!SocketFilter::attach(fdSock, SocketFilter::tcpReplies(this->ipvType, this->ipvType == AF_INET, DEFAULT_SOURCE_PORT, MAX_SOURCE_PORT, this->shardIndex, this->shardCount))) {
+            this->closeSocket(fdSock);
+            throw std::runtime_error("Could not attach filter to socket!");
+        }
+    }
+
+    // In transmit ring mode frames are built for next hops resolved before scan
+    if (this->scanParams.isTxRingMode()) {
+        try {
+            NextHopResolver resolver(this->plan.getInterfaceName());
+            resolver.resolve(this->getDestinations(), this->nextHopMacs);
+            this->localMac = resolver.interfaceMac();
+            this->txRing = std::make_unique<TxRing>(this->plan.getInterfaceName(), this->scanParams.isQdiscBypass());
+        } catch (...) {
+            this->closeSocket(fdSock);
+            throw;
+        }
+    }
+
+    // Create epoll instance for timeout handling
+    int epollFd = this->createEpoll();
+    if (epollFd == -1) {
+        this->closeSocket(fdSock);
+        throw std::runtime_error("Could not create epoll instance!");
+    }
+
+    // In threaded mode replies are received by receiver thread, so loop waits for its signal instead of socket
+    int waitFd = recvFd;
+    if (this->shardCount > 1) {
+        this->wakeFd = eventfd(0, EFD_NONBLOCK);
+        if (this->wakeFd == -1) {
+            this->closeSocket(fdSock);
+            this->closeEpoll(epollFd);
+            throw std::runtime_error("Could not create eventfd!");
+        }
+        waitFd = this->wakeFd;
+    }
+
+    // Add receiving socket to epoll
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = waitFd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, waitFd, &ev) == -1) {
+        this->closeSocket(fdSock);
+        this->closeEpoll(epollFd);
+        if (this->wakeFd != -1) close(this->wakeFd);
+        throw std::runtime_error("Could not add socket to epoll!");
+    }
+
+    // Run scanning loop, descriptors are freed also when loop fails
+    try {
+        if (this->shardCount > 1) this->scanShard(fdSock, recvFd, epollFd);
+        else if (this->scanParams.isStatelessMode()) this->scanStateless(fdSock, epollFd);
+        else this->scanStateful(fdSock, epollFd);
+    } catch (...) {
+        this->closeSocket(fdSock);
+        this->closeEpoll(epollFd);
+        if (this->wakeFd != -1) close(this->wakeFd);
+        throw;
+    }
+
+    // Free descriptors
+    this->closeSocket(fdSock);
+    this->closeEpoll(epollFd);
+    if (this->wakeFd != -1) close(this->wakeFd);
+}
+
+// Method for threaded scanning, shards are scanned in sender threads and their results are printed by this thread
+
+void AsyncTcpScanner::scanThreaded() {
+    unsigned count = this->scanParams.getThreads();
+    // Each shard has own limiter with part of rate and burst
+    uint64_t rate = this->scanParams.getRate();
+    uint64_t burst = this->scanParams.getBurst();
+
+    // Create scanners of shards
+    std::vector<std::unique_ptr<AsyncTcpScanner>> shards;
+    for (unsigned i = 0; i < count; i++) {
+        std::unique_ptr<AsyncTcpScanner> shard = this->createShard();
+        shard->shardIndex = i;
+        shard->shardCount = count;
+        shard->cookie.setShard(i, count);
+        if (rate) shard->rateLimiter = RateLimiter(std::max<uint64_t>(1, rate / count), std::max<uint64_t>(1, burst / count));
+        shard->results = std::make_unique<SpscQueue<ScanResult>>(RESULT_QUEUE_SIZE);
+        shards.push_back(std::move(shard));
+    }
+
+    // Run scan of every shard in own thread, error of shard is passed to this thread
+    std::vector<std::exception_ptr> errors(count);
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < count; i++) {
+        threads.emplace_back([&shards, &errors, i]() {
+            try {
+                shards[i]->scan();
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+            shards[i]->finished.store(true, std::memory_order_release);
+        });
+    }
+
+    // Print results until all shards finish, results pushed before end of shard are read after its flag
+    bool running = true;
+    while (running) {
+        running = false;
+        bool printed = false;
+        for (std::unique_ptr<AsyncTcpScanner>& shard : shards) {
+            bool finished = shard->finished.load(std::memory_order_acquire);
+            ScanResult result;
+            while (shard->results->pop(result)) {
+                this->printResult(result.dst, result.port, result.state, result.rtt);
+                printed = true;
+            }
+            if (!finished) running = true;
+        }
+        if (running && !printed) std::this_thread::sleep_for(std::chrono::milliseconds(RESULT_POLL_TIME));
+    }
+
+    // Wait for threads and report first error
+    for (std::thread& thread : threads) thread.join();
+    for (std::exception_ptr& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+// Method for running loop of shard with receiver thread
+
+void AsyncTcpScanner::scanShard(int fdSock, int recvFd, int epollFd) {
+    // Receiver thread waits for receiving socket by own epoll instance
+    int recvEpollFd = this->createEpoll();
+    if (recvEpollFd == -1) throw std::runtime_error("Could not create epoll instance!");
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = recvFd;
+    if (epoll_ctl(recvEpollFd, EPOLL_CTL_ADD, recvFd, &ev) == -1) {
+        this->closeEpoll(recvEpollFd);
+        throw std::runtime_error("Could not add socket to epoll!");
+    }
+
+    // Start receiver thread, its error is passed to this thread
+    this->replies = std::make_unique<SpscQueue<TcpReply>>(REPLY_QUEUE_SIZE);
+    std::exception_ptr receiverError;
+    std::thread receiver([this, fdSock, recvEpollFd, &receiverError]() {
+        try {
+            this->receiveLoop(fdSock, recvEpollFd);
+        } catch (...) {
+            receiverError = std::current_exception();
+        }
+    });
+
+    // Run scanning loop, receiver thread is stopped also when loop fails
+    try {
+        if (this->scanParams.isStatelessMode()) this->scanStateless(fdSock, epollFd);
+        else this->scanStateful(fdSock, epollFd);
+    } catch (...) {
+        this->receiverStop.store(true, std::memory_order_release);
+        receiver.join();
+        this->closeEpoll(recvEpollFd);
+        throw;
+    }
+    this->receiverStop.store(true, std::memory_order_release);
+    receiver.join();
+    this->closeEpoll(recvEpollFd);
+    if (receiverError) std::rethrow_exception(receiverError);
+}
+
+// Loop of receiver thread
+
+void AsyncTcpScanner::receiveLoop(int fdSock, int epollFd) {
+    while (!this->receiverStop.load(std::memory_order_acquire)) {
+        if (!this->waitForReply(epollFd, RECEIVER_POLL_TIME)) continue;
+        // Pass all received replies to sender thread, full queue is waited out
+        TcpReply reply;
+        bool received = false;
+        while (this->receiveReply(fdSock, reply)) {
+            while (!this->replies->push(reply)) std::this_thread::yield();
+            received = true;
+        }
+        // Sender thread is woken up once for all passed replies
+        uint64_t signal = 1;
+        if (received && write(this->wakeFd, &signal, sizeof(signal)) == -1 && errno != EAGAIN) {
+            throw std::runtime_error("Could not signal sender thread!");
+        }
+    }
+}
+
+// Method for waiting for readable socket
+
+bool AsyncTcpScanner::waitForReply(int epollFd, int waitTime) {
+    struct epoll_event events[MAX_EVENTS];
+    int epollState = epoll_wait(epollFd, events, MAX_EVENTS, waitTime);
+    if (epollState == -1 && errno != EINTR) throw std::runtime_error("Epoll_wait failed!");
+    // Signal of receiver thread is consumed before its replies are taken, so later replies signal again
+    if (epollState > 0 && events[0].data.fd == this->wakeFd) {
+        uint64_t signals;
+        if (read(this->wakeFd, &signals, sizeof(signals)) == -1 && errno != EAGAIN) throw std::runtime_error("Could not read signal of receiver thread!");
+    }
+    return epollState > 0;
+}
+
+// Method for checking if reply answers probe of this scan
+
+bool AsyncTcpScanner::isValidReply(const TcpReply& reply) {
+    if (!(reply.flags & TH_RST) && !((reply.flags & TH_SYN) && (reply.flags & TH_ACK))) return false;
+    return this->cookie.verify(reply.src, reply.srcPort, reply.dstPort, reply.ack);
+}
+
+// Method for receiving next reply which carries cookie of this scan
+
+bool AsyncTcpScanner::receiveReply(int fdSock, TcpReply& reply) {
+    const char* packet;
+    size_t length;
+    // In ring mode packets of interface are parsed in place in ring, raw socket is not read
+    if (this->rxRing) {
+        while (this->rxRing->next(packet, length)) {
+            if (this->parsePacket(packet, length, reply) && this->isValidReply(reply)) return true;
+        }
+        return false;
+    }
+    // In batch mode replies are received by recvmmsg and parsed directly in buffers of batch
+    if (this->scanParams.isBatchMode()) {
+        const struct sockaddr_storage* from;
+        while (this->recvBatch.next(fdSock, packet, length, from)) {
+            if (this->parseReply(packet, (ssize_t)length, *from, reply) && this->isValidReply(reply)) return true;
+        }
+        return false;
+    }
+    while (true) {
+        // Buffer for received packet
+        char buffer[MAX_BUFFER_SIZE];
+        // Receive socket address
+        struct sockaddr_storage recvAddr;
+        socklen_t recvAddrLen = sizeof(recvAddr);
+        ssize_t received = recvfrom(fdSock, buffer, sizeof(buffer), 0, (struct sockaddr*)&recvAddr, &recvAddrLen);
+        if (received == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+            throw std::runtime_error("Cannot receive packet!");
+        }
+        // Parse received packet and check its cookie
+        if (this->parseReply(buffer, received, recvAddr, reply) && this->isValidReply(reply)) return true;
+    }
+}
+
+// Method for getting next valid reply for loop
+
+bool AsyncTcpScanner::nextReply(int fdSock, TcpReply& reply) {
+    if (this->replies) return this->replies->pop(reply);
+    return this->receiveReply(fdSock, reply);
+}
+
+// Method for printing state of port
+
+void AsyncTcpScanner::printResult(const IpAddress& dst, uint16_t port, portState state, uint32_t rtt) {
+    // In threaded mode result is printed by printing thread, full queue is waited out
+    if (this->results) {
+        ScanResult result{dst, port, state, rtt};
+        while (!this->results->push(result)) std::this_thread::yield();
+        return;
+    }
+    this->writeResult(dst, port, state, rtt);
+}
+
+// Pipelined loop with table of probes waiting for response
+
+void AsyncTcpScanner::scanStateful(int fdSock, int epollFd) {
+    // Targets of scan, addresses are generated from their index
+    const TargetGenerator& destinations = this->getDestinations();
+    const std::vector<uint16_t>& ports = this->plan.getTcpPorts();
+    // Timeouts of destinations are derived from their round trip time, --wait is upper bound
+    // Memory of estimators is bounded, so destinations of large ranges share them by index modulo count of estimators
+    size_t estimatorCount = (size_t)std::min<uint64_t>(destinations.size(), RTT_ESTIMATOR_SLOTS);
+    std::vector<RttEstimator> estimators(estimatorCount, RttEstimator(this->plan.getTimeout()));
+
+    // Probes waiting for response and their deadlines, one tick of wheel is one millisecond from start of scan
+    ProbeTable table(MAX_IN_FLIGHT);
+    TimingWheel wheel(MAX_IN_FLIGHT);
+    std::vector<uint32_t> expired;
+    expired.reserve(MAX_IN_FLIGHT);
+    // Expired probes waiting for retransmission, they stay in table without timer
+    std::deque<uint32_t> retransmit;
+    // Probe answered after expiration is erased from table, its stale identifier is removed when it reaches front of queue
+    auto dropAnswered = [&]() {
+        while (!retransmit.empty() && !table.at(retransmit.front()).queued) retransmit.pop_front();
+    };
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Position of next probe of shard to send, probes of target x port space are sent in pseudo-random order
+    uint64_t total = destinations.size() * ports.size();
+    uint64_t position = this->shardIndex;
+    ScanPermutation order(total, this->scanParams.getSeed());
+    // Probes which differed in baseline are sent before sweep, sweep skips their positions
+    std::vector<uint64_t> prioritized;
+    size_t nextPrioritized = 0;
+    if (this->baseline && this->scanParams.isChangedFirst()) prioritized = this->baseline->priority(destinations, ports, IPPROTO_TCP);
+    // Resumed scan continues from saved step, indexes of probes which were waiting for response are sent first
+    std::string stage = Checkpoint::stageName(this->ipvType, IPPROTO_TCP);
+    std::deque<uint64_t> resumed;
+    std::vector<uint64_t> waiting;
+    if (this->checkpoint) {
+        StageProgress progress = this->checkpoint->progress(stage);
+        progress.restore(prioritized.size(), nextPrioritized, position);
+        resumed.assign(progress.pending.begin(), progress.pending.end());
+    }
+    auto skipPrioritized = [&]() {
+        if (prioritized.empty()) return;
+        while (position < total && std::binary_search(prioritized.begin(), prioritized.end(), order.at(position))) position += this->shardCount;
+    };
+    skipPrioritized();
+
+    while (position < total || !resumed.empty() || nextPrioritized < prioritized.size() || !table.empty()) {
+        uint64_t now = SystemUtils::elapsedMicros(startTime) / 1000;
+        // Flag for full send buffer of socket
+        bool socketBusy = false;
+
+        // Send retransmissions and new probes while window is not full, at most SEND_BURST before receiving
+        bool pending = !retransmit.empty() || ((position < total || !resumed.empty() || nextPrioritized < prioritized.size()) && !table.full());
+        for (int burst = 0; burst < SEND_BURST && pending; burst++) {
+            // Probe can leave only with token of rate limiter
+            if (!this->rateLimiter.tryAcquire()) break;
+            // Retransmissions have priority before new probes
+            if (!retransmit.empty()) {
+                uint32_t id = retransmit.front();
+                int sent = this->sendProbe(fdSock, table.at(id).key);
+                if (sent == -1) throw std::runtime_error("Could not send packet!");
+                if (sent == 0) {
+                    socketBusy = true;
+                    break;
+                }
+                retransmit.pop_front();
+                ProbeRecord& record = table.at(id);
+                record.queued = false;
+                dropAnswered();
+                record.sentAt = SystemUtils::elapsedMicros(startTime);
+                wheel.schedule(id, now + estimators[record.target].timeout(record.retries));
+            } else {
+                bool priority = resumed.empty() && nextPrioritized < prioritized.size();
+                uint64_t probeIndex = !resumed.empty() ? resumed.front() : priority ? prioritized[nextPrioritized] : order.at(position);
+                uint64_t dstIndex = probeIndex / ports.size();
+                uint32_t estimator = (uint32_t)(dstIndex % estimatorCount);
+                IpAddress dst = destinations.at(dstIndex);
+                uint16_t port = ports[probeIndex % ports.size()];
+                ProbeKey probe{dst, port, this->cookie.sourcePort(dst, port)};
+                int sent = this->sendProbe(fdSock, probe);
+                if (sent == -1) throw std::runtime_error("Could not send packet!");
+                // Send buffer is full, try it again after receiving
+                if (sent == 0) {
+                    socketBusy = true;
+                    break;
+                }
+                uint32_t id = table.insert(probe);
+                if (id != NO_PROBE) {
+                    table.at(id).target = estimator;
+                    table.at(id).sentAt = SystemUtils::elapsedMicros(startTime);
+                    table.at(id).index = probeIndex;
+                    wheel.schedule(id, now + estimators[estimator].timeout(0));
+                }
+
+                // Move to next probe of shard
+                if (!resumed.empty()) {
+                    resumed.pop_front();
+                } else if (priority) {
+                    nextPrioritized++;
+                } else {
+                    position += this->shardCount;
+                    skipPrioritized();
+                }
+            }
+            pending = !retransmit.empty() || ((position < total || !resumed.empty() || nextPrioritized < prioritized.size()) && !table.full());
+        }
+        // Queued batch of probes is sent at once, unsent rest is sent after receiving
+        int flushed = this->flushProbes(fdSock);
+        if (flushed == -1) throw std::runtime_error("Could not send packet!");
+        if (flushed == 0) socketBusy = true;
+
+        // Wait until nearest event of wheel, or shortly when there are still probes to send
+        int waitTime = 0;
+        uint64_t nextEvent = wheel.nextEvent();
+        if (nextEvent != UINT64_MAX && nextEvent > now) waitTime = (int)(nextEvent - now);
+        if (socketBusy && waitTime > SEND_BUSY_WAIT) waitTime = SEND_BUSY_WAIT;
+        // Probes to send are waiting only for next token of rate limiter
+        bool paced = !socketBusy && pending;
+        if (paced) waitTime = std::min(waitTime, (int)(this->rateLimiter.timeUntilToken() / 1000000));
+
+        // Drain all received replies and resolve probes which they answer
+        if (this->waitForReply(epollFd, waitTime)) {
+            TcpReply reply;
+            uint64_t receivedAt = SystemUtils::elapsedMicros(startTime);
+            while (this->nextReply(fdSock, reply)) {
+                uint32_t id = table.find(ProbeKey{reply.src, reply.srcPort, reply.dstPort});
+                if (id == NO_PROBE) continue;
+                // Only reply to not retransmitted probe can be measured
+                ProbeRecord& record = table.at(id);
+                if (record.retries == 0) estimators[record.target].sample(receivedAt - record.sentAt);
+                this->printResult(reply.src, reply.srcPort, (reply.flags & TH_RST) ? PORT_TCP_CLOSED : PORT_TCP_OPEN, (uint32_t)(receivedAt - record.sentAt));
+                wheel.cancel(id);
+                table.erase(id);
+            }
+            dropAnswered();
+        }
+        // Token closer than one millisecond of epoll is waited precisely
+        if (paced && waitTime == 0) this->rateLimiter.waitForToken();
+
+        // Resolve expired probes -> retransmission or filtered
+        now = SystemUtils::elapsedMicros(startTime) / 1000;
+        wheel.advance(now, expired);
+        for (uint32_t id : expired) {
+            ProbeRecord& probe = table.at(id);
+            if (probe.retries + 1 < MAX_RETRIES) {
+                // In tcp when timeout is reached, we try to send packet again, it is sent with next burst under rate limit
+                probe.retries++;
+                probe.queued = true;
+                retransmit.push_back(id);
+            } else {
+                this->printResult(probe.key.dst, probe.key.dstPort, PORT_TCP_FILTERED);
+                table.erase(id);
+            }
+        }
+
+        // Save progress periodically, probes waiting for response and not yet resent ones are pending
+        if (this->checkpoint && this->checkpoint->due()) {
+            waiting.assign(resumed.begin(), resumed.end());
+            table.indexes(waiting);
+            this->checkpoint->update(stage, StageProgress::step(prioritized.size(), nextPrioritized, position), waiting);
+            this->checkpoint->save();
+        }
+    }
+    // Finished stage is not scanned again after resume
+    if (this->checkpoint) {
+        this->checkpoint->finish(stage);
+        this->checkpoint->save();
+    }
+}
+
+// Stateless loop, replies are attributed only by their cookie
+
+void AsyncTcpScanner::scanStateless(int fdSock, int epollFd) {
+    // Targets of scan, addresses are generated from their index
+    const TargetGenerator& destinations = this->getDestinations();
+    const std::vector<uint16_t>& ports = this->plan.getTcpPorts();
+    std::chrono::milliseconds timeout(this->plan.getTimeout());
+
+    // Position of next probe of shard to send, probes of target x port space are sent in pseudo-random order
+    uint64_t total = destinations.size() * ports.size();
+    uint64_t position = this->shardIndex;
+    ScanPermutation order(total, this->scanParams.getSeed());
+    // Time after which no more replies are expected
+    auto endTime = std::chrono::steady_clock::now() + timeout;
+
+    while (true) {
+        // Flag for full send buffer of socket
+        bool socketBusy = false;
+
+        // Send probes, at most SEND_BURST before receiving
+        for (int burst = 0; burst < SEND_BURST && position < total; burst++) {
+            // Probe can leave only with token of rate limiter
+            if (!this->rateLimiter.tryAcquire()) break;
+            uint64_t probeIndex = order.at(position);
+            IpAddress dst = destinations.at(probeIndex / ports.size());
+            uint16_t port = ports[probeIndex % ports.size()];
+            int sent = this->sendProbe(fdSock, ProbeKey{dst, port, this->cookie.sourcePort(dst, port)});
+            if (sent == -1) throw std::runtime_error("Could not send packet!");
+            // Send buffer is full, try it again after receiving
+            if (sent == 0) {
+                socketBusy = true;
+                break;
+            }
+            // Move to next probe of shard
+            position += this->shardCount;
+        }
+        // Queued batch of probes is sent at once, unsent rest is sent after receiving
+        int flushed = this->flushProbes(fdSock);
+        if (flushed == -1) throw std::runtime_error("Could not send packet!");
+        if (flushed == 0) socketBusy = true;
+
+        // After last probe, replies are collected for one timeout
+        auto now = std::chrono::steady_clock::now();
+        int waitTime = socketBusy ? SEND_BUSY_WAIT : 0;
+        // Probes to send are waiting only for next token of rate limiter
+        bool paced = !socketBusy && position < total;
+        if (paced) waitTime = (int)(this->rateLimiter.timeUntilToken() / 1000000);
+        if (position < total || socketBusy) {
+            endTime = now + timeout;
+        } else {
+            if (now >= endTime) break;
+            waitTime = (int)std::chrono::ceil<std::chrono::milliseconds>(endTime - now).count();
+        }
+
+        // Drain all received replies, each one carrying valid cookie is result
+        if (this->waitForReply(epollFd, waitTime)) {
+            TcpReply reply;
+            while (this->nextReply(fdSock, reply)) {
+                this->printResult(reply.src, reply.srcPort, (reply.flags & TH_RST) ? PORT_TCP_CLOSED : PORT_TCP_OPEN);
+            }
+        }
+        // Token closer than one millisecond of epoll is waited precisely
+        if (paced && waitTime == 0) this->rateLimiter.waitForToken();
+    }
+}
+
+// Methods of IPv4 pipelined scanner
+
+std::unique_ptr<AsyncTcpScanner> TcpIpv4AsyncScanner::createShard() {
+    return std::make_unique<TcpIpv4AsyncScanner>(this->scanParams);
+}
+
+const TargetGenerator& TcpIpv4AsyncScanner::getDestinations() {
+    return this->plan.getIp4Targets();
+}
+
+bool TcpIpv4AsyncScanner::parseReply(const char* buffer, ssize_t length, const struct sockaddr_storage& from, TcpReply& reply) {
+    (void)from;
+    // IPv4 raw socket receives packet with IP header
+    if (length < (ssize_t)sizeof(struct iphdr)) return false;
+    const struct iphdr* ipHeader = (const struct iphdr*)buffer;
+    size_t ipHeaderLen = ipHeader->ihl * 4;
+    if (ipHeader->protocol != IPPROTO_TCP || length < (ssize_t)(ipHeaderLen + sizeof(struct tcphdr))) return false;
+    // Reply must be sent to address of interface
+    if (memcmp(&ipHeader->daddr, this->srcAddr.bytes, 4) != 0) return false;
+
+    const struct tcphdr* tcpRecive = (const struct tcphdr*)(buffer + ipHeaderLen);
+    reply.src.family = AF_INET;
+    memcpy(reply.src.bytes, &ipHeader->saddr, 4);
+    reply.srcPort = ntohs(tcpRecive->th_sport);
+    reply.dstPort = ntohs(tcpRecive->th_dport);
+    reply.flags = tcpRecive->th_flags;
+    reply.ack = ntohl(tcpRecive->th_ack);
+    return true;
+}
+
+size_t TcpIpv4AsyncScanner::buildIpHeader(const ProbeKey& probe, char* buffer, size_t payloadLen) {
+    struct iphdr* ipHeader = (struct iphdr*)buffer;
+    memset(ipHeader, 0, sizeof(struct iphdr));
+    ipHeader->version = 4;
+    ipHeader->ihl = 5;
+    ipHeader->tot_len = htons(sizeof(struct iphdr) + payloadLen);
+    ipHeader->id = htons(probe.srcPort ^ probe.dstPort);
+    ipHeader->frag_off = htons(IP_DF);
+    ipHeader->ttl = 64;
+    ipHeader->protocol = IPPROTO_TCP;
+    memcpy(&ipHeader->saddr, this->srcAddr.bytes, 4);
+    memcpy(&ipHeader->daddr, probe.dst.bytes, 4);
+    ipHeader->check = this->calculateChecksum((const char*)ipHeader, sizeof(struct iphdr));
+    return sizeof(struct iphdr);
+}
+
+bool TcpIpv4AsyncScanner::parsePacket(const char* packet, size_t length, TcpReply& reply) {
+    // Packet of ring starts by IP header as packet of IPv4 raw socket
+    struct sockaddr_storage from;
+    memset(&from, 0, sizeof(from));
+    return this->parseReply(packet, (ssize_t)length, from, reply);
+}
+
+// Methods of IPv6 pipelined scanner
+
+std::unique_ptr<AsyncTcpScanner> TcpIpv6AsyncScanner::createShard() {
+    return std::make_unique<TcpIpv6AsyncScanner>(this->scanParams);
+}
+
+const TargetGenerator& TcpIpv6AsyncScanner::getDestinations() {
+    return this->plan.getIp6Targets();
+}
+
+bool TcpIpv6AsyncScanner::parseReply(const char* buffer, ssize_t length, const struct sockaddr_storage& from, TcpReply& reply) {
+    // IPv6 raw socket receives packet without IP header, source address is taken from socket address
+    if (length < (ssize_t)sizeof(struct tcphdr) || from.ss_family != AF_INET6) return false;
+    const struct tcphdr* tcpRecive = (const struct tcphdr*)buffer;
+    reply.src = IpAddress::fromSockaddr((const struct sockaddr*)&from);
+    reply.srcPort = ntohs(tcpRecive->th_sport);
+    reply.dstPort = ntohs(tcpRecive->th_dport);
+    reply.flags = tcpRecive->th_flags;
+    reply.ack = ntohl(tcpRecive->th_ack);
+    return true;
+}
+
+size_t TcpIpv6AsyncScanner::buildIpHeader(const ProbeKey& probe, char* buffer, size_t payloadLen) {
+    struct ip6_hdr* ipHeader = (struct ip6_hdr*)buffer;
+    memset(ipHeader, 0, sizeof(struct ip6_hdr));
+    ipHeader->ip6_flow = htonl(6u << 28);
+    ipHeader->ip6_plen = htons(payloadLen);
+    ipHeader->ip6_nxt = IPPROTO_TCP;
+    ipHeader->ip6_hlim = 64;
+    memcpy(&ipHeader->ip6_src, this->srcAddr.bytes, 16);
+    memcpy(&ipHeader->ip6_dst, probe.dst.bytes, 16);
+    return sizeof(struct ip6_hdr);
+}
+
+bool TcpIpv6AsyncScanner::parsePacket(const char* packet, size_t length, TcpReply& reply) {
+    // Packet of ring starts by IPv6 header, replies to SYN have no extension headers
+    if (length < sizeof(struct ip6_hdr) + sizeof(struct tcphdr)) return false;
+    const struct ip6_hdr* ipHeader = (const struct ip6_hdr*)packet;
+    if (ipHeader->ip6_nxt != IPPROTO_TCP) return false;
+    // Reply must be sent to address of interface
+    if (memcmp(&ipHeader->ip6_dst, this->srcAddr.bytes, 16) != 0) return false;
+
+    const struct tcphdr* tcpRecive = (const struct tcphdr*)(packet + sizeof(struct ip6_hdr));
+    reply.src.family = AF_INET6;
+    memcpy(reply.src.bytes, &ipHeader->ip6_src, 16);
+    reply.srcPort = ntohs(tcpRecive->th_sport);
+    reply.dstPort = ntohs(tcpRecive->th_dport);
+    reply.flags = tcpRecive->th_flags;
+    reply.ack = ntohl(tcpRecive->th_ack);
+    return true;
+}
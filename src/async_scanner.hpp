@@ -0,0 +1,366 @@
+/**
+ * @file async_scanner.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Library for pipelined asynchronous scanner of TCP ports
+ */
+
+#ifndef ASYNC_SCANNER_HPP
+#define ASYNC_SCANNER_HPP // ASYNC_SCANNER_HPP
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <unordered_map>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "scanner.hpp"
+#include "ip_address.hpp"
+#include "target_generator.hpp"
+#include "probe_cookie.hpp"
+#include "probe_table.hpp"
+#include "packet_batch.hpp"
+#include "rx_ring.hpp"
+#include "tx_ring.hpp"
+#include "next_hop.hpp"
+#include "spsc_queue.hpp"
+#include "probe_template.hpp"
+
+// Constants for max count of probes waiting for response at once
+#define MAX_IN_FLIGHT 4096
+// Constants for max count of probes sent between two receptions
+#define SEND_BURST 256
+// Constants for time to wait when socket send buffer is full (ms)
+#define SEND_BUSY_WAIT 1
+// Constants for receive buffer size of socket, replies of whole window must fit in
+#define SOCKET_RECV_BUFFER (16 * 1024 * 1024)
+// Constants for max count of round trip time estimators, destinations beyond it share estimators
+#define RTT_ESTIMATOR_SLOTS 65536
+// Constants for size of queues between threads of threaded mode
+#define REPLY_QUEUE_SIZE 65536
+#define RESULT_QUEUE_SIZE 65536
+// Constants for max time of waiting of receiver thread, after which it checks end of scan (ms)
+#define RECEIVER_POLL_TIME 10
+// Constants for time of waiting of printing thread when there are no results (ms)
+#define RESULT_POLL_TIME 1
+
+/**
+ * @brief Struct for reply parsed from received TCP segment
+ */
+struct TcpReply {
+    // Source address of reply -> scanned target
+    IpAddress src;
+    // Source port of reply -> scanned port
+    uint16_t srcPort;
+    // Destination port of reply -> source port of probe
+    uint16_t dstPort;
+    // TCP flags of reply
+    uint8_t flags;
+    // Acknowledgment number of reply
+    uint32_t ack;
+};
+
+/**
+ * @brief Struct for result of scanned port passed from shard to printing thread
+ */
+struct ScanResult {
+    // Scanned address
+    IpAddress dst;
+    // Scanned port
+    uint16_t port;
+    // State of port with protocol
+    portState state;
+    // Round trip time of reply (us), 0 if unknown
+    uint32_t rtt;
+};
+
+/**
+ * @brief Class for pipelined scanning of TCP ports
+ *
+ * Parent class for classes TcpIpv4AsyncScanner and TcpIpv6AsyncScanner.
+ * Unlike TcpIpv4Scanner and TcpIpv6Scanner, it does not wait for response of each port. SYN probes are sent continuously
+ * until MAX_IN_FLIGHT probes are waiting for response, replies are matched to waiting probes as they arrive and
+ * probes without reply are retransmitted or marked as filtered when their timeout expires.
+ * Total scan time is then bounded by send rate plus one timeout instead of ports x timeout.
+ * Sequence number and source port of every probe carry its ProbeCookie, so replies are verified by acknowledgment number.
+ * In batch mode probes are sent by sendmmsg and replies received by recvmmsg, BATCH_SIZE packets per system call.
+ * In ring mode replies are read from TPACKET_V3 ring of interface (RxRing) and raw socket is used only for sending.
+ * In transmit ring mode complete frames are written to PACKET_TX_RING of interface (TxRing) with MAC address of next hop
+ * from kernel tables, destinations without resolved next hop are sent by raw socket.
+ * In stateless mode there is no table of probes at all, replies are attributed only by the cookie, which keeps memory
+ * constant, but silent (filtered) ports are not reported and probes are not retransmitted.
+ * In threaded mode target x port space is split to shards, every shard is scanned by own scanner object in sender thread
+ * with own raw socket and own receiver thread. Source ports of shard are selected by ProbeCookie, so kernel filter of each
+ * socket passes only replies of its shard. Replies go from receiver to sender and results from sender to printing thread
+ * by lock-free SpscQueue.
+ */
+class AsyncTcpScanner : public Scanner {
+    public:
+        /**
+         * @brief Construct a new AsyncTcpScanner object
+         *
+         * @param params - object of ScanParams with scan parameters
+         * @param ipvType - AF_INET or AF_INET6
+         */
+        AsyncTcpScanner(const ScannerParams& params, int ipvType);
+        /**
+         * @brief Method for pipelined scanning of TCP ports
+         *
+         * Method will create non-blocking socket bound to interface and epoll instance and runs stateful or stateless loop.
+         *
+         * @throw std::runtime_error if was detected internal error of other function or system call
+         */
+        void scan() override;
+    protected:
+        /**
+         * @brief Stateful pipelined loop
+         *
+         * In one loop it sends probes while window of MAX_IN_FLIGHT is not full, waits for replies until nearest timeout,
+         * drains all received replies and resolves expired probes -> retransmission or filtered after MAX_RETRIES.
+         * Waiting probes are stored in ProbeTable and their deadlines in TimingWheel with tick of one millisecond.
+         *
+         * @param fdSock - file descriptor of socket
+         * @param epollFd - file descriptor of epoll instance
+         *
+         * @throw std::runtime_error if was detected internal error of system call
+         */
+        void scanStateful(int fdSock, int epollFd);
+        /**
+         * @brief Stateless loop
+         *
+         * Sends every probe once and reports each reply with valid cookie, after last probe waits one timeout for late replies.
+         *
+         * @param fdSock - file descriptor of socket
+         * @param epollFd - file descriptor of epoll instance
+         *
+         * @throw std::runtime_error if was detected internal error of system call
+         */
+        void scanStateless(int fdSock, int epollFd);
+        /**
+         * @brief Method for threaded scanning
+         *
+         * Creates shard scanner for each thread, runs their scans in sender threads and prints their results until
+         * all shards finish. Rate and burst are divided among shards.
+         *
+         * @throw std::runtime_error if scan of some shard failed
+         */
+        void scanThreaded();
+        /**
+         * @brief Method for running loop of shard with receiver thread
+         *
+         * @param fdSock - file descriptor of socket
+         * @param recvFd - file descriptor from which replies are received
+         * @param epollFd - file descriptor of epoll instance waiting for signal of receiver thread
+         *
+         * @throw std::runtime_error if was detected internal error of system call
+         */
+        void scanShard(int fdSock, int recvFd, int epollFd);
+        /**
+         * @brief Loop of receiver thread
+         *
+         * Receives valid replies, passes them to sender thread and signals it, until end of scan.
+         *
+         * @param fdSock - file descriptor of socket
+         * @param epollFd - file descriptor of epoll instance waiting for receiving socket
+         *
+         * @throw std::runtime_error if was detected internal error of system call
+         */
+        void receiveLoop(int fdSock, int epollFd);
+        /**
+         * @brief Method for creating scanner of one shard of threaded mode
+         *
+         * @return scanner of the same family with the same parameters
+         */
+        virtual std::unique_ptr<AsyncTcpScanner> createShard() = 0;
+        /**
+         * @brief Method for waiting for readable socket
+         *
+         * @param epollFd - file descriptor of epoll instance
+         * @param waitTime - max time of waiting in ms
+         * @return true if socket is readable, false if timeout was reached
+         *
+         * @throw std::runtime_error if epoll_wait fails
+         */
+        bool waitForReply(int epollFd, int waitTime);
+        /**
+         * @brief Method for receiving next valid reply
+         *
+         * Receives packets until one is SYN-ACK or RST carrying valid cookie of this scan, in ring mode from RxRing.
+         *
+         * @param fdSock - file descriptor of non-blocking socket
+         * @param reply - received reply
+         * @return true if reply was received, false if there are no more packets
+         *
+         * @throw std::runtime_error if recvfrom fails
+         */
+        bool receiveReply(int fdSock, TcpReply& reply);
+        /**
+         * @brief Method for getting next valid reply for loop
+         *
+         * In threaded mode reply is taken from queue of receiver thread, otherwise it is received from socket.
+         *
+         * @param fdSock - file descriptor of non-blocking socket
+         * @param reply - received reply
+         * @return true if reply was received, false if there are no more replies
+         *
+         * @throw std::runtime_error if recvfrom fails
+         */
+        bool nextReply(int fdSock, TcpReply& reply);
+        /**
+         * @brief Method for checking if reply answers probe of this scan
+         *
+         * @param reply - parsed reply
+         * @return true if reply is SYN-ACK or RST carrying valid cookie of this scan
+         */
+        bool isValidReply(const TcpReply& reply);
+        /**
+         * @brief Method for printing state of port
+         *
+         * In threaded mode result is passed to printing thread.
+         *
+         * @param dst - scanned address
+         * @param port - scanned port
+         * @param state - state of port with protocol
+         * @param rtt - round trip time of reply (us), 0 if unknown
+         */
+        void printResult(const IpAddress& dst, uint16_t port, portState state, uint32_t rtt = 0);
+        /**
+         * @brief Method for getting destination addresses of scanner family
+         *
+         * @return generator of destination addresses
+         */
+        virtual const TargetGenerator& getDestinations() = 0;
+        /**
+         * @brief Method for sending one SYN probe
+         *
+         * In batch mode probe is only queued to SendBatch, queue is sent by flushProbes or when it is full.
+         *
+         * @param fdSock - file descriptor of socket
+         * @param probe - probe to send
+         * @return 1 if probe was sent or queued, 0 if socket send buffer is full, -1 if error
+         */
+        int sendProbe(int fdSock, const ProbeKey& probe);
+        /**
+         * @brief Method for sending probes queued in batch mode
+         *
+         * @param fdSock - file descriptor of socket
+         * @return 1 if all probes were sent, 0 if socket send buffer is full and some probes stay queued, -1 if error
+         */
+        int flushProbes(int fdSock);
+        /**
+         * @brief Method for building SYN header of probe from template, sequence number carries cookie of probe
+         *
+         * @param probe - probe for which header is built
+         * @param tcpHeader - built TCP header with checksum
+         */
+        void buildProbe(const ProbeKey& probe, struct tcphdr& tcpHeader);
+        /**
+         * @brief Method for building IP header of probe for scanner family
+         *
+         * @param probe - probe for which header is built
+         * @param buffer - buffer where header is written
+         * @param payloadLen - length of TCP segment after header
+         * @return length of IP header
+         */
+        virtual size_t buildIpHeader(const ProbeKey& probe, char* buffer, size_t payloadLen) = 0;
+        /**
+         * @brief Method for building complete link layer frame of probe
+         *
+         * @param probe - probe for which frame is built
+         * @param dstMac - MAC address of next hop
+         * @param frame - buffer where frame is written
+         * @return length of frame
+         */
+        size_t buildFrame(const ProbeKey& probe, const MacAddress& dstMac, char* frame);
+        /**
+         * @brief Method for parsing received packet
+         *
+         * @param buffer - received packet
+         * @param length - length of received packet
+         * @param from - socket address of sender
+         * @param reply - parsed reply
+         * @return true if packet is TCP reply for this scanner, false otherwise
+         */
+        virtual bool parseReply(const char* buffer, ssize_t length, const struct sockaddr_storage& from, TcpReply& reply) = 0;
+        /**
+         * @brief Method for parsing packet received by ring, which starts by IP header
+         *
+         * @param packet - received packet
+         * @param length - length of received packet
+         * @param reply - parsed reply
+         * @return true if packet is TCP reply for this scanner, false otherwise
+         */
+        virtual bool parsePacket(const char* packet, size_t length, TcpReply& reply) = 0;
+        // Cookies of probes of this scan
+        ProbeCookie cookie;
+        // AF_INET or AF_INET6
+        int ipvType;
+        // Address of interface for scanner family
+        IpAddress srcAddr;
+        // SYN header with checksum prebuilt for address of interface
+        ProbeTemplate probeTemplate;
+        // Probes queued for sendmmsg and replies received by recvmmsg in batch mode
+        SendBatch sendBatch;
+        RecvBatch recvBatch;
+        // Receive ring of interface in ring mode
+        std::unique_ptr<RxRing> rxRing;
+        // Transmit ring of interface with MAC addresses of interface and next hops of destinations
+        std::unique_ptr<TxRing> txRing;
+        MacAddress localMac;
+        std::unordered_map<IpAddress, MacAddress, IpAddressHash> nextHopMacs;
+        // Shard of target x port space scanned by this scanner -> every shardCount-th probe from shardIndex
+        unsigned shardIndex = 0;
+        unsigned shardCount = 1;
+        // Queues of threaded mode -> replies from receiver thread and results for printing thread
+        std::unique_ptr<SpscQueue<TcpReply>> replies;
+        std::unique_ptr<SpscQueue<ScanResult>> results;
+        // Event descriptor by which receiver thread wakes up sender thread, -1 if not threaded
+        int wakeFd = -1;
+        // Flags for end of receiver thread and end of scan of shard
+        std::atomic<bool> receiverStop{false};
+        std::atomic<bool> finished{false};
+};
+
+/**
+ * @brief Class for pipelined scanning of TCP ports with IPv4
+ *
+ * Child class of AsyncTcpScanner for scanning TCP ports with IPv4.
+ */
+class TcpIpv4AsyncScanner : public AsyncTcpScanner {
+    public:
+        /**
+         * @brief Construct a new TcpIpv4AsyncScanner object
+         *
+         * @param params - object of ScanParams with scan parameters
+         */
+        TcpIpv4AsyncScanner(const ScannerParams& params);
+    protected:
+        const TargetGenerator& getDestinations() override;
+        size_t buildIpHeader(const ProbeKey& probe, char* buffer, size_t payloadLen) override;
+        bool parseReply(const char* buffer, ssize_t length, const struct sockaddr_storage& from, TcpReply& reply) override;
+        bool parsePacket(const char* packet, size_t length, TcpReply& reply) override;
+        std::unique_ptr<AsyncTcpScanner> createShard() override;
+};
+
+/**
+ * @brief Class for pipelined scanning of TCP ports with IPv6
+ *
+ * Child class of AsyncTcpScanner for scanning TCP ports with IPv6.
+ */
+class TcpIpv6AsyncScanner : public AsyncTcpScanner {
+    public:
+        /**
+         * @brief Construct a new TcpIpv6AsyncScanner object
+         *
+         * @param params - object of ScanParams with scan parameters
+         */
+        TcpIpv6AsyncScanner(const ScannerParams& params);
+    protected:
+        const TargetGenerator& getDestinations() override;
+        size_t buildIpHeader(const ProbeKey& probe, char* buffer, size_t payloadLen) override;
+        bool parseReply(const char* buffer, ssize_t length, const struct sockaddr_storage& from, TcpReply& reply) override;
+        bool parsePacket(const char* packet, size_t length, TcpReply& reply) override;
+        std::unique_ptr<AsyncTcpScanner> createShard() override;
+};
+
+#endif // ASYNC_SCANNER_HPP
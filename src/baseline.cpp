@@ -0,0 +1,109 @@
+/**
+ * @file baseline.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of baseline of differential scan
+ */
+
+#include "baseline.hpp"
+#include "result_store.hpp"
+#include <algorithm>
+#include <netinet/in.h>
+
+// Function for coding state of port to state of bitmap, protocol is given by slot of port
+
+static uint64_t baselineState(portState state) {
+    return (uint64_t)(state & PORT_STATE_MASK) + 1;
+}
+
+// Constructor, whole store of previous scan is read once
+
+Baseline::Baseline(const std::string& path, ScannerParams& params) : tcpSlots(65536, -1), udpSlots(65536, -1) {
+    // Slots of ports of current scan, in order of ports
+    int32_t slots = 0;
+    for (int port : params.getTcpPorts()) {
+        if (this->tcpSlots[port] == -1) this->tcpSlots[port] = slots++;
+    }
+    for (int port : params.getUdpPorts()) {
+        if (this->udpSlots[port] == -1) this->udpSlots[port] = slots++;
+    }
+    this->hostWords = ((size_t)slots + BASELINE_SLOTS_PER_WORD - 1) / BASELINE_SLOTS_PER_WORD;
+
+    ResultStoreReader reader(path);
+    reader.query(StoreQuery(), [this](const IpAddress& dst, uint16_t port, portState state, uint32_t rtt, bool changed) {
+        (void)rtt;
+        bool udp = PortState::isUdp(state);
+        int32_t slot = this->slot(port, udp);
+        if (slot == -1) return;
+        // New host gets empty bitmap
+        auto host = this->hostIndex.find(dst);
+        if (host == this->hostIndex.end()) {
+            host = this->hostIndex.emplace(dst, (uint32_t)this->hosts.size()).first;
+            this->hosts.push_back(dst);
+            this->bitmap.resize(this->bitmap.size() + this->hostWords, 0);
+        }
+        // Later result of the same port replaces earlier one
+        size_t bit = (size_t)(slot % BASELINE_SLOTS_PER_WORD) * BASELINE_STATE_BITS;
+        uint64_t& word = this->bitmap[host->second * this->hostWords + slot / BASELINE_SLOTS_PER_WORD];
+        word = (word & ~(BASELINE_STATE_MASK << bit)) | (baselineState(state) << bit);
+        if (changed) this->changedRows.push_back(ChangedRow{host->second, port, udp});
+    });
+}
+
+// Method for getting slot of port in bitmap of host
+
+int32_t Baseline::slot(uint16_t port, bool udp) const {
+    return udp ? this->udpSlots[port] : this->tcpSlots[port];
+}
+
+// Method for checking if result differs from baseline
+
+bool Baseline::changed(const IpAddress& dst, uint16_t port, portState state) const {
+    int32_t slot = this->slot(port, PortState::isUdp(state));
+    auto host = this->hostIndex.find(dst);
+    if (slot == -1 || host == this->hostIndex.end()) return true;
+    size_t bit = (size_t)(slot % BASELINE_SLOTS_PER_WORD) * BASELINE_STATE_BITS;
+    uint64_t previous = (this->bitmap[host->second * this->hostWords + slot / BASELINE_SLOTS_PER_WORD] >> bit) & BASELINE_STATE_MASK;
+    return previous != baselineState(state);
+}
+
+// Method for getting probes which differed in previous scan, hosts and ports which are not scanned now are skipped
+
+std::vector<uint64_t> Baseline::priority(const TargetGenerator& targets, const std::vector<uint16_t>& ports, int protocol) const {
+    // Index of port in ports of protocol
+    std::vector<int32_t> portIndex(65536, -1);
+    for (size_t i = 0; i < ports.size(); i++) {
+        if (portIndex[ports[i]] == -1) portIndex[ports[i]] = (int32_t)i;
+    }
+
+    std::vector<uint64_t> probes;
+    for (const ChangedRow& row : this->changedRows) {
+        uint64_t target;
+        if (row.udp != (protocol == IPPROTO_UDP) || portIndex[row.port] == -1 || !targets.indexOf(this->hosts[row.host], target)) continue;
+        probes.push_back(target * ports.size() + portIndex[row.port]);
+    }
+    // Probe is sent once, also when it differed more times
+    std::sort(probes.begin(), probes.end());
+    probes.erase(std::unique(probes.begin(), probes.end()), probes.end());
+    return probes;
+}
+
+// Method for computing fingerprint of results which differed in previous scan
+
+uint64_t Baseline::fingerprint() const {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto mix = [&hash](const void* data, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            hash ^= ((const uint8_t*)data)[i];
+            hash *= 0x100000001b3ULL;
+        }
+    };
+    for (const ChangedRow& row : this->changedRows) {
+        const IpAddress& host = this->hosts[row.host];
+        mix(&host.family, sizeof(host.family));
+        mix(host.bytes, host.length());
+        mix(&row.port, sizeof(row.port));
+        mix(&row.udp, sizeof(row.udp));
+    }
+    return hash;
+}
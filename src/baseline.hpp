@@ -0,0 +1,102 @@
+/**
+ * @file baseline.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Library for baseline of differential scan
+ */
+
+#ifndef BASELINE_HPP
+#define BASELINE_HPP // BASELINE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "scanner_params.hpp"
+#include "target_generator.hpp"
+#include "ip_address.hpp"
+#include "port_state.hpp"
+
+// Constants for bits of state of one port in bitmap of host, states of ports do not cross words
+#define BASELINE_STATE_BITS 3
+#define BASELINE_SLOTS_PER_WORD (64 / BASELINE_STATE_BITS)
+#define BASELINE_STATE_MASK ((1ULL << BASELINE_STATE_BITS) - 1)
+// Constants for state of bitmap of port without result of previous scan, known state is its state bits + 1
+#define BASELINE_UNKNOWN 0
+
+/**
+ * @class Baseline
+ * @brief Class for states of ports found by previous scan
+ *
+ * Baseline is result store of previous scan (--store). It is loaded to bitmap, every host has BASELINE_STATE_BITS bits
+ * for every TCP and UDP port of current scan, ports of previous scan which are not scanned now are dropped. Result of
+ * current scan is reported only when it differs from bitmap. Results which differed already in previous scan are
+ * flagged in store, their probes can be sent before the others.
+ */
+class Baseline{
+    public:
+        /**
+         * @brief Construct of Baseline, loads store of previous scan
+         *
+         * @param path - path of result store of previous scan
+         * @param params - scan parameters, their ports are indexed in bitmap
+         *
+         * @throws std::runtime_error if store cannot be read or is malformed
+         */
+        Baseline(const std::string& path, ScannerParams& params);
+        /**
+         * @brief Method for checking if result differs from baseline
+         *
+         * @param dst - scanned address
+         * @param port - scanned port
+         * @param state - state of port with protocol
+         * @return true if state differs or port of host was not scanned by previous scan
+         */
+        bool changed(const IpAddress& dst, uint16_t port, portState state) const;
+        /**
+         * @brief Method for getting probes which differed in previous scan
+         *
+         * @param targets - scanned addresses of one family
+         * @param ports - scanned ports of protocol
+         * @param protocol - IPPROTO_TCP or IPPROTO_UDP
+         * @return sorted indexes of probes in target x port space (target index * count of ports + port index)
+         */
+        std::vector<uint64_t> priority(const TargetGenerator& targets, const std::vector<uint16_t>& ports, int protocol) const;
+        /**
+         * @brief Method for computing fingerprint of results which differed in previous scan
+         *
+         * @return FNV-1a hash of changed results, the same probes are sent first for the same fingerprint
+         */
+        uint64_t fingerprint() const;
+
+    private:
+        /**
+         * @brief Struct for result which differed in previous scan
+         */
+        struct ChangedRow {
+            uint32_t host;
+            uint16_t port;
+            bool udp;
+        };
+        /**
+         * @brief Method for getting slot of port in bitmap of host
+         *
+         * @param port - port
+         * @param udp - true for UDP port
+         * @return slot of port, -1 if port is not scanned
+         */
+        int32_t slot(uint16_t port, bool udp) const;
+        // Slot of every TCP and UDP port, UDP slots follow TCP ones
+        std::vector<int32_t> tcpSlots;
+        std::vector<int32_t> udpSlots;
+        // Count of 64 bit words of bitmap of one host
+        size_t hostWords;
+        // Hosts of previous scan, their index and bitmap of all hosts
+        std::vector<IpAddress> hosts;
+        std::unordered_map<IpAddress, uint32_t, IpAddressHash> hostIndex;
+        std::vector<uint64_t> bitmap;
+        // Results which differed in previous scan
+        std::vector<ChangedRow> changedRows;
+};
+
+#endif // BASELINE_HPP
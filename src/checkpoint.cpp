@@ -0,0 +1,234 @@
+/**
+ * @file checkpoint.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of checkpoint of resumable scan
+ */
+
+#include "checkpoint.hpp"
+#include "system_utils.hpp"
+#include <cstdio>
+#include <cerrno>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netinet/in.h>
+
+// Function for mixing bytes to FNV-1a hash
+
+static void mixHash(uint64_t& hash, const void* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash ^= ((const uint8_t*)data)[i];
+        hash *= 0x100000001b3ULL;
+    }
+}
+
+// Constructor, checkpoint of the same scan is loaded, otherwise new one is started
+
+Checkpoint::Checkpoint(const std::string& path, ScannerParams& params, uint64_t priority) : path(path), journalPath(path + CHECKPOINT_JOURNAL_SUFFIX) {
+    // Fingerprint of what is scanned and how, step in order of probes has meaning only for the same scan
+    uint64_t mode = params.isConnectMode() ? 3 : params.isConcurrentMode() ? 2 : params.isAsyncMode() ? 1 : 0;
+    this->fingerprint = 0xcbf29ce484222325ULL;
+    mixHash(this->fingerprint, &mode, sizeof(mode));
+    mixHash(this->fingerprint, &priority, sizeof(priority));
+    uint64_t ip4 = params.getIp4AddrDest().fingerprint();
+    uint64_t ip6 = params.getIp6AddrDest().fingerprint();
+    mixHash(this->fingerprint, &ip4, sizeof(ip4));
+    mixHash(this->fingerprint, &ip6, sizeof(ip6));
+    for (const std::vector<int>* ports : {&params.getTcpPorts(), &params.getUdpPorts()}) {
+        uint64_t count = ports->size();
+        mixHash(this->fingerprint, &count, sizeof(count));
+        mixHash(this->fingerprint, ports->data(), ports->size() * sizeof(int));
+    }
+    this->seed = params.getSeed();
+
+    // Missing checkpoint is new scan
+    uint64_t committed = 0;
+    std::ifstream file(this->path);
+    if (file.is_open()) {
+        std::stringstream content;
+        content << file.rdbuf();
+        committed = this->load(content.str(), params);
+        this->resumed = true;
+    }
+
+    // Results beyond committed length were not covered by checkpoint, they are dropped
+    int flags = O_RDWR | O_CREAT | O_CLOEXEC | (this->resumed ? 0 : O_TRUNC);
+    this->journalFd = open(this->journalPath.c_str(), flags, 0644);
+    if (this->journalFd == -1) throw std::runtime_error("Could not open journal of checkpoint!");
+    off_t length = lseek(this->journalFd, 0, SEEK_END);
+    if (length == -1 || (uint64_t)length < committed || ftruncate(this->journalFd, committed) == -1 || lseek(this->journalFd, committed, SEEK_SET) == -1) {
+        close(this->journalFd);
+        throw std::runtime_error("Could not read journal of checkpoint!");
+    }
+    this->journalLength = committed;
+    this->lastSave = std::chrono::steady_clock::now();
+}
+
+// Method for getting step of progress, sweep starts after all prioritized probes
+
+uint64_t StageProgress::step(size_t prioritized, size_t nextPrioritized, uint64_t sweep) {
+    return nextPrioritized < prioritized ? nextPrioritized : prioritized + sweep;
+}
+
+// Method for restoring count of sent prioritized probes and position of sweep from step
+
+void StageProgress::restore(size_t prioritized, size_t& nextPrioritized, uint64_t& sweep) const {
+    if (this->position < prioritized) {
+        nextPrioritized = this->position;
+        return;
+    }
+    nextPrioritized = prioritized;
+    sweep = std::max(sweep, this->position - prioritized);
+}
+
+// Destructor
+
+Checkpoint::~Checkpoint() {
+    if (this->journalFd != -1) close(this->journalFd);
+}
+
+// Method for getting name of stage
+
+std::string Checkpoint::stageName(int domain, int protocol) {
+    return std::string(protocol == IPPROTO_UDP ? "udp" : "tcp") + (domain == AF_INET6 ? "6" : "4");
+}
+
+// Method for loading checkpoint, format is ->
+// IPKCHK <version>
+// fingerprint <hash>
+// seed <seed>
+// results <committed length of journal>
+// stage <name> <done|running> <step> <count of pending> <pending index>...
+
+uint64_t Checkpoint::load(const std::string& file, ScannerParams& params) {
+    std::istringstream lines(file);
+    std::string magic, key;
+    int version;
+    uint64_t fingerprint, committed;
+    if (!(lines >> magic >> version) || magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION) throw std::runtime_error("Could not read checkpoint!");
+    if (!(lines >> key >> fingerprint) || key != "fingerprint") throw std::runtime_error("Could not read checkpoint!");
+    if (fingerprint != this->fingerprint) throw std::runtime_error("Checkpoint belongs to other scan!");
+    if (!(lines >> key >> this->seed) || key != "seed") throw std::runtime_error("Could not read checkpoint!");
+    if (!(lines >> key >> committed) || key != "results" || committed % sizeof(BinaryResultRecord) != 0) throw std::runtime_error("Could not read checkpoint!");
+
+    // Progress of stages
+    std::string name, state;
+    while (lines >> key) {
+        StageProgress progress;
+        size_t count;
+        if (key != "stage" || !(lines >> name >> state >> progress.position >> count)) throw std::runtime_error("Could not read checkpoint!");
+        progress.done = state == "done";
+        progress.pending.resize(count);
+        for (uint64_t& position : progress.pending) {
+            if (!(lines >> position)) throw std::runtime_error("Could not read checkpoint!");
+        }
+        this->stages[name] = std::move(progress);
+    }
+
+    // Order of probes of resumed scan must be the same
+    params.setSeed(this->seed);
+    return committed;
+}
+
+// Getter of progress of stage
+
+StageProgress Checkpoint::progress(const std::string& stage) const {
+    auto progress = this->stages.find(stage);
+    return progress == this->stages.end() ? StageProgress() : progress->second;
+}
+
+// Method for reading committed results of journal again
+
+void Checkpoint::replay(const std::function<void(const IpAddress&, uint16_t, portState)>& callback) {
+    char buffer[sizeof(BinaryResultRecord) * 256];
+    uint64_t offset = 0;
+    while (offset < this->journalLength) {
+        size_t length = std::min<uint64_t>(sizeof(buffer), this->journalLength - offset);
+        ssize_t count = pread(this->journalFd, buffer, length, offset);
+        if (count == -1 && errno == EINTR) continue;
+        if (count <= 0 || count % sizeof(BinaryResultRecord) != 0) throw std::runtime_error("Could not read journal of checkpoint!");
+        for (ssize_t record = 0; record < count; record += sizeof(BinaryResultRecord)) {
+            IpAddress dst;
+            uint16_t port;
+            portState state;
+            if (!BinaryResultSink::parse(buffer + record, dst, port, state)) throw std::runtime_error("Could not read journal of checkpoint!");
+            callback(dst, port, state);
+        }
+        offset += count;
+    }
+}
+
+// Method for recording result, records of journal have binary format
+
+void Checkpoint::record(const IpAddress& dst, uint16_t port, portState state) {
+    char record[RESULT_RECORD_MAX];
+    size_t length = BinaryResultSink().format(dst, port, state, record);
+    this->journal.insert(this->journal.end(), record, record + length);
+}
+
+// Method for checking if checkpoint should be saved
+
+bool Checkpoint::due() const {
+    return std::chrono::steady_clock::now() - this->lastSave >= std::chrono::milliseconds(CHECKPOINT_INTERVAL);
+}
+
+// Method for updating progress of stage
+
+void Checkpoint::update(const std::string& stage, uint64_t position, const std::vector<uint64_t>& pending) {
+    StageProgress& progress = this->stages[stage];
+    progress.position = position;
+    progress.pending = pending;
+}
+
+// Method for marking stage as finished
+
+void Checkpoint::finish(const std::string& stage) {
+    StageProgress& progress = this->stages[stage];
+    progress.done = true;
+    progress.pending.clear();
+}
+
+// Method for saving, journal is synced before checkpoint which refers to it, checkpoint is replaced by rename
+
+void Checkpoint::save() {
+    // Append new results to journal
+    if (!this->journal.empty()) {
+        if (!SystemUtils::writeAll(this->journalFd, this->journal.data(), this->journal.size()) || fdatasync(this->journalFd) == -1) {
+            throw std::runtime_error("Could not write journal of checkpoint!");
+        }
+        this->journalLength += this->journal.size();
+        this->journal.clear();
+    }
+
+    // Format checkpoint
+    std::ostringstream content;
+    content << CHECKPOINT_MAGIC << " " << CHECKPOINT_VERSION << "\n";
+    content << "fingerprint " << this->fingerprint << "\n";
+    content << "seed " << this->seed << "\n";
+    content << "results " << this->journalLength << "\n";
+    for (const auto& [name, progress] : this->stages) {
+        content << "stage " << name << " " << (progress.done ? "done" : "running") << " " << progress.position << " " << progress.pending.size();
+        for (uint64_t position : progress.pending) content << " " << position;
+        content << "\n";
+    }
+    std::string text = content.str();
+
+    // Write it to temporary file, sync it and rename it, so reader never sees half of checkpoint
+    std::string tmpPath = this->path + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1) throw std::runtime_error("Could not write checkpoint!");
+    bool written = SystemUtils::writeAll(fd, text.data(), text.size()) && fsync(fd) == 0;
+    if (close(fd) == -1 || !written || std::rename(tmpPath.c_str(), this->path.c_str()) != 0) throw std::runtime_error("Could not write checkpoint!");
+    this->lastSave = std::chrono::steady_clock::now();
+}
+
+// Method for removing checkpoint and journal of finished scan
+
+void Checkpoint::remove() {
+    std::remove(this->path.c_str());
+    std::remove(this->journalPath.c_str());
+}
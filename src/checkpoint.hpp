@@ -0,0 +1,187 @@
+/**
+ * @file checkpoint.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Library for checkpoint of resumable scan
+ */
+
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP // CHECKPOINT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <functional>
+#include "scanner_params.hpp"
+#include "result_sink.hpp"
+#include "ip_address.hpp"
+
+// Constants for interval between two writes of checkpoint (ms)
+#define CHECKPOINT_INTERVAL 5000
+// Constants for magic and version of checkpoint file
+#define CHECKPOINT_MAGIC "IPKCHK"
+#define CHECKPOINT_VERSION 1
+// Constants for suffix of journal of results next to checkpoint
+#define CHECKPOINT_JOURNAL_SUFFIX ".results"
+
+/**
+ * @brief Struct for progress of one stage of scan, stage is one protocol of one address family
+ */
+struct StageProgress {
+    // Flag for finished stage
+    bool done = false;
+    // Step of next new probe, prioritized probes are steps 0 .. count - 1, position p of sweep is step count + p
+    uint64_t position = 0;
+    // Indexes of probes which were waiting for response, they are sent again
+    std::vector<uint64_t> pending;
+
+    /**
+     * @brief Method for getting step of progress
+     *
+     * @param prioritized - count of prioritized probes of stage
+     * @param nextPrioritized - count of prioritized probes which were already sent
+     * @param sweep - position of next probe of sweep
+     * @return step of next new probe
+     */
+    static uint64_t step(size_t prioritized, size_t nextPrioritized, uint64_t sweep);
+    /**
+     * @brief Method for restoring count of sent prioritized probes and position of sweep from step
+     *
+     * @param prioritized - count of prioritized probes of stage
+     * @param nextPrioritized - count of prioritized probes which were already sent
+     * @param sweep - position of sweep, it is kept when sweep did not start before interruption
+     */
+    void restore(size_t prioritized, size_t& nextPrioritized, uint64_t& sweep) const;
+};
+
+/**
+ * @class Checkpoint
+ * @brief Class for checkpoint of resumable scan
+ *
+ * Checkpoint is small text file with fingerprint of scan, seed of order of probes, committed length of journal
+ * and progress of every stage. Results are appended to binary journal next to checkpoint, so checkpoint does not grow
+ * with results. On save, new results are appended to journal and synced, then checkpoint is written to temporary file,
+ * synced and renamed over the old one, so after crash there is always whole checkpoint which refers to written results.
+ * Results of journal beyond committed length belong to probes which are pending or not sent in checkpoint, they are dropped
+ * and found again after resume.
+ */
+class Checkpoint{
+    public:
+        /**
+         * @brief Construct of Checkpoint
+         *
+         * Existing checkpoint is loaded and seed of its scan is set to params, otherwise new checkpoint is started.
+         *
+         * @param path - path of checkpoint
+         * @param params - scan parameters, seed is restored to them
+         * @param priority - fingerprint of probes sent before the others (--changed-first), 0 without them
+         *
+         * @throws std::runtime_error if checkpoint belongs to other scan or cannot be read or journal cannot be opened
+         */
+        Checkpoint(const std::string& path, ScannerParams& params, uint64_t priority);
+        /**
+         * @brief Destructor, closes journal
+         */
+        ~Checkpoint();
+        Checkpoint(const Checkpoint&) = delete;
+        Checkpoint& operator=(const Checkpoint&) = delete;
+        /**
+         * @brief Method for getting name of stage
+         *
+         * @param domain - AF_INET or AF_INET6
+         * @param protocol - IPPROTO_TCP or IPPROTO_UDP
+         * @return name of stage, e.g. "tcp4"
+         */
+        static std::string stageName(int domain, int protocol);
+        /**
+         * @brief Method for checking if scan continues from loaded checkpoint
+         *
+         * @return true if checkpoint was loaded
+         */
+        bool isResumed() const { return this->resumed; }
+        /**
+         * @brief Getter of progress of stage
+         *
+         * @param stage - name of stage
+         * @return saved progress, empty progress if stage was not started
+         */
+        StageProgress progress(const std::string& stage) const;
+        /**
+         * @brief Method for reading committed results of journal again
+         *
+         * @param callback - called for every committed result with address, port and state with protocol
+         *
+         * @throws std::runtime_error if journal cannot be read or is malformed
+         */
+        void replay(const std::function<void(const IpAddress&, uint16_t, portState)>& callback);
+        /**
+         * @brief Method for recording result, it is written to journal by next save
+         *
+         * @param dst - scanned address
+         * @param port - scanned port
+         * @param state - state of port with protocol
+         */
+        void record(const IpAddress& dst, uint16_t port, portState state);
+        /**
+         * @brief Method for checking if checkpoint should be saved
+         *
+         * @return true if CHECKPOINT_INTERVAL passed from last save
+         */
+        bool due() const;
+        /**
+         * @brief Method for updating progress of stage, it is written by next save
+         *
+         * @param stage - name of stage
+         * @param position - position of next new probe
+         * @param pending - positions of probes waiting for response
+         */
+        void update(const std::string& stage, uint64_t position, const std::vector<uint64_t>& pending);
+        /**
+         * @brief Method for marking stage as finished, it is written by next save
+         *
+         * @param stage - name of stage
+         */
+        void finish(const std::string& stage);
+        /**
+         * @brief Method for saving recorded results and progress of stages
+         *
+         * @throws std::runtime_error if journal or checkpoint cannot be written
+         */
+        void save();
+        /**
+         * @brief Method for removing checkpoint and journal of finished scan
+         */
+        void remove();
+
+    private:
+        /**
+         * @brief Method for loading checkpoint
+         *
+         * @param file - content of checkpoint
+         * @param params - scan parameters, seed is restored to them
+         * @return committed length of journal
+         *
+         * @throws std::runtime_error if checkpoint belongs to other scan or is malformed
+         */
+        uint64_t load(const std::string& file, ScannerParams& params);
+        // Paths of checkpoint and journal
+        std::string path;
+        std::string journalPath;
+        // Fingerprint of targets, ports and mode of scan and seed of order of probes
+        uint64_t fingerprint;
+        uint64_t seed;
+        // Progress of stages, ordered by name, so checkpoint is written always the same way
+        std::map<std::string, StageProgress> stages;
+        // Descriptor of journal, its committed length and results not yet written to it
+        int journalFd = -1;
+        uint64_t journalLength = 0;
+        std::vector<char> journal;
+        // Time of last save
+        std::chrono::steady_clock::time_point lastSave;
+        // Flag for loaded checkpoint
+        bool resumed = false;
+};
+
+#endif // CHECKPOINT_HPP
@@ -0,0 +1,172 @@
+/**
+ * @file checksum.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of Internet checksum with implementation selected by CPU
+ */
+
+#include "checksum.hpp"
+#include <cstring>
+#include <algorithm>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Constants for max count of vectors summed into 32 bit lanes, each vector adds at most 2 x 0xFFFF to lane
+#define SIMD_FLUSH_BLOCKS 32768
+// Constants for min length of data summed by vectors, headers are shorter and 64 bit words are faster for them
+#define SIMD_MIN_LENGTH 64
+
+// Function for adding two sums with end around carry
+
+static inline uint64_t addCarry(uint64_t sum, uint64_t value) {
+    sum += value;
+    return sum + (sum < value);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Function for summing by SSE2, 8 words are widened to 32 bit lanes and lanes are widened to 64 bit accumulator
+
+__attribute__((target("sse2"))) static uint64_t sumSse2Impl(const void* data, size_t length) {
+    const char* bytes = (const char*)data;
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    while (length >= 16) {
+        size_t blocks = std::min<size_t>(length / 16, SIMD_FLUSH_BLOCKS);
+        __m128i lanes = zero;
+        for (size_t block = 0; block < blocks; block++) {
+            __m128i words = _mm_loadu_si128((const __m128i*)bytes);
+            lanes = _mm_add_epi32(lanes, _mm_add_epi32(_mm_unpacklo_epi16(words, zero), _mm_unpackhi_epi16(words, zero)));
+            bytes += 16;
+        }
+        length -= blocks * 16;
+        acc = _mm_add_epi64(acc, _mm_add_epi64(_mm_unpacklo_epi32(lanes, zero), _mm_unpackhi_epi32(lanes, zero)));
+    }
+    uint64_t parts[2];
+    _mm_storeu_si128((__m128i*)parts, acc);
+    // Tail shorter than vector is summed by 64 bit words
+    return addCarry(addCarry(parts[0], parts[1]), Checksum::sumScalar(bytes, length));
+}
+
+// Function for summing by AVX2, the same as SSE2 with 16 words at once
+
+__attribute__((target("avx2"))) static uint64_t sumAvx2Impl(const void* data, size_t length) {
+    const char* bytes = (const char*)data;
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    while (length >= 32) {
+        size_t blocks = std::min<size_t>(length / 32, SIMD_FLUSH_BLOCKS);
+        __m256i lanes = zero;
+        for (size_t block = 0; block < blocks; block++) {
+            __m256i words = _mm256_loadu_si256((const __m256i*)bytes);
+            lanes = _mm256_add_epi32(lanes, _mm256_add_epi32(_mm256_unpacklo_epi16(words, zero), _mm256_unpackhi_epi16(words, zero)));
+            bytes += 32;
+        }
+        length -= blocks * 32;
+        acc = _mm256_add_epi64(acc, _mm256_add_epi64(_mm256_unpacklo_epi32(lanes, zero), _mm256_unpackhi_epi32(lanes, zero)));
+    }
+    uint64_t parts[4];
+    _mm256_storeu_si256((__m256i*)parts, acc);
+    uint64_t sum = addCarry(addCarry(parts[0], parts[1]), addCarry(parts[2], parts[3]));
+    // Tail shorter than vector is summed by 64 bit words, legacy SSE2 code after AVX2 would stall on state transition
+    return addCarry(sum, Checksum::sumScalar(bytes, length));
+}
+
+// Functions for detection of features of CPU
+
+static bool cpuHasSse2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+}
+
+static bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+const ChecksumSumFunction Checksum::sumSse2 = cpuHasSse2() ? sumSse2Impl : nullptr;
+const ChecksumSumFunction Checksum::sumAvx2 = cpuHasAvx2() ? sumAvx2Impl : nullptr;
+
+#else
+
+const ChecksumSumFunction Checksum::sumSse2 = nullptr;
+const ChecksumSumFunction Checksum::sumAvx2 = nullptr;
+
+#endif
+
+// Reference implementation
+
+uint64_t Checksum::sumReference(const void* data, size_t length) {
+    const char* bytes = (const char*)data;
+    uint64_t sum = 0;
+    size_t offset = 0;
+    for (; offset + 1 < length; offset += 2) {
+        uint16_t word;
+        memcpy(&word, bytes + offset, 2);
+        sum += word;
+    }
+    // Odd last byte is first byte of word padded by zero
+    if (offset < length) {
+        uint16_t word = 0;
+        memcpy(&word, bytes + offset, 1);
+        sum += word;
+    }
+    return sum;
+}
+
+// Scalar implementation, 64 bit word is sum of its four 16 bit words when carry is added back
+
+uint64_t Checksum::sumScalar(const void* data, size_t length) {
+    const char* bytes = (const char*)data;
+    uint64_t sum = 0;
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, bytes, 8);
+        sum = addCarry(sum, word);
+        bytes += 8;
+        length -= 8;
+    }
+    return addCarry(sum, sumReference(bytes, length));
+}
+
+// Method for selecting implementation by features of CPU
+
+ChecksumSumFunction Checksum::select() {
+    if (sumAvx2) return sumAvx2;
+    if (sumSse2) return sumSse2;
+    return sumScalar;
+}
+
+// Method for getting name of selected implementation
+
+const char* Checksum::implementation() {
+    ChecksumSumFunction function = select();
+    if (function == sumAvx2) return "avx2";
+    if (function == sumSse2) return "sse2";
+    return "scalar";
+}
+
+// Method for summing data by selected implementation
+
+uint64_t Checksum::sum(const void* data, size_t length) {
+    static const ChecksumSumFunction function = select();
+    if (length < SIMD_MIN_LENGTH) return sumScalar(data, length);
+    return function(data, length);
+}
+
+// Method for folding sum to checksum
+
+uint16_t Checksum::fold(uint64_t sum) {
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+// Method for calculating checksum of data
+
+uint16_t Checksum::compute(const void* data, size_t length) {
+    return fold(sum(data, length));
+}
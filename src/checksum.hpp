@@ -0,0 +1,89 @@
+/**
+ * @file checksum.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for Internet checksum with implementation selected by CPU
+ */
+
+#ifndef CHECKSUM_HPP
+#define CHECKSUM_HPP // CHECKSUM_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Type of function which sums 16 bit words of data
+ *
+ * Words are read in byte order of memory, odd last byte is padded by zero byte, carries are kept in 64 bit result.
+ */
+typedef uint64_t (*ChecksumSumFunction)(const void* data, size_t length);
+
+/**
+ * @class Checksum
+ * @brief Class for Internet checksum (RFC 1071)
+ *
+ * One's complement sum does not depend on byte order and on order of words, so words can be summed in wide registers
+ * and folded to 16 bits at the end. Implementation is selected once by features of CPU: AVX2 and SSE2 sum 16 or 8 words
+ * at once, scalar one sums 64 bit words with end around carry, reference one sums 16 bit words one by one.
+ * Short data as headers of probes are always summed by scalar implementation, vectors pay off only for longer data.
+ * Data can be unaligned and of any length, including zero.
+ */
+class Checksum{
+    public:
+        /**
+         * @brief Method for calculating checksum of data
+         *
+         * @param data - pointer to data
+         * @param length - length of data in bytes
+         * @return checksum in byte order of memory, ready to be stored into header
+         */
+        static uint16_t compute(const void* data, size_t length);
+        /**
+         * @brief Method for summing data, sums of parts starting at even offset can be added together
+         *
+         * @param data - pointer to data
+         * @param length - length of data in bytes
+         * @return sum of 16 bit words with carries
+         */
+        static uint64_t sum(const void* data, size_t length);
+        /**
+         * @brief Method for folding sum to checksum
+         *
+         * @param sum - sum of 16 bit words
+         * @return one's complement of sum folded to 16 bits
+         */
+        static uint16_t fold(uint64_t sum);
+        /**
+         * @brief Method for getting name of selected implementation
+         *
+         * @return "avx2", "sse2" or "scalar"
+         */
+        static const char* implementation();
+
+        /**
+         * @brief Reference implementation, sums 16 bit words one by one
+         */
+        static uint64_t sumReference(const void* data, size_t length);
+        /**
+         * @brief Scalar implementation, sums 64 bit words with end around carry
+         */
+        static uint64_t sumScalar(const void* data, size_t length);
+        /**
+         * @brief SSE2 implementation, null if CPU does not support it
+         */
+        static const ChecksumSumFunction sumSse2;
+        /**
+         * @brief AVX2 implementation, null if CPU does not support it
+         */
+        static const ChecksumSumFunction sumAvx2;
+
+    private:
+        /**
+         * @brief Method for selecting implementation by features of CPU
+         *
+         * @return the fastest supported implementation
+         */
+        static ChecksumSumFunction select();
+};
+
+#endif // CHECKSUM_HPP
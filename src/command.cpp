@@ -11,13 +11,15 @@
 #include <ifaddrs.h>
 #include <net/if.h>
 #include <unordered_set>
+#include <unistd.h>
+#include "result_sink.hpp"
 
 // Performs the help command
 
 void HelpCommand::performExecute() {
     // Help message
     std::string helpMessage =
-        "Usage: ./ipk-l4-scan [OPTIONS] [hostname | ip-address]\n"
+        "Usage: ./ipk-l4-scan [OPTIONS] [hostname | ip-address | cidr-block | address-range]\n"
         "\n"
         "This program scans TCP/UDP ports (IPv4/IPv6) and reports their states.\n"
         "\n"
@@ -27,6 +29,27 @@ void HelpCommand::performExecute() {
         "  -t, --pt <port-range>     Scan TCP ports.\n"
         "  -u, --pu <port-range>     Scan UDP ports.\n"
         "  -w, --wait <ms>           Set timeout in milliseconds.\n"
+        "  -iL <file>                Read targets from file, - for standard input.\n"
+        "      --concurrent          Scan TCP and UDP ports of IPv4 and IPv6 targets at once in one event loop.\n"
+        "      --dns-cache <file>    Cache of resolved domain names, names are not resolved again until their TTL expires.\n"
+        "      --format <format>     Format of results: text (default), ndjson, csv or binary.\n"
+        "      --resume <file>       Checkpoint of scan, interrupted scan continues from it (not with --stateless/--threads).\n"
+        "      --store <file>        Write results also to columnar store, it is read by subcommand query.\n"
+        "      --baseline <file>     Store of previous scan (--store), only ports with changed state are printed (not with --stateless).\n"
+        "      --changed-first       Probe ports which changed in baseline first (needs --baseline, not with --stateless/--threads).\n"
+        "      --connect             Scan TCP ports by non-blocking connect without raw sockets, runs without root (not with -u/-a/--concurrent).\n"
+        "      --connect-window <count>  Max count of connections of connect scan opened at once (default 4096, max 65536).\n"
+        "  -a, --async               Scan TCP ports by pipelined asynchronous scanner.\n"
+        "      --stateless           Asynchronous scan without table of probes, replies are matched by cookies.\n"
+        "                            Only responding (open/closed) ports are reported.\n"
+        "      --batch               Asynchronous scan sends and receives packets in batches (sendmmsg/recvmmsg).\n"
+        "      --rx-ring             Asynchronous scan receives replies by memory mapped ring of interface (TPACKET_V3).\n"
+        "      --tx-ring             Asynchronous scan sends complete frames by memory mapped ring of interface.\n"
+        "      --qdisc-bypass        Transmit ring hands frames directly to driver, bypassing queueing discipline.\n"
+        "      --rate <pps>          Max count of sent packets per second (default without limit).\n"
+        "      --burst <count>       Max count of packets sent at once when rate is limited (default 1).\n"
+        "      --seed <number>       Seed of pseudo-random order of asynchronous, concurrent and connect probes (default random).\n"
+        "      --threads <count>     Asynchronous scan shares ports among sender threads with own receiver threads (max 64).\n"
         "\n"
         "BEHAVIOR:\n"
         "  - If no scanning options are passed, a list of active interfaces will be printed.\n"
@@ -36,7 +59,16 @@ void HelpCommand::performExecute() {
         "      - a single port (e.g. 80)\n"
         "      - a range (e.g. 80-100)\n"
         "      - a comma-separated list (e.g. 80,443)\n"
-        "    Note: These formats cannot be combined.\n";
+        "    Note: These formats cannot be combined.\n"
+        "  - Targets can be specified as:\n"
+        "      - a hostname or an address (e.g. 192.0.2.1, 2001:db8::1)\n"
+        "      - a CIDR block (e.g. 192.0.2.0/24, 2001:db8::/112, IPv6 prefix at least /96)\n"
+        "      - an address range (e.g. 192.0.2.1-192.0.2.20, 192.0.2.1-20, 2001:db8::1-2001:db8::ff)\n"
+        "    Targets of -iL list are separated by white space, # starts comment until end of line.\n"
+        "\n"
+        "Usage: ./ipk-l4-scan query <store> [--host <address>] [--port <port>] [--proto tcp|udp] [--state open|closed|filtered|\"open|filtered\"] [--changed] [--format <format>]\n"
+        "\n"
+        "Prints results of columnar store which match all given filters, e.g. all hosts with open port 443 -> query scan.ipkc --port 443 --state open.\n";
 
     // Print help message
     std::cout << helpMessage << std::endl;
@@ -69,3 +101,17 @@ void InterfaceCommand::performExecute(){
     // Free allocated memory
     freeifaddrs(listInterfaces);
 }
+
+// Preforms the query command
+
+void QueryCommand::performExecute(){
+    // Store is mapped, matching results are formatted by the same sinks as results of scan
+    ResultStoreReader reader(this->query.path);
+    ResultWriter writer(ResultSink::create(this->query.format), STDOUT_FILENO);
+    reader.query(this->query, [&writer](const IpAddress& dst, uint16_t port, portState state, uint32_t rtt, bool changed) {
+        (void)rtt;
+        (void)changed;
+        writer.write(dst, port, state);
+    });
+    writer.close();
+}
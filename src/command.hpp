@@ -9,6 +9,8 @@
 #ifndef COMMAND_HPP 
 #define COMMAND_HPP // COMMAND_HPP
 
+#include "result_store.hpp"
+
 /**
  * @class Command
  * @brief Abstract class for the Command pattern
@@ -57,6 +59,32 @@ class InterfaceCommand: public Command{
          */
         void performExecute() override; // Preforms the interface command
 };
+/**
+ * @class QueryCommand
+ * @brief Class for the query command
+ * 
+ * This class is derived from the Command class. It overrides the performExecute method and prints results of store matching query.
+ */
+class QueryCommand: public Command{
+    public:
+        /**
+         * @brief Construct of QueryCommand
+         * 
+         * @param query - path of store and filter of results
+         */
+        QueryCommand(const StoreQuery& query) : query(query) {}
+        /**
+         * @brief Preforms the query command
+         * 
+         * This method maps result store and prints matching results in requested format.
+         * 
+         * @throws std::runtime_error if store cannot be read or results cannot be written
+         */
+        void performExecute() override;
+    private:
+        // Path of store and filter of results
+        StoreQuery query;
+};
 
 
 #endif // COMMAND_HPP
\ No newline at end of file
@@ -0,0 +1,441 @@
+/**
+ * @file concurrent_scanner.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of concurrent scanner of TCP and UDP ports of IPv4 and IPv6 targets in one event loop
+ */
+
+#include "concurrent_scanner.hpp"
+#include "system_utils.hpp"
+#include "socket_filter.hpp"
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Constants for receive buffer size of sockets of lanes, replies of whole window must fit in
+#define LANE_RECV_BUFFER (4 * 1024 * 1024)
+
+// Constructor of lane, functions of policies are set by createLane
+
+ScanLane::ScanLane(const TargetGenerator& targets, const std::vector<uint16_t>& ports, uint64_t seed) : targets(targets), ports(ports), total(targets.size() * ports.size()), order(total, seed), table(LANE_MAX_IN_FLIGHT), wheel(LANE_MAX_IN_FLIGHT) {}
+
+// Method for moving position of sweep past prioritized probes, they were sent already
+
+void ScanLane::skipPrioritized() {
+    if (this->prioritized.empty()) return;
+    while (this->position < this->total && std::binary_search(this->prioritized.begin(), this->prioritized.end(), this->order.at(this->position))) this->position++;
+}
+
+// Method for removing identifiers of answered probes from front of queue of retransmissions, so front is always waiting probe
+
+void ScanLane::dropAnswered() {
+    while (!this->retransmit.empty() && !this->table.at(this->retransmit.front()).queued) this->retransmit.pop_front();
+}
+
+// Method for getting index of next new probe
+
+uint64_t ScanLane::nextIndex() const {
+    if (!this->resumed.empty()) return this->resumed.front();
+    if (this->nextPrioritized < this->prioritized.size()) return this->prioritized[this->nextPrioritized];
+    return this->order.at(this->position);
+}
+
+// Function for building header of probe by policy of protocol
+
+template <typename Protocol>
+static size_t buildLaneProbe(const ProbeTemplate& probeTemplate, uint16_t srcPort, uint16_t dstPort, char* buffer) {
+    typename Protocol::Header header;
+    size_t length = Protocol::build(probeTemplate, srcPort, dstPort, header);
+    memcpy(buffer, &header, length);
+    return length;
+}
+
+// Function for creating lane from policy of address family and policy of protocol
+
+template <typename Family, typename Protocol>
+static std::unique_ptr<ScanLane> createLane(const ScanPlan& plan, uint64_t seed) {
+    std::unique_ptr<ScanLane> lane = std::make_unique<ScanLane>(Family::targets(plan), Protocol::ports(plan), seed);
+    lane->stage = Checkpoint::stageName(Family::domain, Protocol::protocol);
+    lane->domain = Family::domain;
+    lane->protocol = Protocol::protocol;
+    lane->recvProtocol = Protocol::repliesByIcmp ? Family::icmpProtocol : Protocol::protocol;
+    lane->attempts = Protocol::attempts;
+    lane->silentState = Protocol::silentState;
+    lane->refusedState = Protocol::refusedState;
+    lane->build = buildLaneProbe<Protocol>;
+    lane->parse = Protocol::template parse<Family>;
+    if constexpr (Protocol::repliesByDatagram) lane->parseDatagram = Protocol::template parseDatagram<Family>;
+    lane->local = plan.getSourceAddress(Family::domain);
+    lane->probeTemplate = ProbeTemplate(lane->local);
+    // Memory of estimators is bounded, so destinations of large ranges share them by index modulo count of estimators
+    size_t estimatorCount = (size_t)std::min<uint64_t>(lane->targets.size(), LANE_RTT_ESTIMATOR_SLOTS);
+    lane->estimators.assign(estimatorCount, RttEstimator(plan.getTimeout()));
+    // Probes answered by ICMP errors are paced by rate limit of errors of their destination
+    if (Protocol::repliesByIcmp) lane->pacers.assign(estimatorCount, UdpPacer());
+    return lane;
+}
+
+// Constructor of concurrent scanner
+
+ConcurrentScanner::ConcurrentScanner(const ScannerParams& params): Scanner(params) {
+    this->expired.reserve(LANE_MAX_IN_FLIGHT);
+}
+
+// Method for creating lanes, in the same order as scanners of main
+
+void ConcurrentScanner::createLanes() {
+    bool tcp = !this->plan.getTcpPorts().empty();
+    bool udp = !this->plan.getUdpPorts().empty();
+    bool ipv4 = !this->plan.getIp4Targets().empty();
+    bool ipv6 = !this->plan.getIp6Targets().empty();
+    uint64_t seed = this->scanParams.getSeed();
+    if (tcp && ipv4) this->lanes.push_back(createLane<Ipv4Family, TcpProtocol>(this->plan, seed));
+    if (tcp && ipv6) this->lanes.push_back(createLane<Ipv6Family, TcpProtocol>(this->plan, seed));
+    if (udp && ipv4) this->lanes.push_back(createLane<Ipv4Family, UdpProtocol>(this->plan, seed));
+    if (udp && ipv6) this->lanes.push_back(createLane<Ipv6Family, UdpProtocol>(this->plan, seed));
+    // Probes which differed in baseline are sent first
+    if (this->baseline && this->scanParams.isChangedFirst()) {
+        for (std::unique_ptr<ScanLane>& lane : this->lanes) lane->prioritized = this->baseline->priority(lane->targets, lane->ports, lane->protocol);
+    }
+    // Lanes of resumed scan continue from saved step, source port is derived from it as in sequential scanner
+    if (this->checkpoint) {
+        for (std::unique_ptr<ScanLane>& lane : this->lanes) {
+            StageProgress progress = this->checkpoint->progress(lane->stage);
+            if (progress.done) {
+                lane->nextPrioritized = lane->prioritized.size();
+                lane->position = lane->total;
+            } else {
+                progress.restore(lane->prioritized.size(), lane->nextPrioritized, lane->position);
+                lane->position = std::min(lane->position, lane->total);
+            }
+            lane->srcPort = DEFAULT_SOURCE_PORT + (uint16_t)(progress.position % (MAX_SOURCE_PORT - DEFAULT_SOURCE_PORT + 1));
+            lane->resumed.assign(progress.pending.begin(), progress.pending.end());
+        }
+    }
+    for (std::unique_ptr<ScanLane>& lane : this->lanes) lane->skipPrioritized();
+    this->lanes.erase(std::remove_if(this->lanes.begin(), this->lanes.end(), [](const std::unique_ptr<ScanLane>& lane) { return lane->done(); }), this->lanes.end());
+}
+
+// Method for creating sockets of lanes, receiving sockets of all lanes are in one epoll instance
+
+void ConcurrentScanner::openLanes(int epollFd) {
+    for (size_t i = 0; i < this->lanes.size(); i++) {
+        ScanLane& lane = *this->lanes[i];
+        // Create and bind socket to interface, it is non-blocking, so sending never stops other lanes
+        lane.sendSock = this->createSocket(lane.domain, lane.protocol);
+        if (lane.sendSock == -1) throw std::runtime_error("Could not create or bind socket!");
+        if (!SystemUtils::setNonBlocking(lane.sendSock)) throw std::runtime_error("Could not set socket non-blocking!");
+
+        // Replies of TCP are received by the same socket, ICMP errors caused by UDP by ICMP socket
+        if (lane.recvProtocol == lane.protocol) {
+            lane.recvSock = lane.sendSock;
+        } else {
+            lane.recvSock = this->createSocket(lane.domain, lane.recvProtocol);
+            if (lane.recvSock == -1) throw std::runtime_error("Could not create or bind ICMP socket!");
+            if (!SystemUtils::setNonBlocking(lane.recvSock)) throw std::runtime_error("Could not set socket non-blocking!");
+        }
+        // Replies of whole window can arrive before they are read, default receive buffer is too small for them
+        int recvBuffer = LANE_RECV_BUFFER;
+        if (setsockopt(lane.recvSock, SOL_SOCKET, SO_RCVBUFFORCE, &recvBuffer, sizeof(recvBuffer)) == -1) {
+            setsockopt(lane.recvSock, SOL_SOCKET, SO_RCVBUF, &recvBuffer, sizeof(recvBuffer));
+        }
+
+        // Add receiving socket to epoll, event carries index of its lane
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.u64 = i;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, lane.recvSock, &ev) == -1) throw std::runtime_error("Could not add socket to epoll!");
+        // Sending socket of UDP receives replies of services, its event is flagged
+        if (lane.parseDatagram != nullptr) {
+            ev.data.u64 = i | LANE_DATAGRAM_EVENT;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, lane.sendSock, &ev) == -1) throw std::runtime_error("Could not add socket to epoll!");
+        }
+    }
+}
+
+// Method for closing sockets of lanes
+
+void ConcurrentScanner::closeLanes() {
+    for (std::unique_ptr<ScanLane>& lane : this->lanes) {
+        if (lane->recvSock != -1 && lane->recvSock != lane->sendSock) this->closeSocket(lane->recvSock);
+        if (lane->sendSock != -1) this->closeSocket(lane->sendSock);
+        lane->sendSock = -1;
+        lane->recvSock = -1;
+    }
+}
+
+// Method for scanning ports of all lanes
+
+void ConcurrentScanner::scan() {
+    this->createLanes();
+    if (this->lanes.empty()) return;
+
+    // Create epoll instance for all lanes
+    int epollFd = this->createEpoll();
+    if (epollFd == -1) throw std::runtime_error("Could not create epoll instance!");
+
+    // Run event loop, descriptors are freed also when loop fails
+    try {
+        this->openLanes(epollFd);
+        this->runLoop(epollFd);
+    } catch (...) {
+        this->closeLanes();
+        this->closeEpoll(epollFd);
+        throw;
+    }
+
+    // Free descriptors
+    this->closeLanes();
+    this->closeEpoll(epollFd);
+    // Finished lanes are not scanned again after resume
+    if (this->checkpoint) {
+        for (std::unique_ptr<ScanLane>& lane : this->lanes) this->checkpoint->finish(lane->stage);
+        this->checkpoint->save();
+    }
+}
+
+// Event loop of all lanes
+
+void ConcurrentScanner::runLoop(int epollFd) {
+    size_t laneCount = this->lanes.size();
+    // Lane which sends first in next round, so every lane gets the same share of sent probes
+    size_t turn = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    while (std::any_of(this->lanes.begin(), this->lanes.end(), [](const std::unique_ptr<ScanLane>& lane) { return !lane->done(); })) {
+        uint64_t now = SystemUtils::elapsedMicros(startTime);
+        // Flag for full send buffer of some socket
+        bool socketBusy = false;
+        for (std::unique_ptr<ScanLane>& lane : this->lanes) lane->busy = false;
+
+        // Send probes of lanes in turns, one probe of each lane with probe to send, at most LANE_SEND_BURST per lane before receiving
+        size_t sentCount = 0;
+        bool limited = false;
+        bool progress = true;
+        // Time when first lane held by pacer of destination of its next probe can send
+        uint64_t heldUntil = UINT64_MAX;
+        while (progress && !limited && sentCount < LANE_SEND_BURST * laneCount) {
+            progress = false;
+            for (size_t i = 0; i < laneCount; i++) {
+                ScanLane& lane = *this->lanes[turn];
+                turn = (turn + 1) % laneCount;
+                if (lane.busy || !lane.hasProbe()) continue;
+                // Destination of next probe is rate limited, lane waits for it in this round
+                uint64_t paced = this->pacedUntil(lane);
+                if (paced > now) {
+                    lane.busy = true;
+                    heldUntil = std::min(heldUntil, paced);
+                    continue;
+                }
+                // Probe can leave only with token of rate limiter, which is common for all lanes
+                if (!this->rateLimiter.tryAcquire()) {
+                    limited = true;
+                    break;
+                }
+                int sent = this->sendNext(lane, now);
+                if (sent == -1) throw std::runtime_error("Could not send packet!");
+                // Send buffer of lane is full, try it again after receiving
+                if (sent == 0) {
+                    lane.busy = true;
+                    socketBusy = true;
+                }
+                progress = true;
+                sentCount++;
+            }
+        }
+        bool pending = std::any_of(this->lanes.begin(), this->lanes.end(), [](const std::unique_ptr<ScanLane>& lane) { return !lane->busy && lane->hasProbe(); });
+
+        // Wait until nearest event of wheels of all lanes, or shortly when there are still probes to send
+        uint64_t nowMs = now / 1000;
+        uint64_t nextEvent = UINT64_MAX;
+        for (std::unique_ptr<ScanLane>& lane : this->lanes) nextEvent = std::min(nextEvent, lane->wheel.nextEvent());
+        int waitTime = 0;
+        if (nextEvent != UINT64_MAX && nextEvent > nowMs) waitTime = (int)(nextEvent - nowMs);
+        // Held lane is woken up when its destination can get next probe
+        if (heldUntil != UINT64_MAX) {
+            int heldTime = (int)((heldUntil - now + 999) / 1000);
+            if (nextEvent == UINT64_MAX || heldTime < waitTime) waitTime = heldTime;
+        }
+        if (socketBusy && waitTime > LANE_BUSY_WAIT) waitTime = LANE_BUSY_WAIT;
+        // Probes to send are waiting only for next token of rate limiter
+        bool paced = !socketBusy && pending;
+        if (paced) waitTime = std::min(waitTime, (int)(this->rateLimiter.timeUntilToken() / 1000000));
+
+        // Drain receiving sockets of all ready lanes
+        struct epoll_event events[MAX_EVENTS];
+        int epollState = epoll_wait(epollFd, events, MAX_EVENTS, waitTime);
+        if (epollState == -1 && errno != EINTR) throw std::runtime_error("Epoll_wait failed!");
+        uint64_t receivedAt = SystemUtils::elapsedMicros(startTime);
+        for (int i = 0; i < epollState; i++) {
+            uint64_t data = events[i].data.u64;
+            this->receiveReplies(*this->lanes[data & ~LANE_DATAGRAM_EVENT], (data & LANE_DATAGRAM_EVENT) != 0, receivedAt);
+        }
+        // Token closer than one millisecond of epoll is waited precisely
+        if (paced && waitTime == 0) this->rateLimiter.waitForToken();
+
+        // Resolve expired probes of all lanes
+        nowMs = SystemUtils::elapsedMicros(startTime) / 1000;
+        for (std::unique_ptr<ScanLane>& lane : this->lanes) this->expireProbes(*lane, nowMs);
+        // Save progress periodically
+        if (this->checkpoint && this->checkpoint->due()) this->saveProgress();
+    }
+}
+
+// Method for saving progress of lanes, probes waiting for response and not yet resent ones are pending
+
+void ConcurrentScanner::saveProgress() {
+    for (std::unique_ptr<ScanLane>& lane : this->lanes) {
+        this->waiting.assign(lane->resumed.begin(), lane->resumed.end());
+        lane->table.indexes(this->waiting);
+        this->checkpoint->update(lane->stage, StageProgress::step(lane->prioritized.size(), lane->nextPrioritized, lane->position), this->waiting);
+    }
+    this->checkpoint->save();
+}
+
+// Method for getting time when next probe of lane can be sent
+
+uint64_t ConcurrentScanner::pacedUntil(const ScanLane& lane) const {
+    if (lane.pacers.empty()) return 0;
+    // Retransmission goes first, its destination is in record of probe
+    if (!lane.retransmit.empty()) return lane.pacers[lane.table.at(lane.retransmit.front()).target].sendTime();
+    uint64_t dstIndex = lane.nextIndex() / lane.ports.size();
+    return lane.pacers[dstIndex % lane.pacers.size()].sendTime();
+}
+
+// Method for sending next probe of lane
+
+int ConcurrentScanner::sendNext(ScanLane& lane, uint64_t now) {
+    // Retransmissions have priority before new probes
+    if (!lane.retransmit.empty()) {
+        uint32_t id = lane.retransmit.front();
+        int sent = this->sendProbe(lane, lane.table.at(id).key);
+        if (sent <= 0) return sent;
+        lane.retransmit.pop_front();
+        ProbeRecord& record = lane.table.at(id);
+        record.queued = false;
+        lane.dropAnswered();
+        record.sentAt = now;
+        if (!lane.pacers.empty()) lane.pacers[record.target].send(now);
+        lane.wheel.schedule(id, now / 1000 + lane.estimators[record.target].timeout(record.retries));
+        return 1;
+    }
+
+    // New probe has next source port of lane, so probes of the same port of destination are distinguished
+    // Probes which were waiting for response when scan was interrupted are sent before new ones
+    // Then probes which differed in baseline
+    // Sweep walks target x port space in pseudo-random order, so window is not filled by ports of one destination
+    bool priority = lane.resumed.empty() && lane.nextPrioritized < lane.prioritized.size();
+    uint64_t index = lane.nextIndex();
+    uint64_t dstIndex = index / lane.ports.size();
+    ProbeKey probe{lane.targets.at(dstIndex), lane.ports[index % lane.ports.size()], lane.srcPort};
+    int sent = this->sendProbe(lane, probe);
+    if (sent <= 0) return sent;
+    if (!lane.resumed.empty()) {
+        lane.resumed.pop_front();
+    } else if (priority) {
+        lane.nextPrioritized++;
+    } else {
+        lane.position++;
+        lane.skipPrioritized();
+    }
+    if (lane.srcPort < MAX_SOURCE_PORT) lane.srcPort++;
+    else lane.srcPort = DEFAULT_SOURCE_PORT;
+
+    // Probe refused by kernel is resolved at once
+    if (sent == 2) {
+        if (lane.refusedState != PORT_NONE) this->writeResult(probe.dst, probe.dstPort, lane.refusedState);
+        return 1;
+    }
+    uint32_t id = lane.table.insert(probe);
+    if (id != NO_PROBE) {
+        ProbeRecord& record = lane.table.at(id);
+        record.target = (uint32_t)(dstIndex % lane.estimators.size());
+        record.sentAt = now;
+        record.index = index;
+        if (!lane.pacers.empty()) lane.pacers[record.target].send(now);
+        lane.wheel.schedule(id, now / 1000 + lane.estimators[record.target].timeout(0));
+    }
+    return 1;
+}
+
+// Method for sending probe of lane
+
+int ConcurrentScanner::sendProbe(ScanLane& lane, const ProbeKey& probe) {
+    // Buffer for probe, UDP datagram with payload is longer than TCP header
+    char header[sizeof(UdpDatagram)];
+    lane.probeTemplate.setDestination(probe.dst);
+    size_t length = lane.build(lane.probeTemplate, probe.srcPort, probe.dstPort, header);
+    // Create socket destination address for sending, port of raw socket must be zero for IPv6 and is not used for IPv4
+    struct sockaddr_storage sockDstAddr;
+    socklen_t sockDstAddrLen = probe.dst.toSockaddr(sockDstAddr, 0);
+
+    if (sendto(lane.sendSock, header, length, 0, (struct sockaddr*)&sockDstAddr, sockDstAddrLen) == -1) {
+        // Broadcast address of scanned block is refused by kernel
+        if (errno == EACCES) return 2;
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) ? 0 : -1;
+    }
+    return 1;
+}
+
+// Method for receiving replies of lane
+
+void ConcurrentScanner::receiveReplies(ScanLane& lane, bool datagrams, uint64_t now) {
+    int fdSock = datagrams ? lane.sendSock : lane.recvSock;
+    LaneParseFunction parse = datagrams ? lane.parseDatagram : lane.parse;
+    while (true) {
+        // Buffer for received packet
+        char buffer[MAX_BUFFER_SIZE];
+        // Receive socket address
+        struct sockaddr_storage recvAddr;
+        socklen_t recvAddrLen = sizeof(recvAddr);
+        ssize_t received = recvfrom(fdSock, buffer, sizeof(buffer), 0, (struct sockaddr*)&recvAddr, &recvAddrLen);
+        if (received == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            throw std::runtime_error("Cannot receive packet!");
+        }
+
+        // Parse received packet by policy of lane and find probe which it answers
+        ProbeKey probe;
+        portState state = parse(buffer, received, recvAddr, lane.local, probe);
+        if (state == PORT_NONE) continue;
+        uint32_t id = lane.table.find(probe);
+        if (id == NO_PROBE) continue;
+
+        // Only reply to not retransmitted probe can be measured
+        ProbeRecord& record = lane.table.at(id);
+        if (record.retries == 0) lane.estimators[record.target].sample(now - record.sentAt);
+        // Cadence of ICMP errors gives pace of destination
+        if (!datagrams && !lane.pacers.empty()) lane.pacers[record.target].unreachable(now, record.retries > 0);
+        this->writeResult(probe.dst, probe.dstPort, state, (uint32_t)(now - record.sentAt));
+        lane.wheel.cancel(id);
+        // Expired probe can still wait for retransmission, erased record leaves stale identifier in queue
+        lane.table.erase(id);
+        lane.dropAnswered();
+    }
+}
+
+// Method for resolving expired probes of lane
+
+void ConcurrentScanner::expireProbes(ScanLane& lane, uint64_t now) {
+    lane.wheel.advance(now, this->expired);
+    for (uint32_t id : this->expired) {
+        ProbeRecord& probe = lane.table.at(id);
+        // Probe without reply of destination which answers by ICMP errors can be suppressed by their rate limit
+        if (!lane.pacers.empty()) lane.pacers[probe.target].lost(probe.sentAt);
+        // Probe without reply is sent again with next burst, until all attempts of protocol are used
+        if (probe.retries + 1 < lane.attempts) {
+            probe.retries++;
+            probe.queued = true;
+            lane.retransmit.push_back(id);
+        } else {
+            this->writeResult(probe.key.dst, probe.key.dstPort, lane.silentState);
+            lane.table.erase(id);
+        }
+    }
+}
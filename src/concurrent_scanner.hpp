@@ -0,0 +1,243 @@
+/**
+ * @file concurrent_scanner.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Library for concurrent scanner of TCP and UDP ports of IPv4 and IPv6 targets in one event loop
+ */
+
+#ifndef CONCURRENT_SCANNER_HPP
+#define CONCURRENT_SCANNER_HPP // CONCURRENT_SCANNER_HPP
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <netinet/in.h>
+#include "scanner.hpp"
+#include "ip_address.hpp"
+#include "target_generator.hpp"
+#include "probe_table.hpp"
+#include "probe_template.hpp"
+#include "timing_wheel.hpp"
+#include "rtt_estimator.hpp"
+#include "udp_pacer.hpp"
+#include "scan_permutation.hpp"
+
+// Constants for max count of probes of one lane waiting for response at once
+#define LANE_MAX_IN_FLIGHT 1024
+// Constants for max count of probes sent between two receptions
+#define LANE_SEND_BURST 64
+// Constants for max count of round trip time estimators of one lane, destinations beyond it share estimators
+#define LANE_RTT_ESTIMATOR_SLOTS 4096
+// Constants for time to wait when socket send buffer is full (ms)
+#define LANE_BUSY_WAIT 1
+// Constants for flag of epoll event of sending socket of lane, it receives replies of services to UDP probes
+#define LANE_DATAGRAM_EVENT (1ULL << 32)
+
+/**
+ * @brief Type of function which builds header of probe of lane into buffer and returns its length
+ */
+typedef size_t (*LaneBuildFunction)(const ProbeTemplate& probeTemplate, uint16_t srcPort, uint16_t dstPort, char* buffer);
+/**
+ * @brief Type of function which parses received packet of lane, the same as parse of protocol policy
+ */
+typedef portState (*LaneParseFunction)(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, ProbeKey& probe);
+
+/**
+ * @brief Struct for one protocol and address family scanned by concurrent scanner
+ *
+ * Lane is built from policies of SequentialScanner, so probes are built and replies matched by the same code.
+ * Every lane has own sockets, table of probes waiting for response, their deadlines and estimators of round trip time.
+ * Probes of target x port space are sent in pseudo-random order given by seed, as in asynchronous scanner, so window
+ * of lane is spread over targets instead of sending consecutive ports of one target.
+ */
+struct ScanLane {
+    /**
+     * @brief Construct of ScanLane
+     *
+     * @param targets - scanned addresses of lane family
+     * @param ports - scanned ports of lane protocol
+     * @param seed - seed of pseudo-random order of probes
+     */
+    ScanLane(const TargetGenerator& targets, const std::vector<uint16_t>& ports, uint64_t seed);
+
+    // Name of stage of lane in checkpoint
+    std::string stage;
+    // Socket domain, protocol of probes and protocol of receiving socket
+    int domain;
+    int protocol;
+    int recvProtocol;
+    // Count of sends of probe, results of port without reply and of refused probe
+    int attempts;
+    portState silentState;
+    portState refusedState;
+    // Functions of policies of lane, parser of replies received by sending socket is nullptr for TCP
+    LaneBuildFunction build;
+    LaneParseFunction parse;
+    LaneParseFunction parseDatagram = nullptr;
+
+    // Scanned addresses and ports
+    const TargetGenerator& targets;
+    const std::vector<uint16_t>& ports;
+    // Address of interface and headers of probes prebuilt for it
+    IpAddress local;
+    ProbeTemplate probeTemplate;
+    // Sending and receiving socket, receiving one is ICMP socket for UDP and sending one receives replies of UDP services
+    int sendSock = -1;
+    int recvSock = -1;
+
+    // Position of next new probe of sweep, count of probes and its source port
+    uint64_t position = 0;
+    uint64_t total;
+    uint16_t srcPort = DEFAULT_SOURCE_PORT;
+    // Order of sweep, position of sweep is permuted to index of probe in target x port space
+    ScanPermutation order;
+    // Indexes of probes which were waiting for response when scan was interrupted, they are sent before new probes
+    std::deque<uint64_t> resumed;
+    // Sorted indexes of probes which differed in baseline, they are sent before sweep, which skips them
+    std::vector<uint64_t> prioritized;
+    size_t nextPrioritized = 0;
+    // Probes waiting for response, their deadlines and expired probes waiting for retransmission
+    ProbeTable table;
+    TimingWheel wheel;
+    std::deque<uint32_t> retransmit;
+    std::vector<RttEstimator> estimators;
+    // Pacers of destinations of UDP lane, indexed as estimators, empty for TCP lane
+    std::vector<UdpPacer> pacers;
+    // Flag for full send buffer of socket in current round
+    bool busy = false;
+
+    /**
+     * @brief Method for checking if lane has probe to send
+     *
+     * @return true if there is retransmission or new, resumed or prioritized probe and window is not full
+     */
+    bool hasProbe() const { return !this->retransmit.empty() || ((this->position < this->total || !this->resumed.empty() || this->nextPrioritized < this->prioritized.size()) && !this->table.full()); }
+    /**
+     * @brief Method for checking if scan of lane is finished
+     *
+     * @return true if all probes were sent and resolved
+     */
+    bool done() const { return this->position >= this->total && this->resumed.empty() && this->nextPrioritized >= this->prioritized.size() && this->table.empty(); }
+    /**
+     * @brief Method for moving position of sweep past prioritized probes
+     */
+    void skipPrioritized();
+    /**
+     * @brief Method for removing identifiers of probes answered after expiration from front of queue of retransmissions
+     */
+    void dropAnswered();
+    /**
+     * @brief Method for getting index of next new probe, resumed probes go first, then prioritized ones, then sweep
+     *
+     * @return index of probe in target x port space
+     */
+    uint64_t nextIndex() const;
+};
+
+/**
+ * @brief Class for scanning TCP and UDP ports of IPv4 and IPv6 targets at once
+ *
+ * Scanners of main run one after another, so scan of dual-stack targets with TCP and UDP ports lasts as the sum of
+ * four scans. This scanner registers receiving sockets of all lanes (TCP IPv4/IPv6 and ICMP IPv4/IPv6) in one epoll
+ * instance and sends probes of lanes in turns, so total time is the time of the longest lane.
+ * Probes of every lane are pipelined as in asynchronous scanner: up to LANE_MAX_IN_FLIGHT probes wait for response,
+ * their deadlines are in TimingWheel and probes without reply are retransmitted or resolved by silent state of protocol.
+ * Rate limit is common for all lanes, UDP lanes also pace probes of every destination by its ICMP errors (UdpPacer).
+ */
+class ConcurrentScanner : public Scanner {
+    public:
+        /**
+         * @brief Construct a new ConcurrentScanner object
+         *
+         * @param params - object of ScanParams with scan parameters
+         */
+        ConcurrentScanner(const ScannerParams& params);
+        /**
+         * @brief Method for scanning ports of all lanes
+         *
+         * Method will create non-blocking sockets of all lanes bound to interface and one epoll instance and runs event loop.
+         *
+         * @throw std::runtime_error if was detected internal error of other function or system call
+         */
+        void scan() override;
+    private:
+        /**
+         * @brief Method for creating lanes of protocols and address families which have targets and ports
+         *
+         * Lanes of resumed scan continue from saved progress, finished lanes are not created.
+         */
+        void createLanes();
+        /**
+         * @brief Method for creating sockets of lanes and registering receiving sockets to epoll
+         *
+         * @param epollFd - file descriptor of epoll instance
+         *
+         * @throw std::runtime_error if socket cannot be created or registered
+         */
+        void openLanes(int epollFd);
+        /**
+         * @brief Method for closing sockets of lanes
+         */
+        void closeLanes();
+        /**
+         * @brief Event loop of all lanes
+         *
+         * @param epollFd - file descriptor of epoll instance
+         *
+         * @throw std::runtime_error if was detected internal error of system call
+         */
+        void runLoop(int epollFd);
+        /**
+         * @brief Method for getting time when next probe of lane can be sent by pacer of its destination
+         *
+         * @param lane - lane of probe
+         * @return time from start of scan (us), 0 for lane without pacers
+         */
+        uint64_t pacedUntil(const ScanLane& lane) const;
+        /**
+         * @brief Method for sending next probe of lane, retransmissions have priority before new probes
+         *
+         * @param lane - lane of probe
+         * @param now - time from start of scan (us)
+         * @return 1 if probe was sent, 0 if socket send buffer is full, -1 if error
+         */
+        int sendNext(ScanLane& lane, uint64_t now);
+        /**
+         * @brief Method for sending probe of lane
+         *
+         * @param lane - lane of probe
+         * @param probe - probe to send
+         * @return 1 if probe was sent, 2 if probe was refused by kernel, 0 if socket send buffer is full, -1 if error
+         */
+        int sendProbe(ScanLane& lane, const ProbeKey& probe);
+        /**
+         * @brief Method for receiving all packets queued in socket of lane and resolving probes they answer
+         *
+         * @param lane - lane of socket
+         * @param datagrams - true for sending socket with replies of UDP services, false for receiving socket
+         * @param now - time from start of scan (us)
+         *
+         * @throw std::runtime_error if recvfrom fails
+         */
+        void receiveReplies(ScanLane& lane, bool datagrams, uint64_t now);
+        /**
+         * @brief Method for resolving expired probes of lane -> retransmission or silent state
+         *
+         * @param lane - lane of probes
+         * @param now - time from start of scan (ms)
+         */
+        void expireProbes(ScanLane& lane, uint64_t now);
+        /**
+         * @brief Method for saving progress of all lanes to checkpoint
+         */
+        void saveProgress();
+        // Lanes of scan
+        std::vector<std::unique_ptr<ScanLane>> lanes;
+        // Buffer of expired probes
+        std::vector<uint32_t> expired;
+        // Buffer of indexes of probes waiting for response
+        std::vector<uint64_t> waiting;
+};
+
+#endif // CONCURRENT_SCANNER_HPP
@@ -0,0 +1,334 @@
+/**
+ * @file connect_scanner.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of unprivileged scanner of TCP ports by non-blocking connect
+ */
+
+#include "connect_scanner.hpp"
+#include "system_utils.hpp"
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+// Function for checking if error of socket, bind or connect means exhausted descriptors, memory or local ports
+
+static bool exhausted(int error) {
+    return error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM || error == EADDRNOTAVAIL || error == EAGAIN;
+}
+
+// Constructor
+
+template <typename Family>
+ConnectScanner<Family>::ConnectScanner(const ScannerParams& params): Scanner(params) {}
+
+// Method for getting window of connections allowed by limit of descriptors
+
+template <typename Family>
+size_t ConnectScanner<Family>::openWindow() {
+    size_t requested = this->scanParams.getConnectWindow();
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == -1) return requested;
+    rlim_t needed = (rlim_t)requested + CONNECT_RESERVED_FDS;
+    // Unprivileged process can raise soft limit up to hard limit
+    if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < needed) {
+        struct rlimit raised = limit;
+        raised.rlim_cur = (limit.rlim_max == RLIM_INFINITY || limit.rlim_max > needed) ? needed : limit.rlim_max;
+        if (setrlimit(RLIMIT_NOFILE, &raised) == 0) limit = raised;
+    }
+    if (limit.rlim_cur == RLIM_INFINITY || limit.rlim_cur >= needed) return requested;
+    // Window is cut to descriptors which remain after reserve
+    return limit.rlim_cur > CONNECT_RESERVED_FDS + 1 ? (size_t)(limit.rlim_cur - CONNECT_RESERVED_FDS) : 1;
+}
+
+// Method for moving position of sweep past prioritized probes, they were sent already
+
+template <typename Family>
+void ConnectScanner<Family>::skipPrioritized() {
+    if (this->prioritized.empty()) return;
+    while (this->position < this->total && std::binary_search(this->prioritized.begin(), this->prioritized.end(), this->order->at(this->position))) this->position++;
+}
+
+// Method for scanning ports
+
+template <typename Family>
+void ConnectScanner<Family>::scan() {
+    const TargetGenerator& targets = Family::targets(this->plan);
+    const std::vector<uint16_t>& ports = TcpProtocol::ports(this->plan);
+    this->total = targets.size() * ports.size();
+    if (this->total == 0) return;
+    this->order = std::make_unique<ScanPermutation>(this->total, this->scanParams.getSeed());
+    // Probes which differed in baseline are sent first
+    if (this->baseline && this->scanParams.isChangedFirst()) this->prioritized = this->baseline->priority(targets, ports, IPPROTO_TCP);
+    // Stage of resumed scan starts from saved step and probes which were waiting for result, finished stage is skipped
+    this->stage = Checkpoint::stageName(Family::domain, IPPROTO_TCP);
+    if (this->checkpoint) {
+        StageProgress progress = this->checkpoint->progress(this->stage);
+        if (progress.done) return;
+        progress.restore(this->prioritized.size(), this->nextPrioritized, this->position);
+        this->position = std::min(this->position, this->total);
+        this->resumed.assign(progress.pending.begin(), progress.pending.end());
+    }
+    this->skipPrioritized();
+    this->local = this->plan.getSourceAddress(Family::domain);
+
+    // Slots of window, first free slot is at back
+    this->window = this->openWindow();
+    this->slots.assign(this->window, ConnectSlot());
+    for (size_t id = this->window; id > 0; id--) this->freeSlots.push_back((uint32_t)(id - 1));
+    this->wheel = std::make_unique<TimingWheel>(this->window);
+    this->expired.reserve(this->window);
+    // Memory of estimators is bounded, so destinations of large ranges share them by index modulo count of estimators
+    this->estimators.assign((size_t)std::min<uint64_t>(targets.size(), CONNECT_RTT_ESTIMATOR_SLOTS), RttEstimator(this->plan.getTimeout()));
+
+    // Create epoll instance for connections
+    this->epollFd = this->createEpoll();
+    if (this->epollFd == -1) throw std::runtime_error("Could not create epoll instance!");
+
+    // Run event loop, descriptors are freed also when loop fails
+    try {
+        this->runLoop();
+    } catch (...) {
+        for (uint32_t id = 0; id < this->slots.size(); id++) this->closeSlot(id);
+        this->closeEpoll(this->epollFd);
+        throw;
+    }
+
+    // Free descriptors
+    this->closeEpoll(this->epollFd);
+    // Finished stage is not scanned again after resume
+    if (this->checkpoint) {
+        this->checkpoint->finish(this->stage);
+        this->checkpoint->save();
+    }
+}
+
+// Event loop of connections
+
+template <typename Family>
+void ConnectScanner<Family>::runLoop() {
+    auto startTime = std::chrono::steady_clock::now();
+
+    while (this->open > 0 || this->hasProbe()) {
+        uint64_t now = SystemUtils::elapsedMicros(startTime);
+
+        // Start retries and new connections until window is full, at most CONNECT_SEND_BURST before receiving
+        size_t started = 0;
+        bool limited = false;
+        while ((!this->retry.empty() || (this->open < this->window && this->hasProbe())) && started < CONNECT_SEND_BURST) {
+            // Connection can start only with token of rate limiter
+            if (!this->rateLimiter.tryAcquire()) {
+                limited = true;
+                break;
+            }
+            int result;
+            if (!this->retry.empty()) {
+                result = this->connectSlot(this->retry.front(), now);
+                if (result == 1) this->retry.pop_front();
+            } else {
+                result = this->startNext(now);
+            }
+            if (result == -1) throw std::runtime_error("Could not connect socket!");
+            // Descriptors or local ports are exhausted -> window shrinks to connections in progress
+            if (result == 0) {
+                if (this->open == this->retry.size()) throw std::runtime_error("Could not create socket!");
+                this->window = this->open;
+                break;
+            }
+            started++;
+        }
+        bool pending = !this->retry.empty() || (this->open < this->window && this->hasProbe());
+
+        // Wait until nearest deadline, without waiting when there are still connections to start
+        uint64_t nowMs = now / 1000;
+        uint64_t nextEvent = this->wheel->nextEvent();
+        int waitTime = 0;
+        if (nextEvent != UINT64_MAX && nextEvent > nowMs) waitTime = (int)(nextEvent - nowMs);
+        // Connections to start are waiting only for next token of rate limiter
+        if (pending) waitTime = limited ? std::min(waitTime, (int)(this->rateLimiter.timeUntilToken() / 1000000)) : 0;
+
+        // Results of connections are errors of their sockets
+        struct epoll_event events[MAX_EVENTS];
+        int epollState = epoll_wait(this->epollFd, events, MAX_EVENTS, waitTime);
+        if (epollState == -1 && errno != EINTR) throw std::runtime_error("Epoll_wait failed!");
+        uint64_t receivedAt = SystemUtils::elapsedMicros(startTime);
+        for (int i = 0; i < epollState; i++) {
+            uint32_t id = (uint32_t)events[i].data.u64;
+            int error = 0;
+            socklen_t errorLen = sizeof(error);
+            if (getsockopt(this->slots[id].fd, SOL_SOCKET, SO_ERROR, &error, &errorLen) == -1) error = errno;
+            this->resolve(id, error, receivedAt);
+        }
+        // Token closer than one millisecond of epoll is waited precisely
+        if (pending && limited && waitTime == 0) this->rateLimiter.waitForToken();
+
+        // Connection without result is started again by new socket, until MAX_RETRIES, then port is filtered
+        uint64_t expiredAt = SystemUtils::elapsedMicros(startTime);
+        this->wheel->advance(expiredAt / 1000, this->expired);
+        for (uint32_t id : this->expired) {
+            ConnectSlot& slot = this->slots[id];
+            if (slot.retries + 1 < MAX_RETRIES) {
+                this->closeSlot(id);
+                slot.retries++;
+                this->retry.push_back(id);
+            } else {
+                this->resolve(id, ETIMEDOUT, expiredAt);
+            }
+        }
+        // Save progress periodically
+        if (this->checkpoint && this->checkpoint->due()) this->saveProgress();
+    }
+}
+
+// Method for starting connection of next probe
+
+template <typename Family>
+int ConnectScanner<Family>::startNext(uint64_t now) {
+    const TargetGenerator& targets = Family::targets(this->plan);
+    const std::vector<uint16_t>& ports = TcpProtocol::ports(this->plan);
+    // Probes which were waiting for result when scan was interrupted go first, then probes which differed in baseline
+    // Sweep walks target x port space in pseudo-random order, so window is not filled by ports of one destination
+    bool priority = this->resumed.empty() && this->nextPrioritized < this->prioritized.size();
+    uint64_t index = !this->resumed.empty() ? this->resumed.front() : priority ? this->prioritized[this->nextPrioritized] : this->order->at(this->position);
+    uint64_t dstIndex = index / ports.size();
+
+    // Free slot gets probe of index
+    uint32_t id = this->freeSlots.back();
+    ConnectSlot& slot = this->slots[id];
+    slot.dst = targets.at(dstIndex);
+    slot.port = ports[index % ports.size()];
+    slot.index = index;
+    slot.target = (uint32_t)(dstIndex % this->estimators.size());
+    slot.retries = 0;
+    slot.active = true;
+    this->freeSlots.pop_back();
+    this->open++;
+
+    int result = this->connectSlot(id, now);
+    if (result != 1) {
+        slot.active = false;
+        this->freeSlots.push_back(id);
+        this->open--;
+        return result;
+    }
+    if (!this->resumed.empty()) {
+        this->resumed.pop_front();
+    } else if (priority) {
+        this->nextPrioritized++;
+    } else {
+        this->position++;
+        this->skipPrioritized();
+    }
+    return 1;
+}
+
+// Method for starting connection of slot
+
+template <typename Family>
+int ConnectScanner<Family>::connectSlot(uint32_t id, uint64_t now) {
+    ConnectSlot& slot = this->slots[id];
+    int fdSock = socket(Family::domain, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+    if (fdSock == -1) return exhausted(errno) ? 0 : -1;
+    // Unprivileged process cannot always bind socket to interface, source address of interface keeps route through it
+    setsockopt(fdSock, SOL_SOCKET, SO_BINDTODEVICE, this->plan.getInterfaceName().c_str(), this->plan.getInterfaceName().size());
+    // Local port is chosen by connect, so connections to different destinations can share it
+    int enable = 1;
+    setsockopt(fdSock, IPPROTO_IP, IP_BIND_ADDRESS_NO_PORT, &enable, sizeof(enable));
+    struct sockaddr_storage srcAddr;
+    socklen_t srcAddrLen = this->local.toSockaddr(srcAddr, 0);
+    if (bind(fdSock, (struct sockaddr*)&srcAddr, srcAddrLen) == -1) {
+        int error = errno;
+        close(fdSock);
+        return exhausted(error) ? 0 : -1;
+    }
+
+    struct sockaddr_storage dstAddr;
+    socklen_t dstAddrLen = slot.dst.toSockaddr(dstAddr, slot.port);
+    slot.sentAt = now;
+    if (connect(fdSock, (struct sockaddr*)&dstAddr, dstAddrLen) == 0) {
+        // Connection to local port can be established at once
+        slot.fd = fdSock;
+        this->resolve(id, 0, now);
+        return 1;
+    }
+    int error = errno;
+    if (error == EINPROGRESS) {
+        // Socket becomes writable when connection is established or fails
+        struct epoll_event ev;
+        ev.events = EPOLLOUT;
+        ev.data.u64 = id;
+        if (epoll_ctl(this->epollFd, EPOLL_CTL_ADD, fdSock, &ev) == -1) {
+            close(fdSock);
+            return -1;
+        }
+        slot.fd = fdSock;
+        this->wheel->schedule(id, now / 1000 + this->estimators[slot.target].timeout(slot.retries));
+        return 1;
+    }
+    if (exhausted(error)) {
+        close(fdSock);
+        return 0;
+    }
+    // Connection refused at once (local destination, unreachable network, broadcast address) has its result already
+    slot.fd = fdSock;
+    this->resolve(id, error, now);
+    return 1;
+}
+
+// Method for reporting result of connection, established connection means open port, refused one closed port
+
+template <typename Family>
+void ConnectScanner<Family>::resolve(uint32_t id, int error, uint64_t now) {
+    ConnectSlot& slot = this->slots[id];
+    bool replied = error == 0 || error == ECONNREFUSED;
+    portState state = error == 0 ? PORT_TCP_OPEN : error == ECONNREFUSED ? PORT_TCP_CLOSED : PORT_TCP_FILTERED;
+    // Only reply to not retried connection can be measured, port without reply has no round trip time
+    uint32_t rtt = replied ? (uint32_t)(now - slot.sentAt) : 0;
+    if (replied && slot.retries == 0) this->estimators[slot.target].sample(rtt);
+    this->writeResult(slot.dst, slot.port, state, rtt);
+
+    this->wheel->cancel(id);
+    this->closeSlot(id);
+    slot.active = false;
+    this->freeSlots.push_back(id);
+    this->open--;
+    // Window shrunk by exhausted descriptors or local ports grows back with every finished connection
+    if (this->window < this->slots.size()) this->window++;
+}
+
+// Method for closing socket of slot
+
+template <typename Family>
+void ConnectScanner<Family>::closeSlot(uint32_t id) {
+    ConnectSlot& slot = this->slots[id];
+    if (slot.fd == -1) return;
+    // Zero linger resets connection, so port of target and local port are freed at once
+    struct linger reset = {1, 0};
+    setsockopt(slot.fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+    close(slot.fd);
+    slot.fd = -1;
+}
+
+// Method for saving progress, probes without result are pending
+
+template <typename Family>
+void ConnectScanner<Family>::saveProgress() {
+    std::vector<uint64_t> waiting(this->resumed.begin(), this->resumed.end());
+    for (const ConnectSlot& slot : this->slots) {
+        if (slot.active) waiting.push_back(slot.index);
+    }
+    this->checkpoint->update(this->stage, StageProgress::step(this->prioritized.size(), this->nextPrioritized, this->position), waiting);
+    this->checkpoint->save();
+}
+
+// Scanners of TCP ports by connect with IPv4 and IPv6
+
+template class ConnectScanner<Ipv4Family>;
+template class ConnectScanner<Ipv6Family>;
@@ -0,0 +1,169 @@
+/**
+ * @file connect_scanner.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Library for unprivileged scanner of TCP ports by non-blocking connect
+ */
+
+#ifndef CONNECT_SCANNER_HPP
+#define CONNECT_SCANNER_HPP // CONNECT_SCANNER_HPP
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include "scanner.hpp"
+#include "ip_address.hpp"
+#include "timing_wheel.hpp"
+#include "rtt_estimator.hpp"
+#include "scan_permutation.hpp"
+
+// Constants for count of descriptors left free beside sockets of connections (output, epoll, checkpoint, store, ...)
+#define CONNECT_RESERVED_FDS 64
+// Constants for max count of connections started between two receptions
+#define CONNECT_SEND_BURST 256
+// Constants for max count of round trip time estimators, destinations beyond it share estimators
+#define CONNECT_RTT_ESTIMATOR_SLOTS 4096
+
+/**
+ * @brief Struct for connection of probe waiting for result
+ */
+struct ConnectSlot {
+    // Socket of connection, -1 for free slot
+    int fd = -1;
+    // Destination and destination port of probe
+    IpAddress dst;
+    uint16_t port = 0;
+    // Index of probe in target x port space, for checkpoint
+    uint64_t index = 0;
+    // Flag for slot of probe without result, its socket is closed while it waits for retry
+    bool active = false;
+    // Time of connect (us), index of estimator of destination and count of retries
+    uint64_t sentAt = 0;
+    uint32_t target = 0;
+    int retries = 0;
+};
+
+/**
+ * @brief Class for scanning TCP ports by connect of non-blocking sockets
+ *
+ * Raw scanners need CAP_NET_RAW, this scanner uses only ordinary TCP sockets, so it runs as unprivileged user.
+ * Up to window (--connect-window) connections are opened at once and multiplexed by epoll, result of connection is
+ * read from SO_ERROR: established connection means open port, ECONNREFUSED closed port, other errors and timeout filtered
+ * port. Connection without result is started again by new socket until MAX_RETRIES, timeout is derived from round trip
+ * time of destination. Window is limited by limit of open descriptors (RLIMIT_NOFILE), whose soft limit is raised up to
+ * hard limit, and it shrinks when descriptors or local ports run out during scan, every finished connection then grows
+ * it back by one connection up to window of limit. Probes of target x port space are started in pseudo-random order
+ * given by seed, so connections of window are spread over targets instead of filling listen backlog of one target.
+ * Established connection is closed by RST (SO_LINGER with zero timeout), so no connection stays in TIME_WAIT.
+ *
+ * @tparam Family - Ipv4Family or Ipv6Family
+ */
+template <typename Family>
+class ConnectScanner : public Scanner {
+    public:
+        /**
+         * @brief Construct a new ConnectScanner object
+         *
+         * @param params - object of ScanParams with scan parameters
+         */
+        ConnectScanner(const ScannerParams& params);
+        /**
+         * @brief Method for scanning ports
+         *
+         * Method will compute window from limit of descriptors, create epoll instance and run event loop of connections.
+         *
+         * @throw std::runtime_error if was detected internal error of system call
+         */
+        void scan() override;
+    private:
+        /**
+         * @brief Method for getting window of connections allowed by limit of descriptors
+         *
+         * Soft limit of descriptors is raised towards hard limit when it is lower than requested window.
+         *
+         * @return count of connections which can be opened at once, at least 1
+         */
+        size_t openWindow();
+        /**
+         * @brief Event loop of connections
+         *
+         * @throw std::runtime_error if was detected internal error of system call
+         */
+        void runLoop();
+        /**
+         * @brief Method for checking if there is new probe to connect
+         *
+         * @return true if there is resumed, prioritized or new probe
+         */
+        bool hasProbe() const { return !this->resumed.empty() || this->nextPrioritized < this->prioritized.size() || this->position < this->total; }
+        /**
+         * @brief Method for moving position of sweep past prioritized probes
+         */
+        void skipPrioritized();
+        /**
+         * @brief Method for starting connection of next probe, resumed probes go first, then prioritized ones, then sweep
+         *
+         * @param now - time from start of scan (us)
+         * @return 1 if connection was started or resolved at once, 0 if descriptors or local ports are exhausted, -1 if error
+         */
+        int startNext(uint64_t now);
+        /**
+         * @brief Method for starting connection of slot by new non-blocking socket
+         *
+         * @param id - slot of probe with destination
+         * @param now - time from start of scan (us)
+         * @return 1 if connection was started or resolved at once, 0 if descriptors or local ports are exhausted, -1 if error
+         */
+        int connectSlot(uint32_t id, uint64_t now);
+        /**
+         * @brief Method for reporting result of connection and freeing its slot
+         *
+         * @param id - slot of probe
+         * @param error - error of connection, 0 for established connection
+         * @param now - time from start of scan (us)
+         */
+        void resolve(uint32_t id, int error, uint64_t now);
+        /**
+         * @brief Method for closing socket of slot, established connection is reset
+         *
+         * @param id - slot of probe
+         */
+        void closeSlot(uint32_t id);
+        /**
+         * @brief Method for saving progress, probes with open connection and not yet resumed ones are pending
+         */
+        void saveProgress();
+        // Name of stage in checkpoint, epoll instance and address of interface
+        std::string stage;
+        int epollFd = -1;
+        IpAddress local;
+        // Position of next new probe of sweep and count of probes
+        uint64_t position = 0;
+        uint64_t total = 0;
+        // Order of sweep, position of sweep is permuted to index of probe in target x port space
+        std::unique_ptr<ScanPermutation> order;
+        // Indexes of probes which were waiting for result when scan was interrupted
+        std::deque<uint64_t> resumed;
+        // Sorted indexes of probes which differed in baseline, they are sent before sweep, which skips them
+        std::vector<uint64_t> prioritized;
+        size_t nextPrioritized = 0;
+        // Slots of connections, free slots, count of active slots and expired slots waiting for retry
+        std::vector<ConnectSlot> slots;
+        std::vector<uint32_t> freeSlots;
+        size_t open = 0;
+        std::deque<uint32_t> retry;
+        // Max count of open connections, it is at most count of slots
+        size_t window = 0;
+        // Deadlines of connections and estimators of round trip time of destinations
+        std::unique_ptr<TimingWheel> wheel;
+        std::vector<RttEstimator> estimators;
+        // Buffer of expired connections
+        std::vector<uint32_t> expired;
+};
+
+// Scanners of TCP ports by connect with IPv4 and IPv6
+typedef ConnectScanner<Ipv4Family> TcpIpv4ConnectScanner;
+typedef ConnectScanner<Ipv6Family> TcpIpv6ConnectScanner;
+
+#endif // CONNECT_SCANNER_HPP
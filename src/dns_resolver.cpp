@@ -0,0 +1,197 @@
+/**
+ * @file dns_resolver.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of parallel resolver of domain names with cache respecting TTL of records
+ */
+
+#include "dns_resolver.hpp"
+#include <cstring>
+#include <ctime>
+#include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <arpa/nameser.h>
+#include <resolv.h>
+
+// Function for querying records of one type, addresses are appended and TTL is lowered by TTL of every record
+
+static bool queryRecords(res_state state, const std::string& name, int type, std::vector<IpAddress>& addresses, uint32_t& ttl) {
+    // Answer can be long, so it is not on stack of thread
+    std::vector<unsigned char> answer(DNS_ANSWER_SIZE);
+    int length = res_nsearch(state, name.c_str(), ns_c_in, type, answer.data(), answer.size());
+    if (length < 0) return false;
+    ns_msg message;
+    if (ns_initparse(answer.data(), length, &message) < 0) return false;
+
+    // Answer contains records of asked type and aliases (CNAME) which lead to them
+    for (int i = 0; i < ns_msg_count(message, ns_s_an); i++) {
+        ns_rr record;
+        if (ns_parserr(&message, ns_s_an, i, &record) < 0) return false;
+        ttl = std::min<uint32_t>(ttl, ns_rr_ttl(record));
+        IpAddress address;
+        if (ns_rr_type(record) == ns_t_a && ns_rr_rdlen(record) == 4) address.family = AF_INET;
+        else if (ns_rr_type(record) == ns_t_aaaa && ns_rr_rdlen(record) == 16) address.family = AF_INET6;
+        else continue;
+        memcpy(address.bytes, ns_rr_rdata(record), address.length());
+        addresses.push_back(address);
+    }
+    return true;
+}
+
+// Constructor, fresh entries of cache are loaded
+
+DnsResolver::DnsResolver(const std::string& cachePath) : cachePath(cachePath) {
+    if (!this->cachePath.empty()) this->loadCache();
+}
+
+// Method for resolving one name
+
+DnsResult DnsResolver::resolveName(const std::string& name, bool cached, uint32_t& ttl) {
+    DnsResult result;
+    ttl = 0;
+
+    // Addresses are given by system resolver, which asks sources of names in order of nsswitch
+    struct addrinfo hints, *listOfAddrInfo;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    int retVal = getaddrinfo(name.c_str(), nullptr, &hints, &listOfAddrInfo);
+
+    // Check the return value of getaddrinfo -> NONAME <=> invalid domain name or internal error
+    if (retVal == EAI_NONAME) {
+        result.status = DNS_NO_NAME;
+        return result;
+    } else if (retVal || listOfAddrInfo == nullptr) {
+        result.status = DNS_FAILED;
+        return result;
+    }
+
+    // Iterate over the list of addresses, every address is listed once per socket type
+    std::unordered_set<IpAddress, IpAddressHash> resolved;
+    for (struct addrinfo* element = listOfAddrInfo; element != nullptr; element = element->ai_next) {
+        if (element->ai_family != AF_INET && element->ai_family != AF_INET6) continue;
+        IpAddress address = IpAddress::fromSockaddr(element->ai_addr);
+        if (resolved.insert(address).second) result.addresses.push_back(address);
+    }
+    freeaddrinfo(listOfAddrInfo);
+    result.status = result.addresses.empty() ? DNS_NO_NAME : DNS_RESOLVED;
+    if (!cached || result.status != DNS_RESOLVED) return result;
+
+    // TTL is asked from DNS for A and AAAA records by own state of resolver, so threads do not share it
+    struct __res_state state;
+    memset(&state, 0, sizeof(state));
+    if (res_ninit(&state) != 0) return result;
+    std::vector<IpAddress> addresses;
+    uint32_t recordTtl = UINT32_MAX;
+    queryRecords(&state, name, ns_t_a, addresses, recordTtl);
+    queryRecords(&state, name, ns_t_aaaa, addresses, recordTtl);
+    res_nclose(&state);
+    // Address which DNS does not know was given by other source (e.g. /etc/hosts), it has no TTL
+    std::unordered_set<IpAddress, IpAddressHash> records(addresses.begin(), addresses.end());
+    for (const IpAddress& address : result.addresses) {
+        if (!records.count(address)) return result;
+    }
+    ttl = recordTtl;
+    return result;
+}
+
+// Method for resolving names by pool of threads
+
+std::unordered_map<std::string, DnsResult> DnsResolver::resolve(const std::vector<std::string>& names) {
+    std::unordered_map<std::string, DnsResult> results;
+    int64_t now = time(nullptr);
+
+    // Names with fresh entry of cache are not resolved
+    std::vector<std::string> pending;
+    for (const std::string& name : names) {
+        if (results.count(name)) continue;
+        auto cached = this->cache.find(name);
+        if (cached != this->cache.end() && cached->second.expiry > now) {
+            results[name] = DnsResult{DNS_RESOLVED, cached->second.addresses};
+            continue;
+        }
+        results[name] = DnsResult();
+        pending.push_back(name);
+    }
+    if (pending.empty()) return results;
+
+    // Every thread takes next pending name until all names are resolved
+    std::vector<DnsResult> resolved(pending.size());
+    std::vector<uint32_t> ttls(pending.size(), 0);
+    std::atomic<size_t> next{0};
+    size_t count = std::min<size_t>(DNS_RESOLVER_THREADS, pending.size());
+    // TTL of records is asked only for cache
+    bool useCache = !this->cachePath.empty();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < count; i++) {
+        threads.emplace_back([&pending, &resolved, &ttls, &next, useCache]() {
+            for (size_t index = next.fetch_add(1); index < pending.size(); index = next.fetch_add(1)) {
+                resolved[index] = resolveName(pending[index], useCache, ttls[index]);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    // Store results, names resolved by DNS are cached until their records expire
+    for (size_t i = 0; i < pending.size(); i++) {
+        if (!this->cachePath.empty() && resolved[i].status == DNS_RESOLVED && ttls[i] > 0) {
+            this->cache[pending[i]] = DnsCacheEntry{resolved[i].addresses, now + ttls[i]};
+        }
+        results[pending[i]] = std::move(resolved[i]);
+    }
+    if (!this->cachePath.empty()) this->saveCache();
+    return results;
+}
+
+// Method for loading cache, every line is -> name expiry address...
+
+void DnsResolver::loadCache() {
+    // Missing cache is empty cache
+    std::ifstream file(this->cachePath);
+    if (!file.is_open()) return;
+    int64_t now = time(nullptr);
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string name, address;
+        DnsCacheEntry entry;
+        if (!(fields >> name >> entry.expiry) || entry.expiry <= now) continue;
+        // Malformed entry is dropped, it will be resolved again
+        bool valid = true;
+        while (fields >> address) {
+            IpAddress binary;
+            binary.family = address.find(':') == std::string::npos ? AF_INET : AF_INET6;
+            if (inet_pton(binary.family, address.c_str(), binary.bytes) != 1) valid = false;
+            entry.addresses.push_back(binary);
+        }
+        if (valid && !entry.addresses.empty()) this->cache[name] = entry;
+    }
+}
+
+// Method for storing cache, it is written to temporary file and renamed, so reader never sees half of cache
+
+void DnsResolver::saveCache() {
+    int64_t now = time(nullptr);
+    std::string tmpPath = this->cachePath + ".tmp";
+    std::ofstream file(tmpPath, std::ios::trunc);
+    if (!file.is_open()) throw std::runtime_error("Could not write DNS cache!");
+
+    file << "# name expiry address..." << std::endl;
+    for (const auto& [name, entry] : this->cache) {
+        if (entry.expiry <= now) continue;
+        file << name << " " << entry.expiry;
+        for (const IpAddress& address : entry.addresses) file << " " << address.toString();
+        file << "\n";
+    }
+    file.close();
+    if (file.fail() || std::rename(tmpPath.c_str(), this->cachePath.c_str()) != 0) throw std::runtime_error("Could not write DNS cache!");
+}
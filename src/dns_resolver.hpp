@@ -0,0 +1,109 @@
+/**
+ * @file dns_resolver.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for parallel resolver of domain names with cache respecting TTL of records
+ */
+
+#ifndef DNS_RESOLVER_HPP
+#define DNS_RESOLVER_HPP // DNS_RESOLVER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "ip_address.hpp"
+
+// Constants for max count of threads resolving names at once
+#define DNS_RESOLVER_THREADS 16
+// Constants for max size of DNS answer
+#define DNS_ANSWER_SIZE 65536
+
+/**
+ * @brief Enum for result of resolution of one name
+ */
+enum dnsStatus{
+    DNS_RESOLVED,
+    // Name does not exist or has no address
+    DNS_NO_NAME,
+    // Internal error of resolver
+    DNS_FAILED
+};
+
+/**
+ * @brief Struct for result of resolution of one name
+ */
+struct DnsResult {
+    // Status of resolution
+    dnsStatus status = DNS_FAILED;
+    // Resolved IPv4 and IPv6 addresses, every address once
+    std::vector<IpAddress> addresses;
+};
+
+/**
+ * @brief Struct for entry of cache
+ */
+struct DnsCacheEntry {
+    // Resolved addresses
+    std::vector<IpAddress> addresses;
+    // Time of expiration of entry (s since epoch)
+    int64_t expiry;
+};
+
+/**
+ * @class DnsResolver
+ * @brief Class for resolving many domain names at once
+ *
+ * Names are resolved by pool of at most DNS_RESOLVER_THREADS threads, so time of resolution of list of names is the time
+ * of the slowest name instead of sum of all names. Addresses are given by getaddrinfo, so sources of names are asked
+ * in order of nsswitch (e.g. /etc/hosts before DNS). With cache, every thread asks also for A and AAAA records by own
+ * resolver state (res_nsearch), which gives TTL of records. Name is cached only if DNS knows all its addresses, names
+ * answered by other sources (e.g. /etc/hosts) have no TTL and they are not cached.
+ * With path of cache, fresh entries of cache are used without any query and resolved names are stored with expiration
+ * given by the lowest TTL of their records, so repeated scans skip resolution until records expire.
+ */
+class DnsResolver{
+    public:
+        /**
+         * @brief Construct of DnsResolver
+         *
+         * @param cachePath - path of file with cache, empty for no cache
+         */
+        DnsResolver(const std::string& cachePath);
+        /**
+         * @brief Method for resolving names
+         *
+         * @param names - domain names, duplicates are resolved once
+         * @return results of names
+         *
+         * @throws std::runtime_error if the cache cannot be written
+         */
+        std::unordered_map<std::string, DnsResult> resolve(const std::vector<std::string>& names);
+
+    private:
+        /**
+         * @brief Method for resolving one name, it can be called by more threads at once
+         *
+         * @param name - domain name
+         * @param cached - true if TTL of records is needed for cache
+         * @param ttl - lowest TTL of records (s), 0 if result must not be cached
+         * @return result of name
+         */
+        static DnsResult resolveName(const std::string& name, bool cached, uint32_t& ttl);
+        /**
+         * @brief Method for loading fresh entries of cache
+         */
+        void loadCache();
+        /**
+         * @brief Method for storing entries of cache, expired entries are dropped
+         *
+         * @throws std::runtime_error if the cache cannot be written
+         */
+        void saveCache();
+        // Path of file with cache
+        std::string cachePath;
+        // Entries of cache by name
+        std::unordered_map<std::string, DnsCacheEntry> cache;
+};
+
+#endif // DNS_RESOLVER_HPP
@@ -0,0 +1,80 @@
+/**
+ * @file ip_address.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of methods for binary representation of IPv4/IPv6 address
+ */
+
+#include "ip_address.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+
+// Create address from string
+
+IpAddress IpAddress::fromString(sa_family_t family, const std::string& address){
+    IpAddress result;
+    result.family = family;
+    if(inet_pton(family, address.c_str(), result.bytes) != 1) throw std::runtime_error("Inet_pton failed!");
+    return result;
+}
+
+// Create address from socket address
+
+IpAddress IpAddress::fromSockaddr(const struct sockaddr* sockAddr){
+    IpAddress result;
+    result.family = sockAddr->sa_family;
+    // Ipv4
+    if (sockAddr->sa_family == AF_INET){
+        memcpy(result.bytes, &((const struct sockaddr_in*)sockAddr)->sin_addr, 4);
+    // Ipv6
+    } else if (sockAddr->sa_family == AF_INET6){
+        memcpy(result.bytes, &((const struct sockaddr_in6*)sockAddr)->sin6_addr, 16);
+    }
+    return result;
+}
+
+// Convert address to text form
+
+std::string IpAddress::toString() const{
+    char text[INET6_ADDRSTRLEN];
+    if(inet_ntop(this->family, this->bytes, text, sizeof(text)) == nullptr) throw std::runtime_error("Inet_ntop failed!");
+    return std::string(text);
+}
+
+// Fill socket address for sending
+
+socklen_t IpAddress::toSockaddr(struct sockaddr_storage& sockAddr, uint16_t port) const{
+    memset(&sockAddr, 0, sizeof(sockAddr));
+    // Ipv4
+    if (this->family == AF_INET){
+        struct sockaddr_in* ipv4 = (struct sockaddr_in*)&sockAddr;
+        ipv4->sin_family = AF_INET;
+        ipv4->sin_port = htons(port);
+        memcpy(&ipv4->sin_addr, this->bytes, 4);
+        return sizeof(struct sockaddr_in);
+    }
+    // Ipv6
+    struct sockaddr_in6* ipv6 = (struct sockaddr_in6*)&sockAddr;
+    ipv6->sin6_family = AF_INET6;
+    ipv6->sin6_port = htons(port);
+    memcpy(&ipv6->sin6_addr, this->bytes, 16);
+    return sizeof(struct sockaddr_in6);
+}
+
+// Compare two addresses
+
+bool IpAddress::operator==(const IpAddress& other) const{
+    return this->family == other.family && memcmp(this->bytes, other.bytes, sizeof(this->bytes)) == 0;
+}
+
+// Hash of address -> FNV-1a over family and bytes
+
+size_t IpAddressHash::operator()(const IpAddress& address) const{
+    uint64_t hash = 1469598103934665603ULL;
+    hash = (hash ^ address.family) * 1099511628211ULL;
+    for (size_t i = 0; i < sizeof(address.bytes); i++) {
+        hash = (hash ^ address.bytes[i]) * 1099511628211ULL;
+    }
+    return (size_t)hash;
+}
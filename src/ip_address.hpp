@@ -0,0 +1,78 @@
+/**
+ * @file ip_address.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for binary representation of IPv4/IPv6 address
+ */
+
+#ifndef IP_ADDRESS_HPP
+#define IP_ADDRESS_HPP // IP_ADDRESS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+/**
+ * @brief Struct for binary IPv4 or IPv6 address
+ *
+ * Address is stored in network byte order, IPv4 address uses only first 4 bytes, rest of bytes are zero.
+ * Struct is used as key in tables of probes, so it is compared and hashed without any string conversion.
+ */
+struct IpAddress {
+    // Address family -> AF_INET or AF_INET6
+    sa_family_t family = AF_UNSPEC;
+    // Bytes of address
+    uint8_t bytes[16] = {};
+
+    /**
+     * @brief Create address from string
+     *
+     * @param family - AF_INET or AF_INET6
+     * @param address - address in text form
+     * @return binary address
+     *
+     * @throws std::runtime_error if the address cannot be converted
+     */
+    static IpAddress fromString(sa_family_t family, const std::string& address);
+    /**
+     * @brief Create address from socket address
+     *
+     * @param sockAddr - IPv4 or IPv6 socket address
+     * @return binary address
+     */
+    static IpAddress fromSockaddr(const struct sockaddr* sockAddr);
+    /**
+     * @brief Convert address to text form
+     *
+     * @return address in text form
+     */
+    std::string toString() const;
+    /**
+     * @brief Fill socket address for sending
+     *
+     * @param sockAddr - socket address to fill
+     * @param port - destination port in host byte order
+     * @return length of filled socket address
+     */
+    socklen_t toSockaddr(struct sockaddr_storage& sockAddr, uint16_t port) const;
+    /**
+     * @brief Length of address in bytes
+     *
+     * @return 4 for IPv4, 16 for IPv6
+     */
+    size_t length() const { return this->family == AF_INET ? 4 : 16; }
+
+    bool operator==(const IpAddress& other) const;
+    bool operator!=(const IpAddress& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Hash function object for IpAddress
+ */
+struct IpAddressHash {
+    size_t operator()(const IpAddress& address) const;
+};
+
+#endif // IP_ADDRESS_HPP
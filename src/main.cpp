@@ -6,12 +6,31 @@
  */
 
 #include <iostream>
+#include <memory>
+#include <unistd.h>
 #include "parser_arguments.hpp"
 #include "command.hpp"
 #include "scanner_params.hpp"
 #include "scanner.hpp"
+#include "async_scanner.hpp"
+#include "concurrent_scanner.hpp"
+#include "connect_scanner.hpp"
+#include "result_sink.hpp"
+#include "checkpoint.hpp"
+#include "result_store.hpp"
+#include "baseline.hpp"
 #include "return_values.hpp"
 
+// Function for running scanner with common writer of results, checkpoint, store and baseline
+
+static void runScanner(Scanner& scanner, ResultWriter& writer, Checkpoint* checkpoint, ResultStore* store, const Baseline* baseline){
+   scanner.setResultWriter(&writer);
+   scanner.setCheckpoint(checkpoint);
+   scanner.setResultStore(store);
+   scanner.setBaseline(baseline);
+   scanner.scan();
+}
+
 int main(int argc, char *argv[]){
 
    try{ 
@@ -25,6 +44,13 @@ int main(int argc, char *argv[]){
          return 0;
       }
 
+      // Check if only query of result store was requested
+      if(args.isQueryOnly()){
+         QueryCommand queryCommand(args.getQuery());
+         queryCommand.performExecute();
+         return 0;
+      }
+
       // Check if only interfaces were requested
       if(args.isInterfaceOnly()){
          InterfaceCommand interfaceCommand;
@@ -34,28 +60,76 @@ int main(int argc, char *argv[]){
 
       // Get scan parameters
       ScannerParams scanParams = args.getScanParams();
-
-      // Set what to scan and scan
-      if (!scanParams.getTcpPorts().empty() && !scanParams.getIp4AddrDest().empty()){
-         TcpIpv4Scanner tcpIpv4(scanParams);
-         tcpIpv4.scan();
-      }
-      
-      if (!scanParams.getTcpPorts().empty() && !scanParams.getIp6AddrDest().empty()){
-         TcpIpv6Scanner tcpIpv6(scanParams);
-         tcpIpv6.scan();
-      }
-      
-      if (!scanParams.getUdpPorts().empty() && !scanParams.getIp4AddrDest().empty()){
-         UdpIpv4Scanner udpIpv4(scanParams);
-         udpIpv4.scan();
+      // Differential scan prints only results which differ from results of previous scan
+      std::unique_ptr<Baseline> baseline;
+      if (!scanParams.getBaselineFile().empty()) baseline = std::make_unique<Baseline>(scanParams.getBaselineFile(), scanParams);
+      // Resumable scan restores seed of interrupted scan before scanners are created,
+      // probes sent first by baseline belong to fingerprint of scan
+      std::unique_ptr<Checkpoint> checkpoint;
+      uint64_t priority = baseline && scanParams.isChangedFirst() ? baseline->fingerprint() : 0;
+      if (!scanParams.getResumeFile().empty()) checkpoint = std::make_unique<Checkpoint>(scanParams.getResumeFile(), scanParams, priority);
+      // Results of all scanners are written by one buffered writer in requested format
+      ResultWriter writer(ResultSink::create(scanParams.getOutputFormat()), STDOUT_FILENO);
+      // Results can be written also to columnar store, which is read by subcommand query,
+      // baseline is read before, so store of previous scan can be replaced by store of this scan
+      std::unique_ptr<ResultStore> store;
+      if (!scanParams.getStoreFile().empty()) store = std::make_unique<ResultStore>(scanParams.getStoreFile());
+      // Results found before interruption are written first, journal has no round trip time
+      if (checkpoint && checkpoint->isResumed()){
+         checkpoint->replay([&](const IpAddress& dst, uint16_t port, portState state){
+            bool changed = !baseline || baseline->changed(dst, port, state);
+            if (store) store->append(dst, port, state, 0, baseline && changed);
+            if (changed) writer.write(dst, port, state);
+         });
       }
 
-      if (!scanParams.getUdpPorts().empty() && !scanParams.getIp6AddrDest().empty()){
-         UdpIpv6Scanner udpIpv6(scanParams);
-         udpIpv6.scan();
+      // Scan all protocols and address families at once in one event loop
+      if (scanParams.isConcurrentMode()){
+         ConcurrentScanner concurrent(scanParams);
+         runScanner(concurrent, writer, checkpoint.get(), store.get(), baseline.get());
+      } else {
+         // Set what to scan and scan
+         if (!scanParams.getTcpPorts().empty() && !scanParams.getIp4AddrDest().empty()){
+            if (scanParams.isConnectMode()){
+               TcpIpv4ConnectScanner tcpIpv4(scanParams);
+               runScanner(tcpIpv4, writer, checkpoint.get(), store.get(), baseline.get());
+            } else if (scanParams.isAsyncMode()){
+               TcpIpv4AsyncScanner tcpIpv4(scanParams);
+               runScanner(tcpIpv4, writer, checkpoint.get(), store.get(), baseline.get());
+            } else {
+               TcpIpv4Scanner tcpIpv4(scanParams);
+               runScanner(tcpIpv4, writer, checkpoint.get(), store.get(), baseline.get());
+            }
+         }
+
+         if (!scanParams.getTcpPorts().empty() && !scanParams.getIp6AddrDest().empty()){
+            if (scanParams.isConnectMode()){
+               TcpIpv6ConnectScanner tcpIpv6(scanParams);
+               runScanner(tcpIpv6, writer, checkpoint.get(), store.get(), baseline.get());
+            } else if (scanParams.isAsyncMode()){
+               TcpIpv6AsyncScanner tcpIpv6(scanParams);
+               runScanner(tcpIpv6, writer, checkpoint.get(), store.get(), baseline.get());
+            } else {
+               TcpIpv6Scanner tcpIpv6(scanParams);
+               runScanner(tcpIpv6, writer, checkpoint.get(), store.get(), baseline.get());
+            }
+         }
+
+         if (!scanParams.getUdpPorts().empty() && !scanParams.getIp4AddrDest().empty()){
+            UdpIpv4Scanner udpIpv4(scanParams);
+            runScanner(udpIpv4, writer, checkpoint.get(), store.get(), baseline.get());
+         }
+
+         if (!scanParams.getUdpPorts().empty() && !scanParams.getIp6AddrDest().empty()){
+            UdpIpv6Scanner udpIpv6(scanParams);
+            runScanner(udpIpv6, writer, checkpoint.get(), store.get(), baseline.get());
+         }
       }
-   
+
+      // Write rest of results, checkpoint of finished scan is not needed anymore
+      writer.close();
+      if (store) store->close();
+      if (checkpoint) checkpoint->remove();
    }
    // Catch error of invlaid input
    catch (const std::invalid_argument&) {
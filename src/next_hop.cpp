@@ -0,0 +1,212 @@
+/**
+ * @file next_hop.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of resolving link layer address of next hop from kernel tables
+ */
+
+#include "next_hop.hpp"
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <unordered_set>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/neighbour.h>
+
+// Constants for size of buffer for replies of rtnetlink
+#define NETLINK_BUFFER_SIZE 65536
+
+// Constructor
+
+NextHopResolver::NextHopResolver(const std::string& interface) : interface(interface), loopback(false), sequence(0) {
+    this->ifindex = if_nametoindex(interface.c_str());
+    if (this->ifindex == 0) throw std::runtime_error("Could not find interface!");
+
+    // Get MAC address and type of interface
+    int fdSock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fdSock == -1) throw std::runtime_error("Could not create socket!");
+    struct ifreq request;
+    memset(&request, 0, sizeof(request));
+    strncpy(request.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+    if (ioctl(fdSock, SIOCGIFHWADDR, &request) == -1) {
+        close(fdSock);
+        throw std::runtime_error("Could not get MAC address of interface!");
+    }
+    close(fdSock);
+    this->loopback = request.ifr_hwaddr.sa_family == ARPHRD_LOOPBACK;
+    memcpy(this->localMac.bytes, request.ifr_hwaddr.sa_data, 6);
+}
+
+// Method for opening rtnetlink socket
+
+int NextHopResolver::openSocket() {
+    return socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+}
+
+// Method for sending request to kernel by rtnetlink socket
+
+bool NextHopResolver::sendRequest(int fdSock, const void* request, size_t requestLen) {
+    struct sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+    return sendto(fdSock, request, requestLen, 0, (struct sockaddr*)&kernel, sizeof(kernel)) != -1;
+}
+
+// Method for finding next hop of destination in routing table
+
+bool NextHopResolver::findRoute(int fdSock, const IpAddress& dst, IpAddress& nextHop) {
+    // Request for route to destination
+    struct {
+        struct nlmsghdr header;
+        struct rtmsg route;
+        char attributes[64];
+    } request;
+    memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct rtmsg));
+    request.header.nlmsg_type = RTM_GETROUTE;
+    request.header.nlmsg_flags = NLM_F_REQUEST;
+    request.header.nlmsg_seq = ++this->sequence;
+    request.route.rtm_family = dst.family;
+    request.route.rtm_dst_len = dst.length() * 8;
+    struct rtattr* attribute = (struct rtattr*)((char*)&request + NLMSG_ALIGN(request.header.nlmsg_len));
+    attribute->rta_type = RTA_DST;
+    attribute->rta_len = RTA_LENGTH(dst.length());
+    memcpy(RTA_DATA(attribute), dst.bytes, dst.length());
+    request.header.nlmsg_len = NLMSG_ALIGN(request.header.nlmsg_len) + RTA_ALIGN(attribute->rta_len);
+
+    if (!sendRequest(fdSock, &request, request.header.nlmsg_len)) return false;
+    char buffer[NETLINK_BUFFER_SIZE];
+    struct nlmsghdr* header = nullptr;
+    // Socket is shared by lookups, reply of earlier request which was not read is skipped
+    do {
+        ssize_t received = recv(fdSock, buffer, sizeof(buffer), 0);
+        if (received <= 0) return false;
+        header = (struct nlmsghdr*)buffer;
+        if (!NLMSG_OK(header, (size_t)received)) return false;
+    } while (header->nlmsg_seq != this->sequence);
+
+    // Gateway of route is next hop, route without gateway leads directly to destination
+    nextHop = dst;
+    if (header->nlmsg_type != RTM_NEWROUTE) return false;
+    struct rtmsg* route = (struct rtmsg*)NLMSG_DATA(header);
+    int length = RTM_PAYLOAD(header);
+    for (struct rtattr* attr = RTM_RTA(route); RTA_OK(attr, length); attr = RTA_NEXT(attr, length)) {
+        if (attr->rta_type == RTA_GATEWAY && RTA_PAYLOAD(attr) == dst.length()) {
+            memcpy(nextHop.bytes, RTA_DATA(attr), dst.length());
+        }
+    }
+    return true;
+}
+
+// Method for reading neighbors of interface with usable MAC address from neighbor table
+
+void NextHopResolver::readNeighbors(sa_family_t family, std::unordered_map<IpAddress, MacAddress, IpAddressHash>& neighbors) {
+    // Request for dump of neighbor table of family
+    struct {
+        struct nlmsghdr header;
+        struct ndmsg neighbor;
+    } request;
+    memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct ndmsg));
+    request.header.nlmsg_type = RTM_GETNEIGH;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.neighbor.ndm_family = family;
+
+    int fdSock = openSocket();
+    if (fdSock == -1) return;
+    if (!sendRequest(fdSock, &request, request.header.nlmsg_len)) {
+        close(fdSock);
+        return;
+    }
+    bool done = false;
+    char buffer[NETLINK_BUFFER_SIZE];
+    // Dump is received in more parts until NLMSG_DONE
+    while (!done) {
+        ssize_t received = recv(fdSock, buffer, sizeof(buffer), 0);
+        if (received <= 0) break;
+        for (struct nlmsghdr* header = (struct nlmsghdr*)buffer; NLMSG_OK(header, (size_t)received); header = NLMSG_NEXT(header, received)) {
+            if (header->nlmsg_type == NLMSG_DONE || header->nlmsg_type == NLMSG_ERROR) {
+                done = true;
+                break;
+            }
+            if (header->nlmsg_type != RTM_NEWNEIGH) continue;
+            // Only neighbor of interface with usable MAC address
+            struct ndmsg* entry = (struct ndmsg*)NLMSG_DATA(header);
+            if (entry->ndm_ifindex != this->ifindex || (entry->ndm_state & (NUD_INCOMPLETE | NUD_FAILED)) || entry->ndm_state == NUD_NONE) continue;
+            IpAddress neighbor;
+            neighbor.family = family;
+            const void* lladdr = nullptr;
+            bool hasDst = false;
+            int length = RTM_PAYLOAD(header);
+            for (struct rtattr* attr = (struct rtattr*)((char*)entry + NLMSG_ALIGN(sizeof(struct ndmsg))); RTA_OK(attr, length); attr = RTA_NEXT(attr, length)) {
+                if (attr->rta_type == NDA_DST && RTA_PAYLOAD(attr) == neighbor.length()) {
+                    memcpy(neighbor.bytes, RTA_DATA(attr), neighbor.length());
+                    hasDst = true;
+                }
+                if (attr->rta_type == NDA_LLADDR && RTA_PAYLOAD(attr) == 6) lladdr = RTA_DATA(attr);
+            }
+            if (hasDst && lladdr) memcpy(neighbors[neighbor].bytes, lladdr, 6);
+        }
+    }
+    close(fdSock);
+}
+
+// Method for resolving MAC addresses of next hops of destinations
+
+void NextHopResolver::resolve(TargetGenerator destinations, std::unordered_map<IpAddress, MacAddress, IpAddressHash>& macs) {
+    if (destinations.empty()) return;
+    sa_family_t family = destinations.at(0).family;
+    IpAddress dst;
+    // Loopback frames have zero addresses
+    if (this->loopback) {
+        while (destinations.next(dst)) macs[dst] = MacAddress();
+        return;
+    }
+
+    // Find next hop of every destination, all lookups share one socket
+    std::unordered_map<IpAddress, IpAddress, IpAddressHash> nextHops;
+    int fdRoute = openSocket();
+    if (fdRoute == -1) return;
+    while (destinations.next(dst)) {
+        IpAddress nextHop;
+        if (this->findRoute(fdRoute, dst, nextHop)) nextHops[dst] = nextHop;
+    }
+    close(fdRoute);
+
+    // Unknown neighbors are resolved by kernel after first packet sent to them, all are triggered at once
+    std::unordered_map<IpAddress, MacAddress, IpAddressHash> neighbors;
+    this->readNeighbors(family, neighbors);
+    std::unordered_set<IpAddress, IpAddressHash> unknown;
+    for (auto& [dst, nextHop] : nextHops) {
+        if (!neighbors.count(nextHop)) unknown.insert(nextHop);
+    }
+    int fdSock = unknown.empty() ? -1 : socket(family, SOCK_DGRAM, 0);
+    if (fdSock != -1) {
+        setsockopt(fdSock, SOL_SOCKET, SO_BINDTODEVICE, this->interface.c_str(), this->interface.size());
+        for (const IpAddress& nextHop : unknown) {
+            struct sockaddr_storage sockAddr;
+            socklen_t sockAddrLen = nextHop.toSockaddr(sockAddr, 9);
+            sendto(fdSock, nullptr, 0, 0, (struct sockaddr*)&sockAddr, sockAddrLen);
+        }
+        close(fdSock);
+    }
+    // Wait until all triggered neighbors are resolved or time of resolution is over
+    struct timespec interval = {0, NEIGHBOR_POLL_INTERVAL * 1000000L};
+    for (int waited = 0; !unknown.empty() && waited < NEIGHBOR_RESOLVE_TIME; waited += NEIGHBOR_POLL_INTERVAL) {
+        nanosleep(&interval, nullptr);
+        this->readNeighbors(family, neighbors);
+        std::erase_if(unknown, [&neighbors](const IpAddress& nextHop) { return neighbors.count(nextHop) > 0; });
+    }
+
+    // Destinations get MAC address of their next hop
+    for (auto& [dst, nextHop] : nextHops) {
+        auto neighbor = neighbors.find(nextHop);
+        if (neighbor != neighbors.end()) macs[dst] = neighbor->second;
+    }
+}
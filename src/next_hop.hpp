@@ -0,0 +1,105 @@
+/**
+ * @file next_hop.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for resolving link layer address of next hop from kernel tables
+ */
+
+#ifndef NEXT_HOP_HPP
+#define NEXT_HOP_HPP // NEXT_HOP_HPP
+
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include "ip_address.hpp"
+#include "target_generator.hpp"
+
+// Constants for max time of waiting for resolution of neighbor by kernel (ms)
+#define NEIGHBOR_RESOLVE_TIME 1000
+// Constants for interval of checking neighbor table while resolving (ms)
+#define NEIGHBOR_POLL_INTERVAL 10
+
+/**
+ * @brief Struct for MAC address
+ */
+struct MacAddress {
+    uint8_t bytes[6] = {};
+};
+
+/**
+ * @class NextHopResolver
+ * @brief Class for resolving MAC addresses of next hops of destinations
+ *
+ * Next hop is found in routing table of kernel (RTM_GETROUTE, one socket for all destinations) -> gateway of route or
+ * destination itself for local network, its MAC address is found in neighbor table of kernel (RTM_GETNEIGH), both by rtnetlink.
+ * Neighbors which are not known yet are resolved by kernel after empty UDP datagram is sent to them, all of them
+ * are triggered at once and waited for together, so unreachable neighbors cost one NEIGHBOR_RESOLVE_TIME in total.
+ */
+class NextHopResolver{
+    public:
+        /**
+         * @brief Construct of NextHopResolver
+         *
+         * @param interface - name of interface
+         *
+         * @throw std::runtime_error if interface or its MAC address cannot be found
+         */
+        NextHopResolver(const std::string& interface);
+        /**
+         * @brief Method for resolving MAC addresses of next hops of destinations
+         *
+         * @param destinations - generator of destination addresses of one family
+         * @param macs - resolved MAC addresses, destinations without resolved next hop are missing
+         */
+        void resolve(TargetGenerator destinations, std::unordered_map<IpAddress, MacAddress, IpAddressHash>& macs);
+        /**
+         * @brief Getter of MAC address of interface
+         *
+         * @return MAC address of interface
+         */
+        const MacAddress& interfaceMac() const { return this->localMac; }
+
+    private:
+        /**
+         * @brief Method for finding next hop of destination in routing table
+         *
+         * @param fdSock - rtnetlink socket shared by all lookups
+         * @param dst - destination address
+         * @param nextHop - gateway of route or destination itself
+         * @return true if route was found
+         */
+        bool findRoute(int fdSock, const IpAddress& dst, IpAddress& nextHop);
+        /**
+         * @brief Method for reading neighbors of interface with usable MAC address from neighbor table
+         *
+         * @param family - AF_INET or AF_INET6
+         * @param neighbors - MAC addresses of neighbors
+         */
+        void readNeighbors(sa_family_t family, std::unordered_map<IpAddress, MacAddress, IpAddressHash>& neighbors);
+        /**
+         * @brief Method for opening rtnetlink socket
+         *
+         * @return file descriptor of socket, -1 if error
+         */
+        static int openSocket();
+        /**
+         * @brief Method for sending request to kernel by rtnetlink socket
+         *
+         * @param fdSock - rtnetlink socket
+         * @param request - netlink message of request
+         * @param requestLen - length of request
+         * @return true if request was sent
+         */
+        static bool sendRequest(int fdSock, const void* request, size_t requestLen);
+        // Name and index of interface
+        std::string interface;
+        int ifindex;
+        // Loopback has no link layer addresses
+        bool loopback;
+        MacAddress localMac;
+        // Sequence number of last route request, reply is matched to it
+        uint32_t sequence;
+};
+
+#endif // NEXT_HOP_HPP
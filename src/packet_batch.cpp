@@ -0,0 +1,99 @@
+/**
+ * @file packet_batch.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of batches of packets sent by sendmmsg and received by recvmmsg
+ */
+
+#include "packet_batch.hpp"
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+
+// Constructor of send batch
+
+SendBatch::SendBatch() : messages(BATCH_SIZE), vectors(BATCH_SIZE), packets(BATCH_SIZE * BATCH_PACKET_SIZE), addresses(BATCH_SIZE), first(0), count(0) {
+    // Every message points to its own slot
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        memset(&this->messages[i], 0, sizeof(struct mmsghdr));
+        this->vectors[i].iov_base = this->packets.data() + i * BATCH_PACKET_SIZE;
+        this->messages[i].msg_hdr.msg_iov = &this->vectors[i];
+        this->messages[i].msg_hdr.msg_iovlen = 1;
+        this->messages[i].msg_hdr.msg_name = &this->addresses[i];
+    }
+}
+
+// Method for adding packet to batch
+
+bool SendBatch::add(const void* packet, size_t length, const struct sockaddr_storage& dstAddr, socklen_t dstAddrLen) {
+    if (this->full() || length > BATCH_PACKET_SIZE) return false;
+    memcpy(this->vectors[this->count].iov_base, packet, length);
+    this->vectors[this->count].iov_len = length;
+    memcpy(&this->addresses[this->count], &dstAddr, dstAddrLen);
+    this->messages[this->count].msg_hdr.msg_namelen = dstAddrLen;
+    this->count++;
+    return true;
+}
+
+// Method for sending queued packets
+
+int SendBatch::flush(int fdSock) {
+    int total = 0;
+    while (!this->empty()) {
+        int sent = sendmmsg(fdSock, &this->messages[this->first], this->count - this->first, 0);
+        if (sent == -1) {
+            if (errno == EINTR) continue;
+            // Broadcast address is refused by kernel, its packet is dropped and the rest is sent
+            if (errno == EACCES) {
+                this->first++;
+                continue;
+            }
+            // Send buffer is full, rest of batch is sent by next flush
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) return total;
+            return -1;
+        }
+        this->first += sent;
+        total += sent;
+    }
+    // All packets were sent, slots are free again
+    this->first = 0;
+    this->count = 0;
+    return total;
+}
+
+// Constructor of receive batch
+
+RecvBatch::RecvBatch(size_t bufferSize) : messages(BATCH_SIZE), vectors(BATCH_SIZE), buffers(BATCH_SIZE * bufferSize), addresses(BATCH_SIZE), bufferSize(bufferSize), position(0), count(0) {
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        memset(&this->messages[i], 0, sizeof(struct mmsghdr));
+        this->vectors[i].iov_base = this->buffers.data() + i * bufferSize;
+        this->vectors[i].iov_len = bufferSize;
+        this->messages[i].msg_hdr.msg_iov = &this->vectors[i];
+        this->messages[i].msg_hdr.msg_iovlen = 1;
+        this->messages[i].msg_hdr.msg_name = &this->addresses[i];
+    }
+}
+
+// Method for getting next received packet
+
+bool RecvBatch::next(int fdSock, const char*& packet, size_t& length, const struct sockaddr_storage*& from) {
+    // All packets of last batch were read -> receive next batch
+    if (this->position == this->count) {
+        // Lengths of socket addresses are overwritten by kernel
+        for (size_t i = 0; i < BATCH_SIZE; i++) this->messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+        int received = recvmmsg(fdSock, this->messages.data(), BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (received == -1) {
+            this->position = this->count = 0;
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return false;
+            throw std::runtime_error("Cannot receive packet!");
+        }
+        this->position = 0;
+        this->count = received;
+        if (received == 0) return false;
+    }
+    packet = (const char*)this->vectors[this->position].iov_base;
+    length = this->messages[this->position].msg_len;
+    from = &this->addresses[this->position];
+    this->position++;
+    return true;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file packet_batch.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for batches of packets sent by sendmmsg and received by recvmmsg
+ */
+
+#ifndef PACKET_BATCH_HPP
+#define PACKET_BATCH_HPP // PACKET_BATCH_HPP
+
+#include <cstddef>
+#include <vector>
+#include <sys/socket.h>
+
+// Constants for count of packets in one batch
+#define BATCH_SIZE 64
+// Constants for max size of one sent packet
+#define BATCH_PACKET_SIZE 1500
+
+/**
+ * @class SendBatch
+ * @brief Class for queue of packets sent by one sendmmsg call
+ *
+ * Packets and their destination addresses are copied to preallocated slots, so nothing is allocated after construction.
+ * When socket send buffer is full, sendmmsg sends only part of batch, the rest stays queued for next flush.
+ */
+class SendBatch{
+    public:
+        /**
+         * @brief Construct of SendBatch
+         */
+        SendBatch();
+        /**
+         * @brief Method for adding packet to batch
+         *
+         * @param packet - data of packet
+         * @param length - length of packet, at most BATCH_PACKET_SIZE
+         * @param dstAddr - destination socket address
+         * @param dstAddrLen - length of destination socket address
+         * @return true if packet was added, false if batch is full
+         */
+        bool add(const void* packet, size_t length, const struct sockaddr_storage& dstAddr, socklen_t dstAddrLen);
+        /**
+         * @brief Method for sending queued packets
+         *
+         * @param fdSock - file descriptor of non-blocking socket
+         * @return count of sent packets, -1 if error
+         */
+        int flush(int fdSock);
+        /**
+         * @brief Method for checking if batch is full
+         *
+         * @return true if no more packets can be added before flush
+         */
+        bool full() const { return this->count == BATCH_SIZE; }
+        /**
+         * @brief Method for checking if batch is empty
+         *
+         * @return true if there is no queued packet
+         */
+        bool empty() const { return this->first == this->count; }
+
+    private:
+        // Headers of messages for sendmmsg
+        std::vector<struct mmsghdr> messages;
+        std::vector<struct iovec> vectors;
+        // Slots of packets and destination addresses
+        std::vector<char> packets;
+        std::vector<struct sockaddr_storage> addresses;
+        // First not sent packet and count of added packets
+        size_t first;
+        size_t count;
+};
+
+/**
+ * @class RecvBatch
+ * @brief Class for packets received by one recvmmsg call
+ *
+ * Packets are received to preallocated buffers and read one by one, next recvmmsg is called when all were read.
+ */
+class RecvBatch{
+    public:
+        /**
+         * @brief Construct of RecvBatch
+         *
+         * @param bufferSize - size of buffer of one packet
+         */
+        RecvBatch(size_t bufferSize);
+        /**
+         * @brief Method for getting next received packet
+         *
+         * @param fdSock - file descriptor of non-blocking socket
+         * @param packet - pointer to received packet
+         * @param length - length of received packet
+         * @param from - socket address of sender
+         * @return true if packet was received, false if there are no more packets
+         *
+         * @throw std::runtime_error if recvmmsg fails
+         */
+        bool next(int fdSock, const char*& packet, size_t& length, const struct sockaddr_storage*& from);
+
+    private:
+        // Headers of messages for recvmmsg
+        std::vector<struct mmsghdr> messages;
+        std::vector<struct iovec> vectors;
+        // Buffers of packets and socket addresses of senders
+        std::vector<char> buffers;
+        std::vector<struct sockaddr_storage> addresses;
+        size_t bufferSize;
+        // Next not read packet and count of received packets
+        size_t position;
+        size_t count;
+};
+
+#endif // PACKET_BATCH_HPP
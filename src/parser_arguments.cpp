@@ -7,24 +7,79 @@
  */
 
 #include "parser_arguments.hpp"
+#include "result_sink.hpp"
+#include "port_state.hpp"
 #include <iostream>
 #include <string>
+#include <regex>
+#include <arpa/inet.h>
 
 // Constructor
 ParseArguments::ParseArguments(int argCount, char* args[]){
     // Initialize attributes of the class for default values
     this->helpOnly = false;
     this->interfaceOnly = false;
+    this->queryOnly = false;
     this->parsedInterface = "";
     this->parsedDomain = "";
+    this->parsedTargetList = "";
     this->parsedTcpPorts = "";
     this->parsedUdpPorts = "";
     this->timeout = "";
+    this->asyncMode = false;
+    this->statelessMode = false;
+    this->batchMode = false;
+    this->rxRingMode = false;
+    this->txRingMode = false;
+    this->qdiscBypass = false;
+    this->rate = "";
+    this->burst = "";
+    this->threads = "";
+    this->seed = "";
+    this->concurrentMode = false;
+    this->dnsCache = "";
+    this->outputFormat = "";
+    this->resumeFile = "";
+    this->storeFile = "";
+    this->baselineFile = "";
+    this->changedFirst = false;
+    this->connectMode = false;
+    this->connectWindow = "";
     // Call method for parsing arguments
     this->parse(argCount, args);
     // If help or interface flag is set, dont create object of ScannerParams
-    if(!this->helpOnly && !this->interfaceOnly){
-        this->scanParams = ScannerParams(this->parsedInterface, this->parsedDomain, this->parsedTcpPorts, this->parsedUdpPorts, this->timeout);
+    if(!this->helpOnly && !this->interfaceOnly && !this->queryOnly){
+        this->scanParams = ScannerParams(this->parsedInterface, this->parsedDomain, this->parsedTargetList, this->parsedTcpPorts, this->parsedUdpPorts, this->timeout, this->dnsCache);
+        // Stateless, batch, ring and threaded modes are variants of asynchronous mode, bypass of queueing discipline needs transmit ring
+        this->scanParams.setAsyncMode(this->asyncMode || this->statelessMode || this->batchMode || this->rxRingMode || this->txRingMode || this->qdiscBypass || !this->threads.empty());
+        this->scanParams.setStatelessMode(this->statelessMode);
+        this->scanParams.setBatchMode(this->batchMode);
+        this->scanParams.setRxRingMode(this->rxRingMode);
+        this->scanParams.setTxRingMode(this->txRingMode || this->qdiscBypass);
+        this->scanParams.setQdiscBypass(this->qdiscBypass);
+        this->scanParams.setRate(this->rate);
+        this->scanParams.setBurst(this->burst);
+        this->scanParams.setThreads(this->threads);
+        this->scanParams.setSeed(this->seed);
+        // Concurrent event loop has own sending and receiving, it cannot be combined with asynchronous TCP scanner
+        if (this->concurrentMode && this->scanParams.isAsyncMode()) throw std::invalid_argument("");
+        this->scanParams.setConcurrentMode(this->concurrentMode);
+        this->scanParams.setOutputFormat(this->outputFormat);
+        // Checkpoint stores one order of probes, stateless and threaded scanners have no single position in it
+        if (!this->resumeFile.empty() && (this->scanParams.isStatelessMode() || this->scanParams.getThreads() > 1)) throw std::invalid_argument("");
+        this->scanParams.setResumeFile(this->resumeFile);
+        this->scanParams.setStoreFile(this->storeFile);
+        // Probes are reordered only by baseline, stateless and threaded scanners have no single order of probes
+        if (this->changedFirst && (this->baselineFile.empty() || this->scanParams.isStatelessMode() || this->scanParams.getThreads() > 1)) throw std::invalid_argument("");
+        // Stateless scan reports only answering ports, port which stopped answering would never be reported as changed
+        if (!this->baselineFile.empty() && this->scanParams.isStatelessMode()) throw std::invalid_argument("");
+        this->scanParams.setBaselineFile(this->baselineFile);
+        this->scanParams.setChangedFirst(this->changedFirst);
+        // Connect scan has no raw sockets, so it scans only TCP ports and replaces raw scanners, window needs connect scan
+        if (this->connectMode && (this->scanParams.isAsyncMode() || this->concurrentMode || !this->scanParams.getUdpPorts().empty())) throw std::invalid_argument("");
+        if (!this->connectMode && !this->connectWindow.empty()) throw std::invalid_argument("");
+        this->scanParams.setConnectMode(this->connectMode);
+        this->scanParams.setConnectWindow(this->connectWindow);
     }
 }
 
@@ -46,6 +101,10 @@ std::string ParseArguments::getParsedDomain(){
     return this->parsedDomain;
 }
 
+std::string ParseArguments::getParsedTargetList(){
+    return this->parsedTargetList;
+}
+
 std::string ParseArguments::getParsedTcpPorts(){
     return this->parsedTcpPorts;
 }
@@ -58,6 +117,90 @@ std::string ParseArguments::getTimeout(){
     return this->timeout;
 }
 
+bool ParseArguments::getAsyncMode(){
+    return this->asyncMode;
+}
+
+bool ParseArguments::getStatelessMode(){
+    return this->statelessMode;
+}
+
+bool ParseArguments::getBatchMode(){
+    return this->batchMode;
+}
+
+bool ParseArguments::getRxRingMode(){
+    return this->rxRingMode;
+}
+
+bool ParseArguments::getTxRingMode(){
+    return this->txRingMode;
+}
+
+bool ParseArguments::getQdiscBypass(){
+    return this->qdiscBypass;
+}
+
+std::string ParseArguments::getRate(){
+    return this->rate;
+}
+
+std::string ParseArguments::getBurst(){
+    return this->burst;
+}
+
+std::string ParseArguments::getThreads(){
+    return this->threads;
+}
+
+std::string ParseArguments::getSeed(){
+    return this->seed;
+}
+
+bool ParseArguments::getConcurrentMode(){
+    return this->concurrentMode;
+}
+
+std::string ParseArguments::getDnsCache(){
+    return this->dnsCache;
+}
+
+std::string ParseArguments::getOutputFormat(){
+    return this->outputFormat;
+}
+
+std::string ParseArguments::getResumeFile(){
+    return this->resumeFile;
+}
+
+std::string ParseArguments::getBaselineFile(){
+    return this->baselineFile;
+}
+
+bool ParseArguments::getChangedFirst(){
+    return this->changedFirst;
+}
+
+bool ParseArguments::getConnectMode(){
+    return this->connectMode;
+}
+
+std::string ParseArguments::getConnectWindow(){
+    return this->connectWindow;
+}
+
+std::string ParseArguments::getStoreFile(){
+    return this->storeFile;
+}
+
+bool ParseArguments::isQueryOnly(){
+    return this->queryOnly;
+}
+
+StoreQuery ParseArguments::getQuery(){
+    return this->query;
+}
+
 ScannerParams ParseArguments::getScanParams(){
     return this->scanParams;
 }
@@ -76,6 +219,13 @@ void ParseArguments::parse(int argCount, char*  args[]){
         return;
     }
 
+    // Subcommand query reads result store, it has own arguments
+    if (argCount >= 2 && std::string(args[1]) == "query"){
+        this->queryOnly = true;
+        this->parseQuery(argCount, args);
+        return;
+    }
+
     int index = 1;
     // Parse arguments, by empty() swas detected duplicity and uncorect combination of arguments
     while (index < argCount) {
@@ -96,6 +246,86 @@ void ParseArguments::parse(int argCount, char*  args[]){
             this->timeout = args[index + 1];
             index += 2;
         }
+        else if ((arg == "-a" || arg == "--async") && !this->asyncMode) {
+            this->asyncMode = true;
+            index++;
+        }
+        else if (arg == "--stateless" && !this->statelessMode) {
+            this->statelessMode = true;
+            index++;
+        }
+        else if (arg == "--batch" && !this->batchMode) {
+            this->batchMode = true;
+            index++;
+        }
+        else if (arg == "--rx-ring" && !this->rxRingMode) {
+            this->rxRingMode = true;
+            index++;
+        }
+        else if (arg == "--tx-ring" && !this->txRingMode) {
+            this->txRingMode = true;
+            index++;
+        }
+        else if (arg == "--qdisc-bypass" && !this->qdiscBypass) {
+            this->qdiscBypass = true;
+            index++;
+        }
+        else if (arg == "--rate" && this->rate.empty() && index + 1 < argCount) {
+            this->rate = args[index + 1];
+            index += 2;
+        }
+        else if (arg == "--burst" && this->burst.empty() && index + 1 < argCount) {
+            this->burst = args[index + 1];
+            index += 2;
+        }
+        else if (arg == "--threads" && this->threads.empty() && index + 1 < argCount) {
+            this->threads = args[index + 1];
+            index += 2;
+        }
+        else if (arg == "--seed" && this->seed.empty() && index + 1 < argCount) {
+            this->seed = args[index + 1];
+            index += 2;
+        }
+        else if (arg == "--concurrent" && !this->concurrentMode) {
+            this->concurrentMode = true;
+            index++;
+        }
+        else if (arg == "--dns-cache" && this->dnsCache.empty() && index + 1 < argCount) {
+            this->dnsCache = args[index + 1];
+            index += 2;
+        }
+        else if (arg == "--format" && this->outputFormat.empty() && index + 1 < argCount) {
+            this->outputFormat = args[index + 1];
+            index += 2;
+        }
+        else if (arg == "--resume" && this->resumeFile.empty() && index + 1 < argCount) {
+            this->resumeFile = args[index + 1];
+            index += 2;
+        }
+        else if (arg == "--store" && this->storeFile.empty() && index + 1 < argCount) {
+            this->storeFile = args[index + 1];
+            index += 2;
+        }
+        else if (arg == "--baseline" && this->baselineFile.empty() && index + 1 < argCount) {
+            this->baselineFile = args[index + 1];
+            index += 2;
+        }
+        else if (arg == "--changed-first" && !this->changedFirst) {
+            this->changedFirst = true;
+            index++;
+        }
+        else if (arg == "--connect" && !this->connectMode) {
+            this->connectMode = true;
+            index++;
+        }
+        else if (arg == "--connect-window" && this->connectWindow.empty() && index + 1 < argCount) {
+            this->connectWindow = args[index + 1];
+            index += 2;
+        }
+        else if (arg == "-iL" && this->parsedTargetList.empty() && index + 1 < argCount) {
+            this->parsedTargetList = args[index + 1];
+            index += 2;
+        }
         else if (this->parsedDomain.empty()) {
             this->parsedDomain = arg;
             index++;
@@ -106,4 +336,54 @@ void ParseArguments::parse(int argCount, char*  args[]){
         }
     }
     return;
-}
\ No newline at end of file
+}
+
+// Method for parsing arguments of subcommand query -> query <store> [--host addr] [--port port] [--proto tcp|udp] [--state state] [--changed] [--format format]
+
+void ParseArguments::parseQuery(int argCount, char*  args[]){
+    // Path of store is first argument of subcommand
+    if (argCount < 3 || args[2][0] == '-') throw std::invalid_argument("");
+    this->query.path = args[2];
+    bool hasProtocol = false;
+    bool hasFormat = false;
+
+    int index = 3;
+    // Parse filters, every filter can be pasted once
+    while (index < argCount) {
+        std::string arg = args[index];
+        // Flag without value
+        if (arg == "--changed" && !this->query.changed) {
+            this->query.changed = true;
+            index++;
+            continue;
+        }
+        if (index + 1 >= argCount) throw std::invalid_argument("");
+        std::string value = args[index + 1];
+        if (arg == "--host" && !this->query.hasHost) {
+            this->query.host.family = value.find(':') == std::string::npos ? AF_INET : AF_INET6;
+            if (inet_pton(this->query.host.family, value.c_str(), this->query.host.bytes) != 1) throw std::invalid_argument("");
+            this->query.hasHost = true;
+        }
+        else if (arg == "--port" && this->query.port == -1) {
+            // Regular expression for port, max 5 digits
+            if (!std::regex_match(value, std::regex("^[0-9]{1,5}$")) || std::stoi(value) > 65535) throw std::invalid_argument("");
+            this->query.port = std::stoi(value);
+        }
+        else if (arg == "--proto" && !hasProtocol && (value == "tcp" || value == "udp")) {
+            this->query.protocol = value == "tcp" ? IPPROTO_TCP : IPPROTO_UDP;
+            hasProtocol = true;
+        }
+        else if (arg == "--state" && this->query.state == -1 && PortState::decodeName(value) != -1) {
+            this->query.state = PortState::decodeName(value);
+        }
+        else if (arg == "--format" && !hasFormat && ResultSink::isFormat(value)) {
+            this->query.format = value;
+            hasFormat = true;
+        }
+        else {
+            throw std::invalid_argument("");
+        }
+        index += 2;
+    }
+    if (!hasFormat) this->query.format = DEFAULT_OUTPUT_FORMAT;
+}
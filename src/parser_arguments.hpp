@@ -12,6 +12,7 @@
 #include <iostream>
 #include <string>
 #include "scanner_params.hpp"
+#include "result_store.hpp"
 
 /**
  * @brief Class for parsing arguments
@@ -46,6 +47,30 @@ class ParseArguments{
          * @return true if program will only print interface, false otherwise
          */
         bool isInterfaceOnly();
+        /**
+         * @brief Method for checking if program will only query result store
+         * 
+         * This method returns true if subcommand query was requested.
+         * 
+         * @return true if program will only query result store, false otherwise
+         */
+        bool isQueryOnly();
+        /**
+         * @brief Getter of query of result store
+         * 
+         * This method returns parsed filter of subcommand query.
+         * 
+         * @return parsed query
+         */
+        StoreQuery getQuery();
+        /**
+         * @brief Getter of path of result store
+         * 
+         * This method returns parsed path of columnar store of results.
+         * 
+         * @return parsed path of result store
+         */
+        std::string getStoreFile();
         /**
          * @brief Getter of parsed interface
          * 
@@ -62,6 +87,14 @@ class ParseArguments{
          * @return parsed domain
          */
         std::string getParsedDomain();
+        /**
+         * @brief Getter of parsed list of targets
+         * 
+         * This method returns path of file with list of targets, "-" for standard input.
+         * 
+         * @return parsed path of list of targets
+         */
+        std::string getParsedTargetList();
         /**
          * @brief Getter of parsed TCP ports
          * 
@@ -86,6 +119,150 @@ class ParseArguments{
          * @return parsed timeout
          */
         std::string getTimeout();
+        /**
+         * @brief Getter of asynchronous mode flag
+         * 
+         * This method returns true if asynchronous mode was requested.
+         * 
+         * @return parsed asynchronous mode flag
+         */
+        bool getAsyncMode();
+        /**
+         * @brief Getter of stateless mode flag
+         * 
+         * This method returns true if stateless mode was requested.
+         * 
+         * @return parsed stateless mode flag
+         */
+        bool getStatelessMode();
+        /**
+         * @brief Getter of batch mode flag
+         * 
+         * This method returns true if batched sending and receiving was requested.
+         * 
+         * @return parsed batch mode flag
+         */
+        bool getBatchMode();
+        /**
+         * @brief Getter of receive ring mode flag
+         * 
+         * This method returns true if receiving by memory mapped ring was requested.
+         * 
+         * @return parsed receive ring mode flag
+         */
+        bool getRxRingMode();
+        /**
+         * @brief Getter of transmit ring mode flag
+         * 
+         * This method returns true if sending by memory mapped ring was requested.
+         * 
+         * @return parsed transmit ring mode flag
+         */
+        bool getTxRingMode();
+        /**
+         * @brief Getter of bypass of queueing discipline flag
+         * 
+         * This method returns true if bypass of queueing discipline was requested.
+         * 
+         * @return parsed bypass of queueing discipline flag
+         */
+        bool getQdiscBypass();
+        /**
+         * @brief Getter of rate
+         * 
+         * This method returns parsed max count of sent packets per second.
+         * 
+         * @return parsed rate
+         */
+        std::string getRate();
+        /**
+         * @brief Getter of burst
+         * 
+         * This method returns parsed max count of packets sent at once.
+         * 
+         * @return parsed burst
+         */
+        std::string getBurst();
+        /**
+         * @brief Getter of threads
+         * 
+         * This method returns parsed count of scanning threads.
+         * 
+         * @return parsed count of threads
+         */
+        std::string getThreads();
+        /**
+         * @brief Getter of seed
+         * 
+         * This method returns parsed seed of order of probes.
+         * 
+         * @return parsed seed
+         */
+        std::string getSeed();
+        /**
+         * @brief Getter of concurrent mode flag
+         * 
+         * This method returns true if scanning of all protocols and address families in one event loop was requested.
+         * 
+         * @return parsed concurrent mode flag
+         */
+        bool getConcurrentMode();
+        /**
+         * @brief Getter of path of DNS cache
+         * 
+         * This method returns parsed path of file with cache of resolved domain names.
+         * 
+         * @return parsed path of DNS cache
+         */
+        std::string getDnsCache();
+        /**
+         * @brief Getter of output format
+         * 
+         * This method returns parsed format of results.
+         * 
+         * @return parsed output format
+         */
+        std::string getOutputFormat();
+        /**
+         * @brief Getter of path of checkpoint
+         * 
+         * This method returns parsed path of file with checkpoint of resumable scan.
+         * 
+         * @return parsed path of checkpoint
+         */
+        std::string getResumeFile();
+        /**
+         * @brief Getter of path of baseline
+         * 
+         * This method returns parsed path of result store of previous scan.
+         * 
+         * @return parsed path of baseline
+         */
+        std::string getBaselineFile();
+        /**
+         * @brief Getter of changed first flag
+         * 
+         * This method returns true if probes of ports which differed in previous scan should be sent first.
+         * 
+         * @return parsed changed first flag
+         */
+        bool getChangedFirst();
+        /**
+         * @brief Getter of connect mode flag
+         * 
+         * This method returns true if TCP ports should be scanned by non-blocking connect without raw sockets.
+         * 
+         * @return parsed connect mode flag
+         */
+        bool getConnectMode();
+        /**
+         * @brief Getter of connect window
+         * 
+         * This method returns parsed max count of connections of connect scan opened at once.
+         * 
+         * @return parsed connect window
+         */
+        std::string getConnectWindow();
         /**
          * @brief Getter of scan parameters
          * 
@@ -99,14 +276,37 @@ class ParseArguments{
         // Attributes of the class
         std::string parsedInterface;
         std::string parsedDomain;
+        std::string parsedTargetList;
         std::string parsedTcpPorts;
         std::string parsedUdpPorts;
         std::string timeout;
+        bool asyncMode;
+        bool statelessMode;
+        bool batchMode;
+        bool rxRingMode;
+        bool txRingMode;
+        bool qdiscBypass;
+        std::string rate;
+        std::string burst;
+        std::string threads;
+        std::string seed;
+        bool concurrentMode;
+        std::string dnsCache;
+        std::string outputFormat;
+        std::string resumeFile;
+        std::string storeFile;
+        std::string baselineFile;
+        bool changedFirst;
+        bool connectMode;
+        std::string connectWindow;
+        // Filter of subcommand query
+        StoreQuery query;
         // Object of ScannerParams
         ScannerParams scanParams;
         // Flags for help and interface
         bool helpOnly;
         bool interfaceOnly;
+        bool queryOnly;
         /**
          * @brief Method for parsing arguments
          * 
@@ -117,6 +317,17 @@ class ParseArguments{
          * 
          */
         void parse(int argCount, char*  args[]);
+        /**
+         * @brief Method for parsing arguments of subcommand query
+         * 
+         * This method parses path of store and filters -> --host, --port, --proto, --state, --changed and --format.
+         * 
+         * @param argCount Number of arguments
+         * @param args Array of arguments from command line
+         * 
+         * @throws std::invalid_argument if argument is unknown, repeated or invalid
+         */
+        void parseQuery(int argCount, char*  args[]);
 };
 
 
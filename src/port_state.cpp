@@ -0,0 +1,48 @@
+/**
+ * @file port_state.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of decoding and naming codes of port states
+ */
+
+#include "port_state.hpp"
+
+// Texts and names of states indexed by code
+
+static const char* stateTexts[PORT_STATE_COUNT] = {"tcp open", "tcp closed", "tcp filtered", "tcp open|filtered", "udp open", "udp closed", "udp filtered", "udp open|filtered"};
+static const char* stateNames[PORT_STATE_MASK + 1] = {"open", "closed", "filtered", "open|filtered"};
+
+// Method for decoding code of state
+
+bool PortState::decode(uint8_t code, portState& state) {
+    if (code >= PORT_STATE_COUNT) return false;
+    state = (portState)code;
+    return true;
+}
+
+// Method for decoding name of state without protocol
+
+int PortState::decodeName(const std::string& name) {
+    for (int bits = 0; bits <= PORT_STATE_MASK; bits++) {
+        if (name == stateNames[bits]) return bits;
+    }
+    return -1;
+}
+
+// Method for getting text of state
+
+const char* PortState::text(portState state) {
+    return stateTexts[state];
+}
+
+// Method for getting protocol of state
+
+const char* PortState::protocol(portState state) {
+    return isUdp(state) ? "udp" : "tcp";
+}
+
+// Method for getting name of state without protocol
+
+const char* PortState::name(portState state) {
+    return stateNames[state & PORT_STATE_MASK];
+}
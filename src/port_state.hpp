@@ -0,0 +1,90 @@
+/**
+ * @file port_state.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Library for state of scanned port
+ */
+
+#ifndef PORT_STATE_HPP
+#define PORT_STATE_HPP // PORT_STATE_HPP
+
+#include <cstdint>
+#include <string>
+
+// Constants for bits of code of state -> bits 0-1 are state of port, bit 2 is set for UDP
+#define PORT_STATE_MASK 3
+#define PORT_STATE_UDP 4
+// Constants for count of codes of state
+#define PORT_STATE_COUNT 8
+
+/**
+ * @brief Enum for state of scanned port with its protocol
+ *
+ * Code of state is the same in result store, binary results, journal of checkpoint and baseline, so results are
+ * passed between them without conversion. Text "<protocol> <state>" is made only when result is formatted.
+ */
+enum portState : uint8_t {
+    PORT_TCP_OPEN = 0,
+    PORT_TCP_CLOSED = 1,
+    PORT_TCP_FILTERED = 2,
+    PORT_TCP_OPEN_FILTERED = 3,
+    PORT_UDP_OPEN = 4,
+    PORT_UDP_CLOSED = 5,
+    PORT_UDP_FILTERED = 6,
+    PORT_UDP_OPEN_FILTERED = 7,
+    // No state, e.g. packet is not reply to probe
+    PORT_NONE = 0xff
+};
+
+/**
+ * @class PortState
+ * @brief Class for decoding and naming codes of port states
+ */
+class PortState{
+    public:
+        /**
+         * @brief Method for decoding code of state
+         *
+         * @param code - code read from store, binary record or journal
+         * @param state - decoded state
+         * @return false if code is not state
+         */
+        static bool decode(uint8_t code, portState& state);
+        /**
+         * @brief Method for decoding name of state without protocol
+         *
+         * @param name - "open", "closed", "filtered" or "open|filtered"
+         * @return state bits of name (code & PORT_STATE_MASK), -1 for unknown name
+         */
+        static int decodeName(const std::string& name);
+        /**
+         * @brief Method for getting text of state used by text output
+         *
+         * @param state - state of port
+         * @return "<protocol> <state>", e.g. "tcp open"
+         */
+        static const char* text(portState state);
+        /**
+         * @brief Method for getting protocol of state
+         *
+         * @param state - state of port
+         * @return "tcp" or "udp"
+         */
+        static const char* protocol(portState state);
+        /**
+         * @brief Method for getting name of state without protocol
+         *
+         * @param state - state of port
+         * @return "open", "closed", "filtered" or "open|filtered"
+         */
+        static const char* name(portState state);
+        /**
+         * @brief Method for checking protocol of state
+         *
+         * @param state - state of port
+         * @return true for state of UDP port
+         */
+        static bool isUdp(portState state) { return (state & PORT_STATE_UDP) != 0; }
+};
+
+#endif // PORT_STATE_HPP
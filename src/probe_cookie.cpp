@@ -0,0 +1,107 @@
+/**
+ * @file probe_cookie.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of keyed cookies of probes
+ */
+
+#include "probe_cookie.hpp"
+#include "scanner.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <sys/random.h>
+
+// Rotation of 64 bit word
+
+static inline uint64_t rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// One SipRound
+
+static inline void sipRound(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) {
+    v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32);
+    v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;
+    v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;
+    v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32);
+}
+
+// SipHash-2-4 of message of whole 64 bit words
+
+static uint64_t sipHash(const uint64_t key[2], const uint64_t* words, size_t count) {
+    uint64_t v0 = key[0] ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = key[1] ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = key[0] ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = key[1] ^ 0x7465646279746573ULL;
+    // Compression of message words
+    for (size_t i = 0; i < count; i++) {
+        v3 ^= words[i];
+        sipRound(v0, v1, v2, v3);
+        sipRound(v0, v1, v2, v3);
+        v0 ^= words[i];
+    }
+    // Last block carries only length of message
+    uint64_t last = (uint64_t)(count * 8) << 56;
+    v3 ^= last;
+    sipRound(v0, v1, v2, v3);
+    sipRound(v0, v1, v2, v3);
+    v0 ^= last;
+    // Finalization
+    v2 ^= 0xff;
+    for (int i = 0; i < 4; i++) sipRound(v0, v1, v2, v3);
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+// Constructor
+
+ProbeCookie::ProbeCookie() {
+    uint64_t random[3];
+    if (getrandom(random, sizeof(random), 0) != (ssize_t)sizeof(random)) throw std::runtime_error("Getrandom failed!");
+    this->key[0] = random[0];
+    this->key[1] = random[1];
+    this->scanId = random[2];
+}
+
+// Method for calculating cookie of probe
+
+uint64_t ProbeCookie::hash(const IpAddress& dst, uint16_t dstPort) const {
+    // Message -> address (16 bytes), family and port, scan id
+    uint64_t words[4];
+    memcpy(words, dst.bytes, 16);
+    words[2] = (uint64_t)dst.family << 16 | dstPort;
+    words[3] = this->scanId;
+    return sipHash(this->key, words, 4);
+}
+
+// Getters of cookie parts
+
+uint32_t ProbeCookie::sequence(const IpAddress& dst, uint16_t dstPort) const {
+    return (uint32_t)this->hash(dst, dstPort);
+}
+
+uint16_t ProbeCookie::sourcePort(const IpAddress& dst, uint16_t dstPort) const {
+    return this->portOf(this->hash(dst, dstPort));
+}
+
+// Method for selecting source port of shard, high 32 bits of cookie select one of ports of shard
+
+uint16_t ProbeCookie::portOf(uint64_t cookie) const {
+    unsigned slots = (MAX_SOURCE_PORT - DEFAULT_SOURCE_PORT + 1) / this->shardCount;
+    return DEFAULT_SOURCE_PORT + (cookie >> 32) % slots * this->shardCount + this->shard;
+}
+
+// Method for restricting source ports to shard
+
+void ProbeCookie::setShard(unsigned shard, unsigned count) {
+    this->shard = shard;
+    this->shardCount = count;
+}
+
+// Method for checking reply of probe, both parts of cookie are derived from one hash
+
+bool ProbeCookie::verify(const IpAddress& src, uint16_t srcPort, uint16_t dstPort, uint32_t ack) const {
+    uint64_t cookie = this->hash(src, srcPort);
+    bool seqMatch = (uint32_t)cookie == ack - 1;
+    bool portMatch = this->portOf(cookie) == dstPort;
+    return seqMatch && portMatch;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file probe_cookie.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for keyed cookies carried by sequence number and source port of probes
+ */
+
+#ifndef PROBE_COOKIE_HPP
+#define PROBE_COOKIE_HPP // PROBE_COOKIE_HPP
+
+#include <cstdint>
+#include "ip_address.hpp"
+
+/**
+ * @class ProbeCookie
+ * @brief Class for keyed cookies of probes
+ *
+ * Cookie is SipHash-2-4 of (destination address, destination port, scan id) keyed by random key of the scan.
+ * Low 32 bits of cookie are used as sequence number of SYN and the rest selects source port of probe,
+ * so every SYN-ACK or RST can be checked and attributed to its probe from acknowledgment number and ports alone,
+ * without any table of sent probes.
+ * Source ports can be split to shards, port of shard k of N is k modulo N from DEFAULT_SOURCE_PORT, so replies of each
+ * shard can be told apart by kernel filter of its socket.
+ */
+class ProbeCookie{
+    public:
+        /**
+         * @brief Construct of ProbeCookie
+         *
+         * Generates random key and scan id from kernel random generator.
+         *
+         * @throws std::runtime_error if random bytes cannot be obtained
+         */
+        ProbeCookie();
+        /**
+         * @brief Method for getting sequence number of probe
+         *
+         * @param dst - destination address of probe
+         * @param dstPort - destination port of probe
+         * @return sequence number in host byte order
+         */
+        uint32_t sequence(const IpAddress& dst, uint16_t dstPort) const;
+        /**
+         * @brief Method for getting source port of probe
+         *
+         * @param dst - destination address of probe
+         * @param dstPort - destination port of probe
+         * @return source port from interval DEFAULT_SOURCE_PORT - MAX_SOURCE_PORT
+         */
+        uint16_t sourcePort(const IpAddress& dst, uint16_t dstPort) const;
+        /**
+         * @brief Method for checking reply of probe
+         *
+         * Reply of SYN (SYN-ACK or RST-ACK) acknowledges sequence number of SYN increased by one.
+         *
+         * @param src - source address of reply
+         * @param srcPort - source port of reply -> destination port of probe
+         * @param dstPort - destination port of reply -> source port of probe
+         * @param ack - acknowledgment number of reply in host byte order
+         * @return true if reply belongs to probe of this scan, false otherwise
+         */
+        bool verify(const IpAddress& src, uint16_t srcPort, uint16_t dstPort, uint32_t ack) const;
+        /**
+         * @brief Method for restricting source ports to shard
+         *
+         * @param shard - index of shard
+         * @param count - count of shards
+         */
+        void setShard(unsigned shard, unsigned count);
+
+    private:
+        /**
+         * @brief Method for calculating cookie of probe
+         *
+         * @param dst - destination address of probe
+         * @param dstPort - destination port of probe
+         * @return 64 bit keyed hash
+         */
+        uint64_t hash(const IpAddress& dst, uint16_t dstPort) const;
+        /**
+         * @brief Method for selecting source port of shard by cookie
+         *
+         * @param cookie - cookie of probe
+         * @return source port of probe
+         */
+        uint16_t portOf(uint64_t cookie) const;
+        // Key of SipHash
+        uint64_t key[2];
+        // Identifier of scan
+        uint64_t scanId;
+        // Shard of source ports
+        unsigned shard = 0;
+        unsigned shardCount = 1;
+};
+
+#endif // PROBE_COOKIE_HPP
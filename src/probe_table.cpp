@@ -0,0 +1,96 @@
+/**
+ * @file probe_table.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of table of probes waiting for response
+ */
+
+#include "probe_table.hpp"
+
+// Constructor
+
+ProbeTable::ProbeTable(size_t maxProbes) : records(maxProbes), count(0) {
+    // Index has at least twice as many slots as records, so probe sequences stay short
+    size_t slotCount = 1;
+    while (slotCount < maxProbes * 2) slotCount <<= 1;
+    this->slots.assign(slotCount, 0);
+    this->mask = slotCount - 1;
+    // Chain all records to list of free records
+    for (size_t i = 0; i < maxProbes; i++) {
+        this->records[i].nextFree = (i + 1 < maxProbes) ? (uint32_t)(i + 1) : NO_PROBE;
+    }
+    this->freeList = maxProbes ? 0 : NO_PROBE;
+}
+
+// Method for finding slot of index for key
+
+size_t ProbeTable::findSlot(const ProbeKey& key) const {
+    size_t slot = ProbeKeyHash()(key) & this->mask;
+    while (this->slots[slot] != 0 && !(this->records[this->slots[slot] - 1].key == key)) {
+        slot = (slot + 1) & this->mask;
+    }
+    return slot;
+}
+
+// Method for inserting probe
+
+uint32_t ProbeTable::insert(const ProbeKey& key) {
+    if (this->freeList == NO_PROBE) return NO_PROBE;
+    size_t slot = this->findSlot(key);
+    if (this->slots[slot] != 0) return NO_PROBE;
+
+    // Take record from list of free records
+    uint32_t id = this->freeList;
+    this->freeList = this->records[id].nextFree;
+    this->records[id].key = key;
+    this->records[id].retries = 0;
+    this->records[id].queued = false;
+    this->slots[slot] = id + 1;
+    this->count++;
+    return id;
+}
+
+// Method for finding probe
+
+uint32_t ProbeTable::find(const ProbeKey& key) const {
+    uint32_t entry = this->slots[this->findSlot(key)];
+    return entry ? entry - 1 : NO_PROBE;
+}
+
+// Method for removing probe, following entries of the cluster are shifted back to keep probe sequences unbroken
+
+void ProbeTable::erase(uint32_t id) {
+    size_t slot = this->findSlot(this->records[id].key);
+    if (this->slots[slot] != id + 1) return;
+
+    size_t next = slot;
+    while (true) {
+        this->slots[slot] = 0;
+        // Find entry which can be moved to emptied slot
+        while (true) {
+            next = (next + 1) & this->mask;
+            if (this->slots[next] == 0) {
+                // Return record to list of free records, its identifier can stay only as stale one in queue of retransmissions
+                this->records[id].queued = false;
+                this->records[id].nextFree = this->freeList;
+                this->freeList = id;
+                this->count--;
+                return;
+            }
+            size_t home = ProbeKeyHash()(this->records[this->slots[next] - 1].key) & this->mask;
+            // Entry can be moved only if emptied slot lies on its probe sequence -> between home and its current slot
+            bool between = (slot <= next) ? (home <= slot || home > next) : (home <= slot && home > next);
+            if (between) break;
+        }
+        this->slots[slot] = this->slots[next];
+        slot = next;
+    }
+}
+
+// Method for collecting indexes of stored probes, stored records are those referenced by index
+
+void ProbeTable::indexes(std::vector<uint64_t>& indexes) const {
+    for (uint32_t entry : this->slots) {
+        if (entry != 0) indexes.push_back(this->records[entry - 1].index);
+    }
+}
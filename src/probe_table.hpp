@@ -0,0 +1,157 @@
+/**
+ * @file probe_table.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for table of probes waiting for response
+ */
+
+#ifndef PROBE_TABLE_HPP
+#define PROBE_TABLE_HPP // PROBE_TABLE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "ip_address.hpp"
+
+// Constants for identifier of no probe
+#define NO_PROBE UINT32_MAX
+
+/**
+ * @brief Struct for identification of one probe
+ *
+ * Probe is identified by destination address (with its family), destination port and source port,
+ * reply carries the same values swapped.
+ */
+struct ProbeKey {
+    // Destination address of probe
+    IpAddress dst;
+    // Destination port of probe
+    uint16_t dstPort;
+    // Source port of probe
+    uint16_t srcPort;
+
+    bool operator==(const ProbeKey& other) const {
+        return this->dstPort == other.dstPort && this->srcPort == other.srcPort && this->dst == other.dst;
+    }
+};
+
+/**
+ * @brief Hash function object for ProbeKey
+ */
+struct ProbeKeyHash {
+    size_t operator()(const ProbeKey& key) const {
+        return IpAddressHash()(key.dst) ^ (((size_t)key.dstPort << 16 | key.srcPort) * 0x9E3779B97F4A7C15ULL);
+    }
+};
+
+/**
+ * @brief Struct for probe waiting for response
+ */
+struct ProbeRecord {
+    // Identification of probe
+    ProbeKey key;
+    // Count of retransmissions
+    int retries;
+    // Index of destination of probe, used for its round trip time estimator
+    uint32_t target;
+    // Time of last send of probe (us from start of scan)
+    uint64_t sentAt;
+    // Index of probe in target x port space, stored by checkpoint for probes waiting for response
+    uint64_t index;
+    // Flag for probe in queue of retransmissions, answered probe is erased and its identifier left in queue is skipped
+    bool queued;
+    // Next free record, used only when record is free
+    uint32_t nextFree;
+};
+
+/**
+ * @class ProbeTable
+ * @brief Class for table of probes waiting for response
+ *
+ * Records are preallocated for given count of probes and addressed by their identifier, which does not change while
+ * probe is waiting, so identifier can be stored in TimingWheel. Records are found by flat open addressing hash index
+ * with linear probing, index is kept at most half full and deletion shifts following entries back, so there are no
+ * tombstones. Nothing is allocated after construction.
+ */
+class ProbeTable{
+    public:
+        /**
+         * @brief Construct of ProbeTable
+         *
+         * @param maxProbes - max count of probes stored at once
+         */
+        ProbeTable(size_t maxProbes);
+        /**
+         * @brief Method for inserting probe
+         *
+         * @param key - identification of probe
+         * @return identifier of record, NO_PROBE if table is full or probe is already stored
+         */
+        uint32_t insert(const ProbeKey& key);
+        /**
+         * @brief Method for finding probe
+         *
+         * @param key - identification of probe
+         * @return identifier of record, NO_PROBE if probe is not stored
+         */
+        uint32_t find(const ProbeKey& key) const;
+        /**
+         * @brief Method for removing probe
+         *
+         * @param id - identifier of stored record
+         */
+        void erase(uint32_t id);
+        /**
+         * @brief Getter of record
+         *
+         * @param id - identifier of stored record
+         * @return record of probe
+         */
+        ProbeRecord& at(uint32_t id) { return this->records[id]; }
+        const ProbeRecord& at(uint32_t id) const { return this->records[id]; }
+        /**
+         * @brief Getter of count of stored probes
+         *
+         * @return count of stored probes
+         */
+        size_t size() const { return this->count; }
+        /**
+         * @brief Method for checking if table is full
+         *
+         * @return true if no more probes can be inserted
+         */
+        bool full() const { return this->count == this->records.size(); }
+        /**
+         * @brief Method for checking if table is empty
+         *
+         * @return true if no probe is stored
+         */
+        bool empty() const { return this->count == 0; }
+        /**
+         * @brief Method for collecting indexes of stored probes
+         *
+         * @param indexes - indexes of stored probes in target x port space are appended to it
+         */
+        void indexes(std::vector<uint64_t>& indexes) const;
+
+    private:
+        /**
+         * @brief Method for finding slot of index for key
+         *
+         * @param key - identification of probe
+         * @return slot with the key, or first empty slot on its probe sequence
+         */
+        size_t findSlot(const ProbeKey& key) const;
+        // Preallocated records of probes
+        std::vector<ProbeRecord> records;
+        // Open addressing index, slot holds identifier of record increased by one, zero is empty slot
+        std::vector<uint32_t> slots;
+        // Mask of slot position, count of slots is power of two
+        size_t mask;
+        // First free record
+        uint32_t freeList;
+        // Count of stored probes
+        size_t count;
+};
+
+#endif // PROBE_TABLE_HPP
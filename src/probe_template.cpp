@@ -0,0 +1,127 @@
+/**
+ * @file probe_template.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of prebuilt headers of probes with incremental checksum updates
+ */
+
+#include "probe_template.hpp"
+#include "pseudo_headers.hpp"
+#include "checksum.hpp"
+#include <cstring>
+#include <arpa/inet.h>
+
+// Constants for length of ports and sequence number at start of TCP header and ports at start of UDP header
+#define TCP_PROBE_FIELDS_LENGTH 8
+#define UDP_PROBE_FIELDS_LENGTH 4
+
+// Function for calculating checksum of header with pseudo header of source with zero destination
+
+static uint16_t headerChecksum(const IpAddress& src, int protocol, const void* header, size_t headerLen) {
+    // Segment on stack, pseudo header is at most IPv6 one
+    char segment[sizeof(struct checkSumPseudoHdrIpv6) + sizeof(struct tcphdr)];
+    size_t pseudoHdrLen;
+    if (src.family == AF_INET) {
+        struct checkSumPseudoHdrIpv4 pseudoHdr;
+        memset(&pseudoHdr, 0, sizeof(pseudoHdr));
+        memcpy(&pseudoHdr.srcAddr, src.bytes, 4);
+        pseudoHdr.protocol = protocol;
+        pseudoHdr.protocolLength = htons(headerLen);
+        pseudoHdrLen = sizeof(pseudoHdr);
+        memcpy(segment, &pseudoHdr, pseudoHdrLen);
+    } else {
+        struct checkSumPseudoHdrIpv6 pseudoHdr;
+        memset(&pseudoHdr, 0, sizeof(pseudoHdr));
+        memcpy(&pseudoHdr.src, src.bytes, 16);
+        pseudoHdr.length = htonl(headerLen);
+        pseudoHdr.next_header = protocol;
+        pseudoHdrLen = sizeof(pseudoHdr);
+        memcpy(segment, &pseudoHdr, pseudoHdrLen);
+    }
+    memcpy(segment + pseudoHdrLen, header, headerLen);
+    return Checksum::compute(segment, pseudoHdrLen + headerLen);
+}
+
+// Constructor, headers are built with zero destination, ports and sequence number
+
+ProbeTemplate::ProbeTemplate(const IpAddress& src) {
+    // TCP SYN header
+    this->tcpHeader.th_flags = TH_SYN;
+    this->tcpHeader.th_win = htons(65535);
+    this->tcpHeader.th_off = 5;
+    this->tcpHeader.th_sum = headerChecksum(src, IPPROTO_TCP, &this->tcpHeader, sizeof(struct tcphdr));
+    // UDP header without payload
+    this->udpHeader.len = htons(sizeof(struct udphdr));
+    this->udpHeader.check = headerChecksum(src, IPPROTO_UDP, &this->udpHeader, sizeof(struct udphdr));
+
+    this->dst = IpAddress();
+    this->dst.family = src.family;
+}
+
+// Method for incremental update of checksum -> HC' = ~(~HC + ~m + m')
+
+uint16_t ProbeTemplate::updateChecksum(uint16_t checksum, const void* oldData, const void* newData, size_t length) {
+    const char* oldBytes = (const char*)oldData;
+    const char* newBytes = (const char*)newData;
+    uint64_t sum = (uint16_t)~checksum;
+    for (size_t offset = 0; offset < length; offset += 2) {
+        uint16_t oldWord, newWord;
+        memcpy(&oldWord, oldBytes + offset, 2);
+        memcpy(&newWord, newBytes + offset, 2);
+        sum += (uint16_t)~oldWord;
+        sum += newWord;
+    }
+    // Add carry
+    while (sum >> 16) sum = (sum & 0xFFFF) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+// Method for setting destination address of next probes
+
+void ProbeTemplate::setDestination(const IpAddress& dst) {
+    if (dst == this->dst) return;
+    // Destination address is part of pseudo header of both checksums
+    this->tcpHeader.th_sum = updateChecksum(this->tcpHeader.th_sum, this->dst.bytes, dst.bytes, dst.length());
+    this->udpHeader.check = updateChecksum(this->udpHeader.check, this->dst.bytes, dst.bytes, dst.length());
+    this->dst = dst;
+}
+
+// Method for building TCP SYN header of probe
+
+void ProbeTemplate::buildTcpSyn(uint16_t srcPort, uint16_t dstPort, uint32_t seq, struct tcphdr& tcpHeader) const {
+    static const char zero[TCP_PROBE_FIELDS_LENGTH] = {};
+    tcpHeader = this->tcpHeader;
+    tcpHeader.th_sport = htons(srcPort);
+    tcpHeader.th_dport = htons(dstPort);
+    tcpHeader.th_seq = htonl(seq);
+    // Ports and sequence number are first words of header, they were zero in template
+    tcpHeader.th_sum = updateChecksum(this->tcpHeader.th_sum, zero, &tcpHeader, TCP_PROBE_FIELDS_LENGTH);
+}
+
+// Method for building UDP datagram of probe
+
+size_t ProbeTemplate::buildUdp(uint16_t srcPort, uint16_t dstPort, const uint8_t* payload, size_t payloadLen, char* datagram) const {
+    static const char zero[UDP_PROBE_FIELDS_LENGTH] = {};
+    struct udphdr udpHeader = this->udpHeader;
+    udpHeader.source = htons(srcPort);
+    udpHeader.dest = htons(dstPort);
+    // Ports are first words of header, they were zero in template
+    uint16_t checksum = updateChecksum(this->udpHeader.check, zero, &udpHeader, UDP_PROBE_FIELDS_LENGTH);
+    if (payloadLen > 0) {
+        // Length is in header and in last word of pseudo header, each of them changes one word
+        uint16_t oldLength[2] = {this->udpHeader.len, this->udpHeader.len};
+        udpHeader.len = htons(sizeof(struct udphdr) + payloadLen);
+        uint16_t newLength[2] = {udpHeader.len, udpHeader.len};
+        checksum = updateChecksum(checksum, oldLength, newLength, sizeof(oldLength));
+        // Payload was zero, odd last byte is padded by zero
+        static const uint8_t zeroPayload[UDP_PAYLOAD_MAX + 1] = {};
+        uint8_t padded[UDP_PAYLOAD_MAX + 1] = {};
+        memcpy(padded, payload, payloadLen);
+        checksum = updateChecksum(checksum, zeroPayload, padded, (payloadLen + 1) & ~(size_t)1);
+        memcpy(datagram + sizeof(struct udphdr), payload, payloadLen);
+    }
+    // Zero checksum of UDP means no checksum, it is sent as all ones
+    udpHeader.check = checksum == 0 ? 0xFFFF : checksum;
+    memcpy(datagram, &udpHeader, sizeof(udpHeader));
+    return sizeof(struct udphdr) + payloadLen;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file probe_template.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for prebuilt headers of probes with incremental checksum updates
+ */
+
+#ifndef PROBE_TEMPLATE_HPP
+#define PROBE_TEMPLATE_HPP // PROBE_TEMPLATE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+#include "ip_address.hpp"
+#include "udp_payload.hpp"
+
+/**
+ * @class ProbeTemplate
+ * @brief Class for prebuilt TCP SYN and UDP headers of probes from one source address
+ *
+ * Headers and their checksums over pseudo header are built once with zero destination address, ports and sequence number.
+ * Probe copies prebuilt header, writes changed fields and patches checksum by incremental update (RFC 1624, eqn. 3),
+ * so only changed 16 bit words are summed and nothing is allocated per probe.
+ */
+class ProbeTemplate{
+    public:
+        /**
+         * @brief Default construct of ProbeTemplate, template must be assigned before use
+         */
+        ProbeTemplate() = default;
+        /**
+         * @brief Construct of ProbeTemplate
+         *
+         * @param src - address of interface, its family selects pseudo header
+         */
+        ProbeTemplate(const IpAddress& src);
+        /**
+         * @brief Method for setting destination address of next probes
+         *
+         * Checksums are patched only by difference of old and new address.
+         *
+         * @param dst - destination address of the same family as source
+         */
+        void setDestination(const IpAddress& dst);
+        /**
+         * @brief Method for building TCP SYN header of probe
+         *
+         * @param srcPort - source port in host byte order
+         * @param dstPort - destination port in host byte order
+         * @param seq - sequence number in host byte order
+         * @param tcpHeader - built header with checksum
+         */
+        void buildTcpSyn(uint16_t srcPort, uint16_t dstPort, uint32_t seq, struct tcphdr& tcpHeader) const;
+        /**
+         * @brief Method for building UDP datagram of probe
+         *
+         * Template has checksum of header without payload, length fields and payload are added to it incrementally.
+         *
+         * @param srcPort - source port in host byte order
+         * @param dstPort - destination port in host byte order
+         * @param payload - payload of datagram, nullptr for empty datagram
+         * @param payloadLen - length of payload
+         * @param datagram - buffer for built header with checksum and payload
+         * @return length of datagram
+         */
+        size_t buildUdp(uint16_t srcPort, uint16_t dstPort, const uint8_t* payload, size_t payloadLen, char* datagram) const;
+        /**
+         * @brief Method for incremental update of Internet checksum (RFC 1624)
+         *
+         * @param checksum - checksum of original data
+         * @param oldData - original value of changed words
+         * @param newData - new value of changed words
+         * @param length - length of changed words in bytes, must be even
+         * @return checksum of data with changed words
+         */
+        static uint16_t updateChecksum(uint16_t checksum, const void* oldData, const void* newData, size_t length);
+
+    private:
+        // Prebuilt headers with checksums for current destination, ports and sequence number are zero
+        struct tcphdr tcpHeader = {};
+        struct udphdr udpHeader = {};
+        // Destination address of current checksums
+        IpAddress dst;
+};
+
+#endif // PROBE_TEMPLATE_HPP
@@ -0,0 +1,74 @@
+/**
+ * @file rate_limiter.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of token bucket pacer of sent packets
+ */
+
+#include "rate_limiter.hpp"
+#include <ctime>
+
+// Constructor
+
+RateLimiter::RateLimiter(uint64_t rate, uint64_t burst) {
+    this->interval = rate ? 1e9 / (double)rate : 0;
+    this->tolerance = burst > 1 ? this->interval * (double)(burst - 1) : 0;
+    this->arrival = 0;
+}
+
+// Method for getting monotonic time
+
+uint64_t RateLimiter::now() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+// Method for taking token without waiting
+
+bool RateLimiter::tryAcquire() {
+    if (!this->isLimited()) return true;
+    double current = (double)now();
+    // Packet is too early -> bucket is empty
+    if (current < this->arrival - this->tolerance) return false;
+    // Idle time fills bucket at most to burst
+    if (this->arrival < current) this->arrival = current;
+    this->arrival += this->interval;
+    return true;
+}
+
+// Method for getting time until next token
+
+uint64_t RateLimiter::timeUntilToken() const {
+    if (!this->isLimited()) return 0;
+    double current = (double)now();
+    double ready = this->arrival - this->tolerance;
+    return current >= ready ? 0 : (uint64_t)(ready - current);
+}
+
+// Method for waiting until next token is available
+
+void RateLimiter::waitForToken() const {
+    uint64_t wait = this->timeUntilToken();
+    if (wait == 0) return;
+    uint64_t deadline = now() + wait;
+    // Long wait is slept, kernel wakes up with some latency, so last part is waited actively
+    if (wait > PACER_SPIN_TIME) {
+        uint64_t wakeUp = deadline - PACER_SPIN_TIME;
+        struct timespec time;
+        time.tv_sec = wakeUp / 1000000000ULL;
+        time.tv_nsec = wakeUp % 1000000000ULL;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, nullptr) != 0) {}
+    }
+    while (now() < deadline) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+// Method for taking token, waits until token is available
+
+void RateLimiter::acquire() {
+    while (!this->tryAcquire()) this->waitForToken();
+}
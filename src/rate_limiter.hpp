@@ -0,0 +1,78 @@
+/**
+ * @file rate_limiter.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for token bucket pacer of sent packets
+ */
+
+#ifndef RATE_LIMITER_HPP
+#define RATE_LIMITER_HPP // RATE_LIMITER_HPP
+
+#include <cstdint>
+
+// Constants for time before token, which is waited actively instead of sleeping (ns)
+#define PACER_SPIN_TIME 50000
+
+/**
+ * @class RateLimiter
+ * @brief Class for token bucket pacer
+ *
+ * Bucket is filled by rate tokens per second up to burst tokens, every sent packet takes one token.
+ * Bucket is kept as theoretical arrival time of next packet with nanosecond precision, so there is no periodic refill
+ * and packets are spread evenly in time -> at most burst packets can leave at once.
+ * Rate 0 means no limit.
+ */
+class RateLimiter{
+    public:
+        /**
+         * @brief Construct of RateLimiter
+         *
+         * @param rate - packets per second, 0 for no limit
+         * @param burst - max count of packets sent at once
+         */
+        RateLimiter(uint64_t rate, uint64_t burst);
+        /**
+         * @brief Method for taking token without waiting
+         *
+         * @return true if token was taken, false if packet cannot be sent yet
+         */
+        bool tryAcquire();
+        /**
+         * @brief Method for taking token, waits until token is available
+         *
+         * Waiting sleeps until PACER_SPIN_TIME before token and the rest is waited actively, so rate is kept precisely.
+         */
+        void acquire();
+        /**
+         * @brief Method for getting time until next token
+         *
+         * @return time in nanoseconds, 0 if token is available
+         */
+        uint64_t timeUntilToken() const;
+        /**
+         * @brief Method for waiting until next token is available, token is not taken
+         */
+        void waitForToken() const;
+        /**
+         * @brief Method for checking if rate is limited
+         *
+         * @return true if rate is limited
+         */
+        bool isLimited() const { return this->interval > 0; }
+
+    private:
+        /**
+         * @brief Method for getting monotonic time
+         *
+         * @return time in nanoseconds
+         */
+        static uint64_t now();
+        // Time between two tokens (ns), 0 for no limit
+        double interval;
+        // Tolerance of burst -> time of burst - 1 packets (ns)
+        double tolerance;
+        // Theoretical arrival time of next packet (ns)
+        double arrival;
+};
+
+#endif // RATE_LIMITER_HPP
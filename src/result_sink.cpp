@@ -0,0 +1,220 @@
+/**
+ * @file result_sink.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of formats of results and buffered writer of results with background thread
+ */
+
+#include "result_sink.hpp"
+#include "system_utils.hpp"
+#include <cstring>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <stdexcept>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+// Function for copying text to buffer, returns position after it
+
+static char* appendText(char* buffer, const char* text, size_t length) {
+    memcpy(buffer, text, length);
+    return buffer + length;
+}
+
+// Function for formatting address to buffer, returns position after it
+
+static char* appendAddress(char* buffer, const IpAddress& address) {
+    // Buffer of record has room for the longest IPv6 address with terminating zero
+    inet_ntop(address.family, address.bytes, buffer, INET6_ADDRSTRLEN);
+    return buffer + strlen(buffer);
+}
+
+// Function for formatting port to buffer, returns position after it
+
+static char* appendPort(char* buffer, uint16_t port) {
+    return std::to_chars(buffer, buffer + 5, port).ptr;
+}
+
+// Methods for creating sinks
+
+bool ResultSink::isFormat(const std::string& format) {
+    return format == "text" || format == "ndjson" || format == "csv" || format == "binary";
+}
+
+std::unique_ptr<ResultSink> ResultSink::create(const std::string& format) {
+    if (format == "text") return std::make_unique<TextResultSink>();
+    if (format == "ndjson") return std::make_unique<NdjsonResultSink>();
+    if (format == "csv") return std::make_unique<CsvResultSink>();
+    if (format == "binary") return std::make_unique<BinaryResultSink>();
+    throw std::invalid_argument("");
+}
+
+// Text format -> 192.0.2.1 80 tcp open
+
+size_t TextResultSink::format(const IpAddress& dst, uint16_t port, portState state, char* buffer) {
+    char* position = appendAddress(buffer, dst);
+    *position++ = ' ';
+    position = appendPort(position, port);
+    *position++ = ' ';
+    const char* text = PortState::text(state);
+    position = appendText(position, text, strlen(text));
+    *position++ = '\n';
+    return position - buffer;
+}
+
+// NDJSON format -> {"ip":"192.0.2.1","port":80,"protocol":"tcp","state":"open"}
+
+size_t NdjsonResultSink::format(const IpAddress& dst, uint16_t port, portState state, char* buffer) {
+    const char* protocol = PortState::protocol(state);
+    const char* name = PortState::name(state);
+
+    char* position = appendText(buffer, "{\"ip\":\"", 7);
+    position = appendAddress(position, dst);
+    position = appendText(position, "\",\"port\":", 9);
+    position = appendPort(position, port);
+    position = appendText(position, ",\"protocol\":\"", 13);
+    position = appendText(position, protocol, strlen(protocol));
+    position = appendText(position, "\",\"state\":\"", 11);
+    position = appendText(position, name, strlen(name));
+    position = appendText(position, "\"}\n", 3);
+    return position - buffer;
+}
+
+// CSV format -> 192.0.2.1,80,tcp,open
+
+size_t CsvResultSink::header(char* buffer) {
+    const char header[] = "ip,port,protocol,state\n";
+    memcpy(buffer, header, sizeof(header) - 1);
+    return sizeof(header) - 1;
+}
+
+size_t CsvResultSink::format(const IpAddress& dst, uint16_t port, portState state, char* buffer) {
+    const char* protocol = PortState::protocol(state);
+    const char* name = PortState::name(state);
+
+    char* position = appendAddress(buffer, dst);
+    *position++ = ',';
+    position = appendPort(position, port);
+    *position++ = ',';
+    position = appendText(position, protocol, strlen(protocol));
+    *position++ = ',';
+    position = appendText(position, name, strlen(name));
+    *position++ = '\n';
+    return position - buffer;
+}
+
+// Binary format -> magic, version and fixed records
+
+size_t BinaryResultSink::header(char* buffer) {
+    uint32_t version = htonl(RESULT_BINARY_VERSION);
+    memcpy(buffer, RESULT_BINARY_MAGIC, 4);
+    memcpy(buffer + 4, &version, 4);
+    return 8;
+}
+
+size_t BinaryResultSink::format(const IpAddress& dst, uint16_t port, portState state, char* buffer) {
+    BinaryResultRecord record;
+    memset(&record, 0, sizeof(record));
+    record.ipVersion = dst.family == AF_INET ? 4 : 6;
+    record.protocol = PortState::isUdp(state) ? IPPROTO_UDP : IPPROTO_TCP;
+    record.state = state & PORT_STATE_MASK;
+    record.port = htons(port);
+    memcpy(record.address, dst.bytes, dst.length());
+    memcpy(buffer, &record, sizeof(record));
+    return sizeof(record);
+}
+
+bool BinaryResultSink::parse(const char* buffer, IpAddress& dst, uint16_t& port, portState& state) {
+    BinaryResultRecord record;
+    memcpy(&record, buffer, sizeof(record));
+    if ((record.ipVersion != 4 && record.ipVersion != 6) || record.state > PORT_STATE_MASK) return false;
+    if (record.protocol != IPPROTO_TCP && record.protocol != IPPROTO_UDP) return false;
+
+    dst = IpAddress();
+    dst.family = record.ipVersion == 4 ? AF_INET : AF_INET6;
+    memcpy(dst.bytes, record.address, dst.length());
+    port = ntohs(record.port);
+    return PortState::decode((record.protocol == IPPROTO_UDP ? PORT_STATE_UDP : 0) | record.state, state);
+}
+
+// Constructor, header of format is the first bytes of output
+
+ResultWriter::ResultWriter(std::unique_ptr<ResultSink> sink, int fd) : sink(std::move(sink)), fd(fd) {
+    this->active.reserve(RESULT_BUFFER_SIZE);
+    this->spare.reserve(RESULT_BUFFER_SIZE);
+    char header[RESULT_RECORD_MAX];
+    size_t length = this->sink->header(header);
+    this->active.insert(this->active.end(), header, header + length);
+    this->writer = std::thread(&ResultWriter::writeLoop, this);
+}
+
+// Destructor, error of writing can not be reported from destructor
+
+ResultWriter::~ResultWriter() {
+    try {
+        this->close();
+    } catch (...) {
+    }
+}
+
+// Method for adding result, record is formatted before lock
+
+void ResultWriter::write(const IpAddress& dst, uint16_t port, portState state) {
+    char record[RESULT_RECORD_MAX];
+    size_t length = this->sink->format(dst, port, state, record);
+    this->append(record, length);
+}
+
+// Method for appending bytes to buffer
+
+void ResultWriter::append(const char* data, size_t length) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if (this->failed) throw std::runtime_error("Could not write results!");
+    // Full buffer waits until writer thread takes it
+    this->drained.wait(lock, [this, length]() { return this->failed || this->active.size() + length <= RESULT_BUFFER_SIZE; });
+    this->active.insert(this->active.end(), data, data + length);
+    // Writer thread is woken up only when buffer is half full, otherwise it writes after interval
+    if (this->active.size() >= RESULT_BUFFER_SIZE / 2) this->ready.notify_one();
+}
+
+// Loop of writer thread, buffers are swapped under lock and written without it
+
+void ResultWriter::writeLoop() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true) {
+        this->ready.wait_for(lock, std::chrono::milliseconds(RESULT_FLUSH_INTERVAL), [this]() { return this->stopping || this->active.size() >= RESULT_BUFFER_SIZE / 2; });
+        bool stop = this->stopping;
+        this->spare.swap(this->active);
+        this->drained.notify_all();
+        lock.unlock();
+
+        // Write whole buffer, write can be partial
+        bool error = !SystemUtils::writeAll(this->fd, this->spare.data(), this->spare.size());
+        this->spare.clear();
+
+        lock.lock();
+        if (error) {
+            this->failed = true;
+            this->drained.notify_all();
+            return;
+        }
+        // Results added during last write are written before end
+        if (stop && this->active.empty()) return;
+    }
+}
+
+// Method for writing rest of results and stopping writer thread
+
+void ResultWriter::close() {
+    if (this->closed) return;
+    this->closed = true;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->ready.notify_one();
+    this->writer.join();
+    if (this->failed) throw std::runtime_error("Could not write results!");
+}
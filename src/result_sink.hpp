@@ -0,0 +1,209 @@
+/**
+ * @file result_sink.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Library for formats of results and buffered writer of results with background thread
+ */
+
+#ifndef RESULT_SINK_HPP
+#define RESULT_SINK_HPP // RESULT_SINK_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "ip_address.hpp"
+#include "port_state.hpp"
+
+// Constants for max length of one formatted record
+#define RESULT_RECORD_MAX 128
+// Constants for size of buffer of results, producer waits for writer thread when buffer is full
+#define RESULT_BUFFER_SIZE (1024 * 1024)
+// Constants for max time of results in buffer before they are written (ms)
+#define RESULT_FLUSH_INTERVAL 100
+// Constants for magic of binary format and its version
+#define RESULT_BINARY_MAGIC "IPKR"
+#define RESULT_BINARY_VERSION 1
+
+/**
+ * @brief Struct for record of binary format, all fields are in network byte order
+ */
+struct BinaryResultRecord {
+    // 4 for IPv4, 6 for IPv6
+    uint8_t ipVersion;
+    // IPPROTO_TCP or IPPROTO_UDP
+    uint8_t protocol;
+    // State of port -> code of state without protocol bit (PORT_STATE_MASK)
+    uint8_t state;
+    uint8_t reserved;
+    // Scanned port
+    uint16_t port;
+    uint16_t reserved2;
+    // Scanned address, IPv4 address uses first 4 bytes
+    uint8_t address[16];
+};
+
+/**
+ * @class ResultSink
+ * @brief Interface of format of results
+ *
+ * Sink only formats result into buffer, it does no output, so formatting does not depend on destination of output.
+ * State of result is code of state with protocol (portState), its text is made by PortState.
+ * Numbers are formatted by std::to_chars and addresses by inet_ntop, there are no iostreams and no allocations.
+ */
+class ResultSink{
+    public:
+        virtual ~ResultSink() = default;
+        /**
+         * @brief Method for formatting header of output
+         *
+         * @param buffer - buffer of at least RESULT_RECORD_MAX bytes
+         * @return length of header, 0 if format has no header
+         */
+        virtual size_t header(char* buffer) { (void)buffer; return 0; }
+        /**
+         * @brief Method for formatting one result
+         *
+         * @param dst - scanned address
+         * @param port - scanned port
+         * @param state - state of port with protocol
+         * @param buffer - buffer of at least RESULT_RECORD_MAX bytes
+         * @return length of record
+         */
+        virtual size_t format(const IpAddress& dst, uint16_t port, portState state, char* buffer) = 0;
+        /**
+         * @brief Method for creating sink of format
+         *
+         * @param format - "text", "ndjson", "csv" or "binary"
+         * @return sink of format
+         *
+         * @throws std::invalid_argument if the format is unknown
+         */
+        static std::unique_ptr<ResultSink> create(const std::string& format);
+        /**
+         * @brief Method for checking name of format
+         *
+         * @param format - name of format
+         * @return true if format is known
+         */
+        static bool isFormat(const std::string& format);
+};
+
+/**
+ * @brief Sink of text format -> "<address> <port> <protocol> <state>" per line, the default output of program
+ */
+class TextResultSink : public ResultSink {
+    public:
+        size_t format(const IpAddress& dst, uint16_t port, portState state, char* buffer) override;
+};
+
+/**
+ * @brief Sink of NDJSON format -> one JSON object with keys ip, port, protocol and state per line
+ */
+class NdjsonResultSink : public ResultSink {
+    public:
+        size_t format(const IpAddress& dst, uint16_t port, portState state, char* buffer) override;
+};
+
+/**
+ * @brief Sink of CSV format -> header line and line "ip,port,protocol,state" per result
+ */
+class CsvResultSink : public ResultSink {
+    public:
+        size_t header(char* buffer) override;
+        size_t format(const IpAddress& dst, uint16_t port, portState state, char* buffer) override;
+};
+
+/**
+ * @brief Sink of binary format -> magic and version, then BinaryResultRecord per result
+ */
+class BinaryResultSink : public ResultSink {
+    public:
+        size_t header(char* buffer) override;
+        size_t format(const IpAddress& dst, uint16_t port, portState state, char* buffer) override;
+        /**
+         * @brief Method for parsing one record of binary format
+         *
+         * @param buffer - record of sizeof(BinaryResultRecord) bytes
+         * @param dst - scanned address
+         * @param port - scanned port
+         * @param state - state of port with protocol
+         * @return false if record is malformed
+         */
+        static bool parse(const char* buffer, IpAddress& dst, uint16_t& port, portState& state);
+};
+
+/**
+ * @class ResultWriter
+ * @brief Class for buffered writing of results by background thread
+ *
+ * Scanner formats result by sink into buffer and continues, writer thread swaps buffer for empty one and writes it
+ * to descriptor when buffer is half full or after RESULT_FLUSH_INTERVAL, so there is no flush and no system call per result.
+ * Results are written in the order in which they were added, all results are written at latest by close.
+ */
+class ResultWriter{
+    public:
+        /**
+         * @brief Construct of ResultWriter, starts writer thread
+         *
+         * @param sink - format of results
+         * @param fd - descriptor to which results are written
+         */
+        ResultWriter(std::unique_ptr<ResultSink> sink, int fd);
+        /**
+         * @brief Destructor, writes rest of results and stops writer thread
+         */
+        ~ResultWriter();
+        ResultWriter(const ResultWriter&) = delete;
+        ResultWriter& operator=(const ResultWriter&) = delete;
+        /**
+         * @brief Method for adding result
+         *
+         * @param dst - scanned address
+         * @param port - scanned port
+         * @param state - state of port with protocol
+         *
+         * @throws std::runtime_error if writer thread failed to write results
+         */
+        void write(const IpAddress& dst, uint16_t port, portState state);
+        /**
+         * @brief Method for writing rest of results and stopping writer thread
+         *
+         * @throws std::runtime_error if results could not be written
+         */
+        void close();
+
+    private:
+        /**
+         * @brief Loop of writer thread
+         */
+        void writeLoop();
+        /**
+         * @brief Method for appending bytes to buffer, waits for writer thread when buffer is full
+         *
+         * @param data - bytes to append
+         * @param length - count of bytes
+         */
+        void append(const char* data, size_t length);
+        // Format of results and descriptor of output
+        std::unique_ptr<ResultSink> sink;
+        int fd;
+        // Buffer filled by scanner and buffer written by writer thread
+        std::vector<char> active;
+        std::vector<char> spare;
+        // Synchronization of buffers
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::condition_variable drained;
+        // Flags for end of writing and failed write
+        bool stopping = false;
+        bool failed = false;
+        bool closed = false;
+        std::thread writer;
+};
+
+#endif // RESULT_SINK_HPP
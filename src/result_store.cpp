@@ -0,0 +1,244 @@
+/**
+ * @file result_store.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of append-only columnar store of results and its memory mapped reader
+ */
+
+#include "result_store.hpp"
+#include "system_utils.hpp"
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <netinet/in.h>
+
+// Function for rounding length up to alignment of columns
+
+static size_t align(size_t length) {
+    return (length + STORE_ALIGNMENT - 1) & ~(size_t)(STORE_ALIGNMENT - 1);
+}
+
+// Function for comparing hosts, by version and then by bytes of address
+
+static int compareHosts(uint8_t versionA, const uint8_t* addressA, uint8_t versionB, const uint8_t* addressB) {
+    if (versionA != versionB) return versionA < versionB ? -1 : 1;
+    return memcmp(addressA, addressB, 16);
+}
+
+// Constructor, every scan starts new store
+
+ResultStore::ResultStore(const std::string& path) {
+    this->fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (this->fd == -1) throw std::runtime_error("Could not create result store!");
+    StoreFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, STORE_MAGIC, 4);
+    header.version = STORE_VERSION;
+    header.byteOrder = STORE_BYTE_ORDER;
+    if (!SystemUtils::writeAll(this->fd, (const char*)&header, sizeof(header))) {
+        ::close(this->fd);
+        throw std::runtime_error("Could not write result store!");
+    }
+    this->rows.reserve(STORE_SEGMENT_ROWS);
+}
+
+// Destructor, error of writing can not be reported from destructor
+
+ResultStore::~ResultStore() {
+    try {
+        this->close();
+    } catch (...) {
+    }
+}
+
+// Method for adding result, full segment is written
+
+void ResultStore::append(const IpAddress& dst, uint16_t port, portState state, uint32_t rtt, bool changed) {
+    this->rows.push_back(Row{dst, port, (uint8_t)(state | (changed ? STORE_CHANGED : 0)), rtt});
+    if (this->rows.size() == STORE_SEGMENT_ROWS) this->flush();
+}
+
+// Method for writing rows as segment
+
+void ResultStore::flush() {
+    if (this->rows.empty()) return;
+    // Rows are grouped by host, results of host keep their order
+    std::stable_sort(this->rows.begin(), this->rows.end(), [](const Row& a, const Row& b) {
+        return compareHosts(a.dst.family == AF_INET ? 4 : 6, a.dst.bytes, b.dst.family == AF_INET ? 4 : 6, b.dst.bytes) < 0;
+    });
+
+    // Index of hosts, every host has continuous block of rows
+    std::vector<StoreHostEntry> hosts;
+    for (uint32_t row = 0; row < this->rows.size(); row++) {
+        const IpAddress& dst = this->rows[row].dst;
+        if (hosts.empty() || !(this->rows[hosts.back().firstRow].dst == dst)) {
+            StoreHostEntry entry;
+            memset(&entry, 0, sizeof(entry));
+            memcpy(entry.address, dst.bytes, 16);
+            entry.firstRow = row;
+            entry.ipVersion = dst.family == AF_INET ? 4 : 6;
+            hosts.push_back(entry);
+        }
+        hosts.back().rowCount++;
+    }
+
+    // Offsets of parts of segment
+    size_t count = this->rows.size();
+    size_t hostsOffset = align(sizeof(StoreSegmentHeader));
+    size_t hostColumn = hostsOffset + align(hosts.size() * sizeof(StoreHostEntry));
+    size_t portColumn = hostColumn + align(count * sizeof(uint32_t));
+    size_t stateColumn = portColumn + align(count * sizeof(uint16_t));
+    size_t rttColumn = stateColumn + align(count * sizeof(uint8_t));
+    size_t length = rttColumn + align(count * sizeof(uint32_t));
+
+    // Build segment in buffer, padding is zero
+    this->segment.assign(length, 0);
+    StoreSegmentHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, STORE_SEGMENT_MAGIC, 4);
+    header.rows = (uint32_t)count;
+    header.hosts = (uint32_t)hosts.size();
+    header.length = length;
+    memcpy(this->segment.data(), &header, sizeof(header));
+    memcpy(this->segment.data() + hostsOffset, hosts.data(), hosts.size() * sizeof(StoreHostEntry));
+    uint32_t* hostIds = (uint32_t*)(this->segment.data() + hostColumn);
+    uint16_t* ports = (uint16_t*)(this->segment.data() + portColumn);
+    uint8_t* states = (uint8_t*)(this->segment.data() + stateColumn);
+    uint32_t* rtts = (uint32_t*)(this->segment.data() + rttColumn);
+    for (uint32_t host = 0; host < hosts.size(); host++) {
+        for (uint32_t row = hosts[host].firstRow; row < hosts[host].firstRow + hosts[host].rowCount; row++) {
+            hostIds[row] = host;
+            ports[row] = this->rows[row].port;
+            states[row] = this->rows[row].state;
+            rtts[row] = this->rows[row].rtt;
+        }
+    }
+
+    // Segment is appended by one write
+    if (!SystemUtils::writeAll(this->fd, this->segment.data(), this->segment.size())) throw std::runtime_error("Could not write result store!");
+    this->rows.clear();
+}
+
+// Method for writing last segment and closing store
+
+void ResultStore::close() {
+    if (this->fd == -1) return;
+    try {
+        this->flush();
+    } catch (...) {
+        ::close(this->fd);
+        this->fd = -1;
+        throw;
+    }
+    if (::close(this->fd) == -1) {
+        this->fd = -1;
+        throw std::runtime_error("Could not write result store!");
+    }
+    this->fd = -1;
+}
+
+// Constructor of reader, whole store is mapped
+
+ResultStoreReader::ResultStoreReader(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) throw std::runtime_error("Could not open result store!");
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        throw std::runtime_error("Could not open result store!");
+    }
+    this->length = info.st_size;
+
+    // Check header of store
+    StoreFileHeader header;
+    if (this->length < sizeof(header)) {
+        close(fd);
+        throw std::runtime_error("File is not result store!");
+    }
+    void* mapped = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) throw std::runtime_error("Could not map result store!");
+    this->data = (const char*)mapped;
+    memcpy(&header, this->data, sizeof(header));
+    if (memcmp(header.magic, STORE_MAGIC, 4) != 0 || header.version != STORE_VERSION || header.byteOrder != STORE_BYTE_ORDER) {
+        munmap(mapped, this->length);
+        throw std::runtime_error("File is not result store!");
+    }
+    // Columns are read from start to end
+    madvise(mapped, this->length, MADV_SEQUENTIAL);
+}
+
+// Destructor of reader
+
+ResultStoreReader::~ResultStoreReader() {
+    munmap((void*)this->data, this->length);
+}
+
+// Method for finding rows matching query
+
+uint64_t ResultStoreReader::query(const StoreQuery& query, const std::function<void(const IpAddress&, uint16_t, portState, uint32_t, bool)>& callback) const {
+    uint64_t matched = 0;
+    uint8_t hostVersion = query.host.family == AF_INET ? 4 : 6;
+    size_t offset = sizeof(StoreFileHeader);
+
+    // Segments follow each other, segment cut by crash at end of file is skipped
+    while (offset + sizeof(StoreSegmentHeader) <= this->length) {
+        StoreSegmentHeader header;
+        memcpy(&header, this->data + offset, sizeof(header));
+        if (memcmp(header.magic, STORE_SEGMENT_MAGIC, 4) != 0) throw std::runtime_error("Result store is malformed!");
+        if (header.length > this->length - offset) break;
+
+        // Columns of segment, their length must give length of segment
+        size_t hostsOffset = offset + align(sizeof(StoreSegmentHeader));
+        size_t hostColumn = hostsOffset + align((size_t)header.hosts * sizeof(StoreHostEntry));
+        size_t portColumn = hostColumn + align((size_t)header.rows * sizeof(uint32_t));
+        size_t stateColumn = portColumn + align((size_t)header.rows * sizeof(uint16_t));
+        size_t rttColumn = stateColumn + align((size_t)header.rows * sizeof(uint8_t));
+        if (rttColumn + align((size_t)header.rows * sizeof(uint32_t)) != offset + header.length) throw std::runtime_error("Result store is malformed!");
+        const StoreHostEntry* hosts = (const StoreHostEntry*)(this->data + hostsOffset);
+        const uint32_t* hostIds = (const uint32_t*)(this->data + hostColumn);
+        const uint16_t* ports = (const uint16_t*)(this->data + portColumn);
+        const uint8_t* states = (const uint8_t*)(this->data + stateColumn);
+        const uint32_t* rtts = (const uint32_t*)(this->data + rttColumn);
+
+        // Rows of host are found in index, other queries read all rows
+        uint32_t first = 0;
+        uint32_t last = header.rows;
+        if (query.hasHost) {
+            const StoreHostEntry* host = std::lower_bound(hosts, hosts + header.hosts, query.host, [hostVersion](const StoreHostEntry& entry, const IpAddress& address) {
+                return compareHosts(entry.ipVersion, entry.address, hostVersion, address.bytes) < 0;
+            });
+            if (host == hosts + header.hosts || compareHosts(host->ipVersion, host->address, hostVersion, query.host.bytes) != 0) {
+                offset += header.length;
+                continue;
+            }
+            first = host->firstRow;
+            last = host->firstRow + host->rowCount;
+        }
+
+        for (uint32_t row = first; row < last; row++) {
+            // Filter by columns, host is read only for matching row
+            if (query.port != -1 && ports[row] != query.port) continue;
+            portState state;
+            bool changed = (states[row] & STORE_CHANGED) != 0;
+            if (hostIds[row] >= header.hosts || !PortState::decode(states[row] & ~STORE_CHANGED, state)) throw std::runtime_error("Result store is malformed!");
+            if (query.changed && !changed) continue;
+            if (query.protocol != 0 && (query.protocol == IPPROTO_UDP) != PortState::isUdp(state)) continue;
+            if (query.state != -1 && (state & PORT_STATE_MASK) != query.state) continue;
+
+            const StoreHostEntry& host = hosts[hostIds[row]];
+            IpAddress dst;
+            dst.family = host.ipVersion == 4 ? AF_INET : AF_INET6;
+            memcpy(dst.bytes, host.address, dst.length());
+            callback(dst, ports[row], state, rtts[row], changed);
+            matched++;
+        }
+        offset += header.length;
+    }
+    return matched;
+}
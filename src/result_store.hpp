@@ -0,0 +1,202 @@
+/**
+ * @file result_store.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Library for append-only columnar store of results and its memory mapped reader
+ */
+
+#ifndef RESULT_STORE_HPP
+#define RESULT_STORE_HPP // RESULT_STORE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <functional>
+#include "ip_address.hpp"
+#include "port_state.hpp"
+
+// Constants for magic and version of store file and magic of segment
+#define STORE_MAGIC "IPKC"
+#define STORE_VERSION 1
+#define STORE_SEGMENT_MAGIC "SEGM"
+// Constants for byte order mark, columns are in byte order of machine which wrote them
+#define STORE_BYTE_ORDER 0x01020304
+// Constants for max count of rows of one segment
+#define STORE_SEGMENT_ROWS 65536
+// Constants for alignment of columns in segment
+#define STORE_ALIGNMENT 8
+// Constants for flag of state column above code of state (portState), state differed from baseline of scan
+#define STORE_CHANGED 8
+
+/**
+ * @brief Struct for header of store file
+ */
+struct StoreFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t reserved;
+};
+
+/**
+ * @brief Struct for header of segment, columns follow it
+ *
+ * Segment -> header, hosts (StoreHostEntry), host column (uint32_t), port column (uint16_t), state column (uint8_t, state code with flags)
+ * and round trip time column (uint32_t, us, 0 if unknown), every part is padded to STORE_ALIGNMENT.
+ */
+struct StoreSegmentHeader {
+    char magic[4];
+    // Count of rows and hosts of segment
+    uint32_t rows;
+    uint32_t hosts;
+    uint32_t reserved;
+    // Length of whole segment with header, segment cut by crash is longer than rest of file
+    uint64_t length;
+};
+
+/**
+ * @brief Struct for host of segment, it is the per-host index of segment
+ *
+ * Hosts are sorted by version and address and rows of segment are grouped by host, so rows of host are
+ * firstRow .. firstRow + rowCount - 1.
+ */
+struct StoreHostEntry {
+    // Address, IPv4 address uses first 4 bytes
+    uint8_t address[16];
+    // First row of host and count of its rows
+    uint32_t firstRow;
+    uint32_t rowCount;
+    // 4 for IPv4, 6 for IPv6
+    uint8_t ipVersion;
+    uint8_t reserved[7];
+};
+
+/**
+ * @brief Struct for filter of query, unset parts match every row
+ */
+struct StoreQuery {
+    // Path of store
+    std::string path;
+    // Host of rows
+    bool hasHost = false;
+    IpAddress host;
+    // Port, -1 for every port
+    int port = -1;
+    // Protocol (IPPROTO_TCP, IPPROTO_UDP), 0 for both
+    int protocol = 0;
+    // State without protocol (code of state & PORT_STATE_MASK), -1 for every state
+    int state = -1;
+    // Only results which differed from baseline of scan
+    bool changed = false;
+    // Format of printed rows
+    std::string format;
+};
+
+/**
+ * @class ResultStore
+ * @brief Class for writing results to columnar store
+ *
+ * Results are collected to segment of at most STORE_SEGMENT_ROWS rows. Full segment is sorted by host, its hosts
+ * are written as index and its fields as separate compact columns, then it is appended to file by one write.
+ * Written segment is never changed, so store can be read while it is written and crash loses only last segment.
+ */
+class ResultStore{
+    public:
+        /**
+         * @brief Construct of ResultStore, creates new store
+         *
+         * @param path - path of store
+         *
+         * @throws std::runtime_error if store cannot be created
+         */
+        ResultStore(const std::string& path);
+        /**
+         * @brief Destructor, writes last segment
+         */
+        ~ResultStore();
+        ResultStore(const ResultStore&) = delete;
+        ResultStore& operator=(const ResultStore&) = delete;
+        /**
+         * @brief Method for adding result
+         *
+         * @param dst - scanned address
+         * @param port - scanned port
+         * @param state - state of port with protocol
+         * @param rtt - round trip time of reply (us), 0 if unknown
+         * @param changed - state differed from baseline of scan
+         *
+         * @throws std::runtime_error if full segment cannot be written
+         */
+        void append(const IpAddress& dst, uint16_t port, portState state, uint32_t rtt, bool changed = false);
+        /**
+         * @brief Method for writing last segment and closing store
+         *
+         * @throws std::runtime_error if segment cannot be written
+         */
+        void close();
+
+    private:
+        /**
+         * @brief Struct for result waiting in segment
+         */
+        struct Row {
+            IpAddress dst;
+            uint16_t port;
+            uint8_t state;
+            uint32_t rtt;
+        };
+        /**
+         * @brief Method for writing collected rows as segment
+         *
+         * @throws std::runtime_error if segment cannot be written
+         */
+        void flush();
+        // Descriptor of store
+        int fd = -1;
+        // Rows of current segment and buffer of formatted segment
+        std::vector<Row> rows;
+        std::vector<char> segment;
+};
+
+/**
+ * @class ResultStoreReader
+ * @brief Class for reading store by memory mapping
+ *
+ * File is mapped once and columns of segments are read in place, nothing is parsed or copied. Query of host
+ * finds host in sorted index of every segment by binary search and reads only its rows, other queries scan columns.
+ */
+class ResultStoreReader{
+    public:
+        /**
+         * @brief Construct of ResultStoreReader, maps store
+         *
+         * @param path - path of store
+         *
+         * @throws std::runtime_error if store cannot be mapped or is not store
+         */
+        ResultStoreReader(const std::string& path);
+        /**
+         * @brief Destructor, unmaps store
+         */
+        ~ResultStoreReader();
+        ResultStoreReader(const ResultStoreReader&) = delete;
+        ResultStoreReader& operator=(const ResultStoreReader&) = delete;
+        /**
+         * @brief Method for finding rows matching query
+         *
+         * @param query - filter of rows
+         * @param callback - called for every matching row with address, port, state with protocol, round trip time and flag of change
+         * @return count of matching rows
+         *
+         * @throws std::runtime_error if segment is malformed
+         */
+        uint64_t query(const StoreQuery& query, const std::function<void(const IpAddress&, uint16_t, portState, uint32_t, bool)>& callback) const;
+
+    private:
+        // Mapped file and its length
+        const char* data = nullptr;
+        size_t length = 0;
+};
+
+#endif // RESULT_STORE_HPP
@@ -0,0 +1,41 @@
+/**
+ * @file rtt_estimator.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of estimator of round trip time of one target
+ */
+
+#include "rtt_estimator.hpp"
+#include <algorithm>
+
+// Constructor
+
+RttEstimator::RttEstimator(int maxTimeout) : srtt(0), rttvar(0), rto(maxTimeout), maxTimeout(maxTimeout), measured(false) {}
+
+// Method for adding measured round trip time
+
+void RttEstimator::sample(uint64_t rtt) {
+    if (!this->measured) {
+        // First sample -> SRTT = R, RTTVAR = R / 2
+        this->srtt = rtt;
+        this->rttvar = rtt / 2;
+        this->measured = true;
+    } else {
+        // RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|, SRTT = 7/8 SRTT + 1/8 R
+        uint64_t difference = this->srtt > rtt ? this->srtt - rtt : rtt - this->srtt;
+        this->rttvar = (3 * this->rttvar + difference) / 4;
+        this->srtt = (7 * this->srtt + rtt) / 8;
+    }
+    // RTO = SRTT + max(G, 4 * RTTVAR), rounded up to milliseconds and bounded by --wait
+    uint64_t rto = this->srtt + std::max<uint64_t>(RTT_CLOCK_GRANULARITY, 4 * this->rttvar);
+    uint64_t rtoMs = (rto + 999) / 1000;
+    this->rto = (int)std::min<uint64_t>(std::max<uint64_t>(rtoMs, RTT_MIN_TIMEOUT), this->maxTimeout);
+}
+
+// Method for getting timeout of probe
+
+int RttEstimator::timeout(int retries) const {
+    // Timeout is doubled for every retransmission
+    int64_t timeout = (int64_t)this->rto << std::min(retries, 16);
+    return (int)std::min<int64_t>(timeout, this->maxTimeout);
+}
@@ -0,0 +1,62 @@
+/**
+ * @file rtt_estimator.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for estimator of round trip time of one target
+ */
+
+#ifndef RTT_ESTIMATOR_HPP
+#define RTT_ESTIMATOR_HPP // RTT_ESTIMATOR_HPP
+
+#include <cstdint>
+
+// Constants for lower bound of timeout derived from round trip time (ms)
+#define RTT_MIN_TIMEOUT 50
+// Constants for granularity of clock used for waiting, epoll waits in milliseconds (us)
+#define RTT_CLOCK_GRANULARITY 1000
+
+/**
+ * @class RttEstimator
+ * @brief Class for estimating timeout of probes of one target
+ *
+ * Estimator keeps smoothed round trip time (SRTT) and its variation (RTTVAR) the way TCP does (RFC 6298),
+ * timeout is SRTT + max(G, 4 * RTTVAR) and it is doubled for every retransmission.
+ * Until first sample is measured and as upper bound, timeout given by --wait is used.
+ */
+class RttEstimator{
+    public:
+        /**
+         * @brief Construct of RttEstimator
+         *
+         * @param maxTimeout - upper bound of timeout (ms)
+         */
+        RttEstimator(int maxTimeout);
+        /**
+         * @brief Method for adding measured round trip time
+         *
+         * Only replies to probes which were not retransmitted can be measured (Karn's algorithm).
+         *
+         * @param rtt - measured round trip time (us)
+         */
+        void sample(uint64_t rtt);
+        /**
+         * @brief Method for getting timeout of probe
+         *
+         * @param retries - count of retransmissions of probe
+         * @return timeout (ms)
+         */
+        int timeout(int retries) const;
+
+    private:
+        // Smoothed round trip time and its variation (us)
+        uint64_t srtt;
+        uint64_t rttvar;
+        // Current timeout without backoff (ms)
+        int rto;
+        // Upper bound of timeout (ms)
+        int maxTimeout;
+        // Flag for measured first sample
+        bool measured;
+};
+
+#endif // RTT_ESTIMATOR_HPP
@@ -0,0 +1,106 @@
+/**
+ * @file rx_ring.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of memory mapped receive ring of packet socket
+ */
+
+#include "rx_ring.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+
+// Constructor
+
+RxRing::RxRing(const std::string& interface, uint16_t protocol) : fdSock(-1), ring(nullptr), ringSize(0), block(0), remaining(0), position(nullptr) {
+    // Create packet socket, link layer header is removed by kernel
+    this->fdSock = socket(AF_PACKET, SOCK_DGRAM, htons(protocol));
+    if (this->fdSock == -1) throw std::runtime_error("Could not create packet socket!");
+
+    // Set version of ring and its geometry
+    int version = TPACKET_V3;
+    struct tpacket_req3 request;
+    memset(&request, 0, sizeof(request));
+    request.tp_block_size = RX_RING_BLOCK_SIZE;
+    request.tp_block_nr = RX_RING_BLOCK_COUNT;
+    request.tp_frame_size = RX_RING_FRAME_SIZE;
+    request.tp_frame_nr = (RX_RING_BLOCK_SIZE / RX_RING_FRAME_SIZE) * RX_RING_BLOCK_COUNT;
+    request.tp_retire_blk_tov = RX_RING_BLOCK_TIMEOUT;
+    if (setsockopt(this->fdSock, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) == -1 ||
+        setsockopt(this->fdSock, SOL_PACKET, PACKET_RX_RING, &request, sizeof(request)) == -1) {
+        close(this->fdSock);
+        throw std::runtime_error("Could not set packet ring!");
+    }
+
+    // Map ring to memory of process
+    this->ringSize = (size_t)RX_RING_BLOCK_SIZE * RX_RING_BLOCK_COUNT;
+    void* mapped = mmap(nullptr, this->ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, this->fdSock, 0);
+    if (mapped == MAP_FAILED) mapped = mmap(nullptr, this->ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, this->fdSock, 0);
+    if (mapped == MAP_FAILED) {
+        close(this->fdSock);
+        throw std::runtime_error("Could not map packet ring!");
+    }
+    this->ring = (char*)mapped;
+
+    // Bind socket to interface, ring is filled only by packets of this interface
+    struct sockaddr_ll sockAddr;
+    memset(&sockAddr, 0, sizeof(sockAddr));
+    sockAddr.sll_family = AF_PACKET;
+    sockAddr.sll_protocol = htons(protocol);
+    sockAddr.sll_ifindex = if_nametoindex(interface.c_str());
+    if (sockAddr.sll_ifindex == 0 || bind(this->fdSock, (struct sockaddr*)&sockAddr, sizeof(sockAddr)) == -1) {
+        munmap(this->ring, this->ringSize);
+        close(this->fdSock);
+        throw std::runtime_error("Could not bind packet socket!");
+    }
+}
+
+// Destructor
+
+RxRing::~RxRing() {
+    munmap(this->ring, this->ringSize);
+    close(this->fdSock);
+}
+
+// Method for returning current block to kernel and moving to next one
+
+void RxRing::releaseBlock() {
+    struct tpacket_block_desc* desc = (struct tpacket_block_desc*)(this->ring + this->block * RX_RING_BLOCK_SIZE);
+    __atomic_store_n(&desc->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    this->block = (this->block + 1) % RX_RING_BLOCK_COUNT;
+    this->position = nullptr;
+}
+
+// Method for getting next received packet
+
+bool RxRing::next(const char*& packet, size_t& length) {
+    while (true) {
+        struct tpacket_block_desc* desc = (struct tpacket_block_desc*)(this->ring + this->block * RX_RING_BLOCK_SIZE);
+        // Start reading of block, when kernel handed it over
+        if (this->position == nullptr) {
+            if (!(__atomic_load_n(&desc->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER)) return false;
+            this->remaining = desc->hdr.bh1.num_pkts;
+            this->position = (const char*)desc + desc->hdr.bh1.offset_to_first_pkt;
+        }
+        // All packets of block were read -> block is returned to kernel
+        if (this->remaining == 0) {
+            this->releaseBlock();
+            continue;
+        }
+
+        const struct tpacket3_hdr* header = (const struct tpacket3_hdr*)this->position;
+        const struct sockaddr_ll* linkAddr = (const struct sockaddr_ll*)((const char*)header + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+        this->remaining--;
+        this->position = (const char*)header + header->tp_next_offset;
+        // Packets sent by this host are seen on packet socket too
+        if (linkAddr->sll_pkttype == PACKET_OUTGOING) continue;
+        packet = (const char*)header + header->tp_net;
+        length = header->tp_snaplen - (header->tp_net - header->tp_mac);
+        return true;
+    }
+}
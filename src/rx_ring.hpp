@@ -0,0 +1,82 @@
+/**
+ * @file rx_ring.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for memory mapped receive ring of packet socket
+ */
+
+#ifndef RX_RING_HPP
+#define RX_RING_HPP // RX_RING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Constants for size of one block of ring, kernel hands over whole blocks
+#define RX_RING_BLOCK_SIZE (1 << 20)
+// Constants for count of blocks of ring
+#define RX_RING_BLOCK_COUNT 16
+// Constants for size of frame in block, packets are stored one after another with this alignment
+#define RX_RING_FRAME_SIZE 2048
+// Constants for time after which partially filled block is handed over (ms)
+#define RX_RING_BLOCK_TIMEOUT 1
+
+/**
+ * @class RxRing
+ * @brief Class for TPACKET_V3 receive ring of AF_PACKET socket
+ *
+ * Socket is bound to interface and protocol (ETH_P_IP or ETH_P_IPV6) and it is SOCK_DGRAM, so link layer header is
+ * removed and packets start by network header. Kernel writes packets directly to memory shared with process and
+ * hands over whole blocks, so one wakeup gives all packets of block and packets are parsed in place without copy.
+ */
+class RxRing{
+    public:
+        /**
+         * @brief Construct of RxRing
+         *
+         * @param interface - name of interface
+         * @param protocol - ethernet protocol of received packets in host order
+         *
+         * @throw std::runtime_error if socket or ring cannot be created
+         */
+        RxRing(const std::string& interface, uint16_t protocol);
+        /**
+         * @brief Destructor of RxRing, unmaps ring and closes socket
+         */
+        ~RxRing();
+        RxRing(const RxRing&) = delete;
+        RxRing& operator=(const RxRing&) = delete;
+        /**
+         * @brief Method for getting next received packet
+         *
+         * Packet stays valid until next call, when its block is returned to kernel.
+         *
+         * @param packet - pointer to network header of packet
+         * @param length - length of packet
+         * @return true if packet was received, false if there are no more packets
+         */
+        bool next(const char*& packet, size_t& length);
+        /**
+         * @brief Getter of file descriptor of socket for epoll
+         *
+         * @return file descriptor of socket
+         */
+        int fd() const { return this->fdSock; }
+
+    private:
+        /**
+         * @brief Method for returning current block to kernel and moving to next one
+         */
+        void releaseBlock();
+        // File descriptor of packet socket
+        int fdSock;
+        // Mapped memory of ring
+        char* ring;
+        size_t ringSize;
+        // Current block and position of next packet in it
+        size_t block;
+        uint32_t remaining;
+        const char* position;
+};
+
+#endif // RX_RING_HPP
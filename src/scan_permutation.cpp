@@ -0,0 +1,55 @@
+/**
+ * @file scan_permutation.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of pseudo-random order of probes of target x port space
+ */
+
+#include "scan_permutation.hpp"
+
+// Finalizer of SplitMix64 -> fast mixing of all bits of word
+
+static inline uint64_t mix(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+// Constructor
+
+ScanPermutation::ScanPermutation(uint64_t size, uint64_t seed) : size(size) {
+    // Smallest halves covering size, at least one bit
+    this->halfBits = 1;
+    while (this->halfBits < 32 && (size - 1) >> (2 * this->halfBits)) this->halfBits++;
+    this->halfMask = (1ULL << this->halfBits) - 1;
+    // Keys of rounds are derived from seed by SplitMix64 sequence
+    for (int round = 0; round < FEISTEL_ROUNDS; round++) {
+        seed += 0x9e3779b97f4a7c15ULL;
+        this->keys[round] = mix(seed);
+    }
+}
+
+// Method for encrypting value by Feistel network
+
+uint64_t ScanPermutation::encrypt(uint64_t value) const {
+    uint64_t left = value >> this->halfBits;
+    uint64_t right = value & this->halfMask;
+    for (int round = 0; round < FEISTEL_ROUNDS; round++) {
+        uint64_t next = left ^ (mix(right ^ this->keys[round]) & this->halfMask);
+        left = right;
+        right = next;
+    }
+    return left << this->halfBits | right;
+}
+
+// Method for getting permuted index
+
+uint64_t ScanPermutation::at(uint64_t index) const {
+    if (this->size <= 1) return index;
+    // Values outside of size are walked until they fall inside, the cycle of index always returns to size
+    uint64_t value = this->encrypt(index);
+    while (value >= this->size) value = this->encrypt(value);
+    return value;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file scan_permutation.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for pseudo-random order of probes of target x port space
+ */
+
+#ifndef SCAN_PERMUTATION_HPP
+#define SCAN_PERMUTATION_HPP // SCAN_PERMUTATION_HPP
+
+#include <cstdint>
+
+// Constants for count of rounds of Feistel network
+#define FEISTEL_ROUNDS 4
+
+/**
+ * @class ScanPermutation
+ * @brief Class for seeded pseudo-random permutation of indexes 0 .. size - 1
+ *
+ * Permutation is format-preserving encryption of index -> balanced Feistel network on the smallest even count of bits
+ * covering size, with round keys derived from seed. Result which falls outside of size is encrypted again (cycle walking),
+ * which keeps the mapping bijective on 0 .. size - 1, on average it takes less than four encryptions.
+ * State is only size and round keys, so i-th probe is computed from i and every shard can walk its own indexes.
+ */
+class ScanPermutation{
+    public:
+        /**
+         * @brief Construct of ScanPermutation
+         *
+         * @param size - count of permuted indexes
+         * @param seed - seed of permutation, the same seed gives the same order
+         */
+        ScanPermutation(uint64_t size, uint64_t seed);
+        /**
+         * @brief Method for getting permuted index
+         *
+         * @param index - index from 0 to size - 1
+         * @return index at this position of permutation, every index is returned for exactly one position
+         */
+        uint64_t at(uint64_t index) const;
+
+    private:
+        /**
+         * @brief Method for encrypting value by Feistel network
+         *
+         * @param value - value of 2 * halfBits bits
+         * @return encrypted value of 2 * halfBits bits
+         */
+        uint64_t encrypt(uint64_t value) const;
+        // Count of permuted indexes
+        uint64_t size;
+        // Bits and mask of one half of Feistel network
+        int halfBits;
+        uint64_t halfMask;
+        // Keys of rounds
+        uint64_t keys[FEISTEL_ROUNDS];
+};
+
+#endif // SCAN_PERMUTATION_HPP
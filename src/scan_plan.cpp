@@ -0,0 +1,53 @@
+/**
+ * @file scan_plan.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of immutable plan of scan compiled from scan parameters
+ */
+
+#include "scan_plan.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <net/if.h>
+#include <arpa/inet.h>
+
+// Constructor, all text parameters are converted here once
+
+ScanPlan::ScanPlan(ScannerParams& params) {
+    this->interfaceName = params.getInterfaceName();
+    this->interfaceIndex = if_nametoindex(this->interfaceName.c_str());
+    if (this->interfaceIndex == 0) throw std::runtime_error("Could not find interface!");
+
+    // Interface can have only one of address families
+    this->hasSourceIpv4 = inet_pton(AF_INET, params.getInterfaceIpv4().c_str(), &this->sourceIpv4) == 1;
+    this->hasSourceIpv6 = inet_pton(AF_INET6, params.getInterfaceIpv6().c_str(), &this->sourceIpv6) == 1;
+
+    this->ip4Targets = params.getIp4AddrDest();
+    this->ip6Targets = params.getIp6AddrDest();
+    // Ports were validated by parser, so they fit to 16 bits
+    this->tcpPorts.assign(params.getTcpPorts().begin(), params.getTcpPorts().end());
+    this->udpPorts.assign(params.getUdpPorts().begin(), params.getUdpPorts().end());
+    this->timeout = params.getTimeout();
+}
+
+// Getters of addresses of interface
+
+const struct in_addr& ScanPlan::getSourceIpv4() const {
+    if (!this->hasSourceIpv4) throw std::runtime_error("Interface has no IPv4 address!");
+    return this->sourceIpv4;
+}
+
+const struct in6_addr& ScanPlan::getSourceIpv6() const {
+    if (!this->hasSourceIpv6) throw std::runtime_error("Interface has no IPv6 address!");
+    return this->sourceIpv6;
+}
+
+// Getter of address of interface as binary address
+
+IpAddress ScanPlan::getSourceAddress(sa_family_t family) const {
+    IpAddress address;
+    address.family = family;
+    if (family == AF_INET) memcpy(address.bytes, &this->getSourceIpv4(), 4);
+    else memcpy(address.bytes, &this->getSourceIpv6(), 16);
+    return address;
+}
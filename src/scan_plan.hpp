@@ -0,0 +1,123 @@
+/**
+ * @file scan_plan.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for immutable plan of scan compiled from scan parameters
+ */
+
+#ifndef SCAN_PLAN_HPP
+#define SCAN_PLAN_HPP // SCAN_PLAN_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+#include "scanner_params.hpp"
+#include "target_generator.hpp"
+#include "ip_address.hpp"
+
+/**
+ * @class ScanPlan
+ * @brief Class for immutable plan of scan in binary form
+ *
+ * Plan is compiled once from ScannerParams before scan, addresses of interface are converted to in_addr/in6_addr,
+ * interface is resolved to its index and ports are stored as arrays of 16 bit ports.
+ * Getters return references, so loops of scanners do no string conversion and no copy of container per probe.
+ */
+class ScanPlan{
+    public:
+        /**
+         * @brief Construct of ScanPlan
+         *
+         * @param params - parsed scan parameters
+         *
+         * @throws std::runtime_error if the interface cannot be resolved to its index
+         */
+        ScanPlan(ScannerParams& params);
+        /**
+         * @brief Getter of the name of the interface
+         *
+         * @return name of the interface
+         */
+        const std::string& getInterfaceName() const { return this->interfaceName; }
+        /**
+         * @brief Getter of the index of the interface
+         *
+         * @return index of the interface
+         */
+        unsigned getInterfaceIndex() const { return this->interfaceIndex; }
+        /**
+         * @brief Getter of the IPv4 address of the interface
+         *
+         * @return IPv4 address of the interface in network byte order
+         *
+         * @throws std::runtime_error if the interface has no IPv4 address
+         */
+        const struct in_addr& getSourceIpv4() const;
+        /**
+         * @brief Getter of the IPv6 address of the interface
+         *
+         * @return IPv6 address of the interface
+         *
+         * @throws std::runtime_error if the interface has no IPv6 address
+         */
+        const struct in6_addr& getSourceIpv6() const;
+        /**
+         * @brief Getter of the address of the interface as binary address
+         *
+         * @param family - AF_INET or AF_INET6
+         * @return address of the interface of given family
+         *
+         * @throws std::runtime_error if the interface has no address of given family
+         */
+        IpAddress getSourceAddress(sa_family_t family) const;
+        /**
+         * @brief Getter of the IPv4 targets
+         *
+         * @return generator of IPv4 addresses
+         */
+        const TargetGenerator& getIp4Targets() const { return this->ip4Targets; }
+        /**
+         * @brief Getter of the IPv6 targets
+         *
+         * @return generator of IPv6 addresses
+         */
+        const TargetGenerator& getIp6Targets() const { return this->ip6Targets; }
+        /**
+         * @brief Getter of the TCP ports
+         *
+         * @return array of TCP ports
+         */
+        const std::vector<uint16_t>& getTcpPorts() const { return this->tcpPorts; }
+        /**
+         * @brief Getter of the UDP ports
+         *
+         * @return array of UDP ports
+         */
+        const std::vector<uint16_t>& getUdpPorts() const { return this->udpPorts; }
+        /**
+         * @brief Getter of the timeout
+         *
+         * @return timeout in milliseconds
+         */
+        int getTimeout() const { return this->timeout; }
+
+    private:
+        // Interface and its index
+        std::string interfaceName;
+        unsigned interfaceIndex;
+        // Addresses of interface and flags of their presence
+        struct in_addr sourceIpv4 = {};
+        struct in6_addr sourceIpv6 = {};
+        bool hasSourceIpv4 = false;
+        bool hasSourceIpv6 = false;
+        // Scanned addresses and ports
+        TargetGenerator ip4Targets;
+        TargetGenerator ip6Targets;
+        std::vector<uint16_t> tcpPorts;
+        std::vector<uint16_t> udpPorts;
+        // Timeout in milliseconds
+        int timeout;
+};
+
+#endif // SCAN_PLAN_HPP
@@ -5,10 +5,16 @@
  * @brief Implementation of classes for scanning ports and methods for checksum calculation, creating socket and epoll instance, closing socket and epoll instance.
  */
 #include "scanner.hpp"
-#include "pseudo_headers.hpp"
+#include "probe_template.hpp"
+#include "checksum.hpp"
+#include "rtt_estimator.hpp"
+#include "udp_pacer.hpp"
+#include "socket_filter.hpp"
+#include "system_utils.hpp"
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <cerrno>
 #include <sys/socket.h>
 #include <unistd.h>
 #include <netinet/ip.h>
@@ -17,6 +23,8 @@
 #include <sys/epoll.h>
 #include <fcntl.h>
 #include <chrono>
+#include <thread>
+#include <algorithm>
 #include <netinet/ip6.h>
 #include <netinet/udp.h>
 #include <netinet/ip_icmp.h>
@@ -24,31 +32,16 @@
 
 // Constructor of scanners
 
-Scanner::Scanner(const ScannerParams& scanParams) : scanParams(scanParams) {}
-TcpIpv4Scanner::TcpIpv4Scanner(const ScannerParams& params): Scanner(params) {}
-TcpIpv6Scanner::TcpIpv6Scanner(const ScannerParams& params): Scanner(params) {}
-UdpIpv4Scanner::UdpIpv4Scanner(const ScannerParams& params): Scanner(params) {}
-UdpIpv6Scanner::UdpIpv6Scanner(const ScannerParams& params): Scanner(params) {}
+Scanner::Scanner(const ScannerParams& scanParams) : scanParams(scanParams), plan(this->scanParams), rateLimiter(this->scanParams.getRate(), this->scanParams.getBurst()) {}
+
+template <typename Family, typename Protocol>
+SequentialScanner<Family, Protocol>::SequentialScanner(const ScannerParams& params): Scanner(params) {}
 
 // Method for calculating checksum
 
 unsigned short Scanner::calculateChecksum(const char* pdu, size_t dataLen) {
-    // Checksum
-    unsigned long checksum = 0;
-    // Offset
-    size_t offset = 0;
-    // Calculate checksum
-    while (offset < dataLen-1){
-        checksum += *(unsigned short *)&pdu[offset];
-        // 16 bits -> 2 bytes
-        offset += 2;
-    }
-    // If data length is odd, add last byte
-    if (dataLen%2) checksum += (unsigned char) pdu[offset];
-    // Add carry
-    while (checksum >> 16) checksum = (checksum & 0xFFFF) + (checksum >> 16);
-    // Return checksum
-    return (unsigned short) ~checksum;
+    // Implementation is selected by features of CPU
+    return Checksum::compute(pdu, dataLen);
 }
 
 // Method for creating socket and bind socket, wich socket is independent on IP version and protocol
@@ -58,7 +51,12 @@ int Scanner::createSocket(int ipvType, int protocol) {
     int fdSock = socket(ipvType, SOCK_RAW, protocol);
     if (fdSock == -1) return -1;
     // Bind socket to interface
-    if(setsockopt(fdSock, SOL_SOCKET, SO_BINDTODEVICE, scanParams.getInterfaceName().c_str(), scanParams.getInterfaceName().size()) == -1){
+    if(setsockopt(fdSock, SOL_SOCKET, SO_BINDTODEVICE, this->plan.getInterfaceName().c_str(), this->plan.getInterfaceName().size()) == -1){
+        close(fdSock);
+        return -1;
+    }
+    // Kernel queues only replies to probes, other traffic never wakes up scanner
+    if (!SocketFilter::attach(fdSock, SocketFilter::forRawSocket(ipvType, protocol, DEFAULT_SOURCE_PORT, MAX_SOURCE_PORT))) {
         close(fdSock);
         return -1;
     }
@@ -66,6 +64,17 @@ int Scanner::createSocket(int ipvType, int protocol) {
     return fdSock;
 }
 
+// Method for reporting state of port, result of differential scan is written only when it changed
+
+void Scanner::writeResult(const IpAddress& dst, uint16_t port, portState state, uint32_t rtt) {
+    bool changed = this->baseline == nullptr || this->baseline->changed(dst, port, state);
+    if (this->checkpoint) this->checkpoint->record(dst, port, state);
+    if (this->resultStore) this->resultStore->append(dst, port, state, rtt, this->baseline != nullptr && changed);
+    if (!changed) return;
+    if (this->resultWriter) this->resultWriter->write(dst, port, state);
+    else std::cout << dst.toString() << " " << port << " " << PortState::text(state) << std::endl;
+}
+
 // Method for creating epoll instance
 
 int Scanner::createEpoll() {
@@ -86,408 +95,295 @@ void Scanner::closeEpoll(int epollFd) {
 }
 
 
-// Methods for scanning ports -> TCP IPv4, TCP IPv6, UDP IPv4, UDP IPv6
+// Methods of policy of IPv4
+
+const char* Ipv4Family::transport(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, IpAddress& peer, size_t& transportLen) {
+    (void)from;
+    // Raw IPv4 socket receives packet with IP header
+    if (length < sizeof(struct iphdr)) return nullptr;
+    const struct iphdr* ipHeader = (const struct iphdr*)buffer;
+    size_t ipHeaderLen = ipHeader->ihl * 4;
+    // Reply must be sent to address of interface
+    if (length < ipHeaderLen || memcmp(&ipHeader->daddr, local.bytes, 4) != 0) return nullptr;
+    peer = IpAddress();
+    peer.family = AF_INET;
+    memcpy(peer.bytes, &ipHeader->saddr, 4);
+    transportLen = length - ipHeaderLen;
+    return buffer + ipHeaderLen;
+}
 
-void TcpIpv4Scanner::scan() {
-    // Source port
-    int srcPort = DEFAULT_SOURCE_PORT;
-    // Create and bind socket to interface
-    int fdSock = this->createSocket(AF_INET, IPPROTO_TCP);
-    if (fdSock == -1) throw std::runtime_error("Could not create or bind socket!");
-    
-    // Create epoll instance for timeout handling
-    int epollFd = this->createEpoll();
-    if(epollFd == -1) throw std::runtime_error("Could not create epoll instance!");
-    
-    // Add socket to epoll
-    struct epoll_event ev, events[MAX_EVENTS];
-    ev.events = EPOLLIN;
-    ev.data.fd = fdSock;
-    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fdSock, &ev) == -1) {
-        this->closeSocket(fdSock);
-        this->closeEpoll(epollFd);
-        throw std::runtime_error("Could not add socket to epoll!");
-    }
+const char* Ipv4Family::portUnreachable(const char* buffer, size_t length, IpAddress& quotedSrc, IpAddress& quotedDst, size_t& quotedLen) {
+    // Raw ICMP socket receives IP header, ICMP header and quoted IP header with start of quoted datagram
+    if (length < sizeof(struct iphdr)) return nullptr;
+    size_t outerLen = ((const struct iphdr*)buffer)->ihl * 4;
+    if (length < outerLen + sizeof(struct icmphdr) + sizeof(struct iphdr)) return nullptr;
+    const struct icmphdr* icmpHeader = (const struct icmphdr*)(buffer + outerLen);
+    if (icmpHeader->type != ICMP_DEST_UNREACH || icmpHeader->code != ICMP_PORT_UNREACH) return nullptr;
+
+    const char* inner = buffer + outerLen + sizeof(struct icmphdr);
+    const struct iphdr* innerIp = (const struct iphdr*)inner;
+    size_t innerLen = innerIp->ihl * 4;
+    size_t quotedOffset = outerLen + sizeof(struct icmphdr) + innerLen;
+    if (length < quotedOffset) return nullptr;
+    quotedSrc = IpAddress();
+    quotedSrc.family = AF_INET;
+    memcpy(quotedSrc.bytes, &innerIp->saddr, 4);
+    quotedDst = IpAddress();
+    quotedDst.family = AF_INET;
+    memcpy(quotedDst.bytes, &innerIp->daddr, 4);
+    quotedLen = length - quotedOffset;
+    return buffer + quotedOffset;
+}
 
-    // For each destination IP address and port
-    for (std::string dstIpv4 : scanParams.getIp4AddrDest()) {
-        for (int port : scanParams.getTcpPorts()) {
-
-            // Create TCP header
-            struct tcphdr tcpHeader;
-            memset(&tcpHeader, 0, sizeof(tcphdr));
-            tcpHeader.th_sport = htons(srcPort);
-            tcpHeader.th_dport = htons(port);
-            tcpHeader.th_flags = TH_SYN;
-            tcpHeader.th_seq = htonl(rand());
-            tcpHeader.th_win = htons(65535);
-            tcpHeader.th_off = 5;
-            tcpHeader.th_ack = 0;
-            tcpHeader.th_urp = 0;
-            tcpHeader.th_sum = 0;
-
-            
-            // Create pseudo header for checksum calculation
-            struct checkSumPseudoHdrIpv4 pseudoHdr;
-            memset(&pseudoHdr, 0, sizeof(struct checkSumPseudoHdrIpv4));
-            if(inet_pton(AF_INET, scanParams.getInterfaceIpv4().c_str(), &pseudoHdr.srcAddr) != 1){
-                this->closeSocket(fdSock);
-                this->closeEpoll(epollFd);
-                throw std::runtime_error("Inet_pton failed!");
-            }
-            if(inet_pton(AF_INET, dstIpv4.c_str(), &pseudoHdr.dstAddr) != 1){
-                this->closeSocket(fdSock);
-                this->closeEpoll(epollFd);
-                throw std::runtime_error("Inet_pton failed!");
-            }
-            pseudoHdr.protocol = IPPROTO_TCP;
-            pseudoHdr.zero = 0;
-            pseudoHdr.protocolLength = htons(sizeof(struct tcphdr));
-
-            // Create segment for checksum calculation
-            size_t segmentLength = sizeof(struct tcphdr) + sizeof(struct checkSumPseudoHdrIpv4);
-            std::vector<char> segment(segmentLength);
-            // Copy pseudo header and TCP header to segment
-            memcpy(segment.data(), &pseudoHdr, sizeof(struct checkSumPseudoHdrIpv4));
-            memcpy(segment.data() + sizeof(struct checkSumPseudoHdrIpv4), &tcpHeader, sizeof(struct tcphdr));
-            // Calculate checksum
-            tcpHeader.th_sum = this->calculateChecksum(segment.data(), segmentLength);
-
-            // Create socket destination address for sending
-            struct sockaddr_in sockDstAddr;
-            memset(&sockDstAddr, 0, sizeof(sockDstAddr));
-            sockDstAddr.sin_family = AF_INET;
-            sockDstAddr.sin_port = htons(port);
-            sockDstAddr.sin_addr.s_addr = inet_addr(dstIpv4.c_str());
-            socklen_t sockDstAddrLen = sizeof(sockDstAddr);
-            // Flag for filtred
-            bool notFiltered = false;
-            // Pointers for received packet
-            struct iphdr* ipHeader = nullptr;
-            struct tcphdr* tcpRecive = nullptr;
-
-            // In tcp when timeout is reached, we try to send packet again
-            for (int i = 0; i < MAX_RETRIES; i++) {
-                // Send packet
-                if (sendto(fdSock, (struct tcphdr*)&tcpHeader, sizeof(struct tcphdr), 0, (struct sockaddr*)&sockDstAddr, sockDstAddrLen) == -1) {
-                    this->closeSocket(fdSock);
-                    this->closeEpoll(epollFd);
-                    throw std::runtime_error("Could not send packet!");
-                }
-                // Start timeout
-                int timeout = scanParams.getTimeout();
-                auto startTime = std::chrono::steady_clock::now();
-
-                // Wait for response
-                while (timeout > 0) {
-                    // Wait for event
-                    int epollState = epoll_wait(epollFd, events, MAX_EVENTS, timeout);
-                    // Save time of event
-                    auto now = std::chrono::steady_clock::now();
-                    // Calculate time delta
-                    int delta = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
-                    // Decrease spend time from timeout
-                    timeout -= delta;
-                    // Set new start time
-                    startTime = now;
-
-                    // Check if epoll_wait failed
-                    if (epollState == -1) {
-                        this->closeSocket(fdSock);
-                        this->closeEpoll(epollFd);
-                        throw std::runtime_error("Epoll_wait failed!");
-                    // Check timeout reached
-                    } else if (epollState == 0) {
-                        break;
-                    }
+// Methods of policy of IPv6
 
-                    // Buffer for received packet
-                    char buffer[MAX_BUFFER_SIZE];
-                    // Receive socket address
-                    struct sockaddr_in socketRecvAddr;
-                    socklen_t sockRecvAddrLen = sizeof(socketRecvAddr);
-                    if(recvfrom(fdSock, buffer, sizeof(buffer), 0, (struct sockaddr*)&socketRecvAddr, &sockRecvAddrLen) == -1){
-                        this->closeSocket(fdSock);
-                        this->closeEpoll(epollFd);
-                        throw std::runtime_error("Cannot receive packet!");
-                    }
-                    
-                    // Parse received packet
-                    ipHeader = (struct iphdr*)buffer;
-                    tcpRecive = (struct tcphdr*)(buffer + (ipHeader->ihl * 4));
-                    // Check validity of received packet
-                    bool dstAddrMatch = socketRecvAddr.sin_addr.s_addr == sockDstAddr.sin_addr.s_addr;
-                    bool srcAddrMatch = ipHeader->daddr == inet_addr(scanParams.getInterfaceIpv4().c_str());
-                    bool portMatch = ntohs(tcpRecive->th_sport) == port;
-                    bool dstPortMatch = ntohs(tcpRecive->th_dport) == srcPort;
-                    
-                    // If right packet was received, break
-                    if (srcAddrMatch && dstAddrMatch && portMatch && dstPortMatch) {
-                        notFiltered = true;
-                        break;
-                    }
-                }
-                // If packet was received, break
-                if (notFiltered) break;
-            }
+const char* Ipv6Family::transport(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, IpAddress& peer, size_t& transportLen) {
+    (void)local;
+    // Raw IPv6 socket receives packet without IP header, sender is taken from socket address
+    if (from.ss_family != AF_INET6) return nullptr;
+    peer = IpAddress::fromSockaddr((const struct sockaddr*)&from);
+    transportLen = length;
+    return buffer;
+}
 
-            // Print result
-            if (!notFiltered) {
-                std::cout << dstIpv4 << " " << port << " " << "tcp filtered" << std::endl;
-            } else if (tcpRecive && (tcpRecive->th_flags & TH_SYN) && (tcpRecive->th_flags & TH_ACK)) {
-                std::cout << dstIpv4 << " " << port << " " <<"tcp open" << std::endl;
-            } else if (tcpRecive && (tcpRecive->th_flags & TH_RST)) {
-                std::cout << dstIpv4 << " " << port << " " << "tcp closed" << std::endl;
-            }
+const char* Ipv6Family::portUnreachable(const char* buffer, size_t length, IpAddress& quotedSrc, IpAddress& quotedDst, size_t& quotedLen) {
+    // Raw ICMPv6 socket receives ICMPv6 header and quoted IPv6 header with start of quoted datagram
+    size_t quotedOffset = sizeof(struct icmp6_hdr) + sizeof(struct ip6_hdr);
+    if (length < quotedOffset) return nullptr;
+    const struct icmp6_hdr* icmpHeader = (const struct icmp6_hdr*)buffer;
+    if (icmpHeader->icmp6_type != ICMP6_DST_UNREACH || icmpHeader->icmp6_code != ICMP6_DST_UNREACH_NOPORT) return nullptr;
+
+    const struct ip6_hdr* innerIp = (const struct ip6_hdr*)(buffer + sizeof(struct icmp6_hdr));
+    quotedSrc = IpAddress();
+    quotedSrc.family = AF_INET6;
+    memcpy(quotedSrc.bytes, &innerIp->ip6_src, 16);
+    quotedDst = IpAddress();
+    quotedDst.family = AF_INET6;
+    memcpy(quotedDst.bytes, &innerIp->ip6_dst, 16);
+    quotedLen = length - quotedOffset;
+    return buffer + quotedOffset;
+}
 
-            // Increase source port
-            if (srcPort < MAX_SOURCE_PORT) srcPort++;
-            else srcPort = DEFAULT_SOURCE_PORT;
-        }
-    }
-    // Free descriptors
-    this->closeSocket(fdSock);
-    this->closeEpoll(epollFd);
+// Methods of policy of TCP
+
+size_t TcpProtocol::build(const ProbeTemplate& probeTemplate, uint16_t srcPort, uint16_t dstPort, Header& header) {
+    probeTemplate.buildTcpSyn(srcPort, dstPort, rand(), header);
+    return sizeof(header);
 }
 
+template <typename Family>
+portState TcpProtocol::parse(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, ProbeKey& probe) {
+    // Sender of reply is destination of probe
+    size_t segmentLen;
+    const char* segment = Family::transport(buffer, length, from, local, probe.dst, segmentLen);
+    if (segment == nullptr || segmentLen < sizeof(struct tcphdr)) return PORT_NONE;
+
+    // Ports of reply are swapped ports of probe
+    struct tcphdr reply;
+    memcpy(&reply, segment, sizeof(reply));
+    probe.dstPort = ntohs(reply.th_sport);
+    probe.srcPort = ntohs(reply.th_dport);
+    if ((reply.th_flags & TH_SYN) && (reply.th_flags & TH_ACK)) return PORT_TCP_OPEN;
+    if (reply.th_flags & TH_RST) return PORT_TCP_CLOSED;
+    return PORT_NONE;
+}
 
-void TcpIpv6Scanner::scan() {
-    // Source port
-    int srcPort = DEFAULT_SOURCE_PORT;
-    // Create and bind socket to interface
-    int fdSock = this->createSocket(AF_INET6, IPPROTO_TCP);
-    if (fdSock == -1) throw std::runtime_error("Could not create or bind socket!");
-    // Create epoll instance for timeout handling
-    int epollFd = this->createEpoll();
+template <typename Family>
+portState TcpProtocol::match(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, const IpAddress& dst, uint16_t dstPort, uint16_t srcPort) {
+    ProbeKey probe;
+    portState state = parse<Family>(buffer, length, from, local, probe);
+    if (state == PORT_NONE || !(probe == ProbeKey{dst, dstPort, srcPort})) return PORT_NONE;
+    return state;
+}
 
-    // Add socket to epoll
-    struct epoll_event ev, events[MAX_EVENTS];
-    ev.events = EPOLLIN;
-    ev.data.fd = fdSock;
-    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fdSock, &ev) == -1) {
-        close(fdSock);
-        close(epollFd);
-        throw std::runtime_error("Could not add socket to epoll!");
-    }
+// Methods of policy of UDP
 
-    // For each destination IP address and port
-    for (std::string dstIpv6 : scanParams.getIp6AddrDest()) {
-        for (int port : scanParams.getTcpPorts()) {
-            // Create TCP header
-            struct tcphdr tcpHeader;
-            memset(&tcpHeader, 0, sizeof(tcphdr));
-            tcpHeader.th_sport = htons(srcPort);
-            tcpHeader.th_dport = htons(port);
-            tcpHeader.th_flags = TH_SYN;
-            tcpHeader.th_seq = htonl(rand());
-            tcpHeader.th_win = htons(65535);
-            tcpHeader.th_off = 5;
-            tcpHeader.th_ack = 0;
-            tcpHeader.th_urp = 0;
-            tcpHeader.th_sum = 0;
-
-            // Create pseudo header for checksum calculation
-            struct checkSumPseudoHdrIpv6 pseudoHdr;
-            memset(&pseudoHdr, 0, sizeof(pseudoHdr));
-            if (inet_pton(AF_INET6, scanParams.getInterfaceIpv6().c_str(), &pseudoHdr.src) != 1) {
-                this->closeSocket(fdSock);
-                this->closeEpoll(epollFd);
-                throw std::runtime_error("Inet_pton failed!");
-            }
-            if (inet_pton(AF_INET6, dstIpv6.c_str(), &pseudoHdr.dst) != 1) {
-                this->closeSocket(fdSock);
-                this->closeEpoll(epollFd);
-                throw std::runtime_error("Inet_pton failed!");
-            }
-            pseudoHdr.length = htonl(sizeof(struct tcphdr));
-            pseudoHdr.next_header = IPPROTO_TCP;
-
-            // Create segment for checksum calculation
-            size_t segmentLenght = sizeof(struct tcphdr) + sizeof(struct checkSumPseudoHdrIpv6);
-            std::vector<char> segment(segmentLenght);
-            memcpy(segment.data(), &pseudoHdr, sizeof(struct checkSumPseudoHdrIpv6));
-            memcpy(segment.data() + sizeof(struct checkSumPseudoHdrIpv6), &tcpHeader, sizeof(struct tcphdr));
-            tcpHeader.th_sum = this->calculateChecksum(segment.data(), segmentLenght);
-
-            // Create socket destination address for sending
-            struct sockaddr_in6 sockDstAddr;
-            memset(&sockDstAddr, 0, sizeof(sockDstAddr));
-            sockDstAddr.sin6_family = AF_INET6;
-            sockDstAddr.sin6_port = htons(0);
-            if (inet_pton(AF_INET6, dstIpv6.c_str(), &sockDstAddr.sin6_addr) != 1) {
-                this->closeSocket(fdSock);
-                this->closeEpoll(epollFd);
-                throw std::runtime_error("Inet_pton failed!");
-            }
-            
-            
-            // Flag for filtred
-            bool notFiltered = false;
-            // Pointers for received packet
-            struct tcphdr* tcpRecive = nullptr;
-
-            // In tcp when timeout is reached, we try to send packet again
-            for (int i = 0; i < MAX_RETRIES; i++) {
-                // Send packet
-                if (sendto(fdSock, (struct tchphdr*) &tcpHeader, sizeof(struct tcphdr), 0, (struct sockaddr*)&sockDstAddr, sizeof(sockDstAddr)) == -1) {
-                    this->closeSocket(fdSock);
-                    this->closeEpoll(epollFd);
-                    throw std::runtime_error("Could not send packet!");
-                }
-               // Start timeout
-               int timeout = scanParams.getTimeout();
-               auto startTime = std::chrono::steady_clock::now();
-
-               // Wait for response
-               while (timeout > 0) {
-                    // Wait for event
-                    int epollState = epoll_wait(epollFd, events, MAX_EVENTS, timeout);
-                    // Save time of event
-                    auto now = std::chrono::steady_clock::now();
-                    // Calculate time delta
-                    int delta = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
-                    // Decrease spend time from timeout
-                    timeout -= delta;
-                    // Set new start time
-                    startTime = now;
-
-                    // Check if epoll_wait failed
-                    if (epollState == -1) {
-                        this->closeSocket(fdSock);
-                        this->closeEpoll(epollFd);
-                        throw std::runtime_error("Epoll_wait failed!");
-                    // Check timeout reached
-                    } else if (epollState == 0) {
-                        break;
-                    }
+size_t UdpProtocol::build(const ProbeTemplate& probeTemplate, uint16_t srcPort, uint16_t dstPort, Header& header) {
+    // Well-known port gets request of its service, other ports empty datagram
+    const UdpPayload* payload = UdpPayloads::find(dstPort);
+    if (payload == nullptr) return probeTemplate.buildUdp(srcPort, dstPort, nullptr, 0, (char*)&header);
+    return probeTemplate.buildUdp(srcPort, dstPort, payload->data, payload->length, (char*)&header);
+}
 
-                    // Buffer for received packet
-                    char buffer[MAX_BUFFER_SIZE];
-                    // Receive socket address
-                    struct sockaddr_in6 recvAddr;
-                    socklen_t recvAddrLen = sizeof(recvAddr);
-                    if(recvfrom(fdSock, buffer, sizeof(buffer), 0, (struct sockaddr*)&recvAddr, &recvAddrLen) == -1){ 
-                        this->closeSocket(fdSock);
-                        this->closeEpoll(epollFd);
-                        throw std::runtime_error("Cannot receive packet!");
-                    }
-                    
-                    // Parse received packet
-                    tcpRecive = (struct tcphdr*)buffer;
-                    // Check validity of received packet
-                    bool dstAddrMatch = memcmp(&recvAddr.sin6_addr, &sockDstAddr.sin6_addr, sizeof(in6_addr)) == 0;
-                    bool portMatch = ntohs(tcpRecive->th_sport) == port;
-                    bool dstPortMatch = ntohs(tcpRecive->th_dport) == srcPort;
-                                    
-
-                    // If right packet was received, break
-                    if (dstAddrMatch && portMatch && dstPortMatch) {    
-                        notFiltered = true;
-                        break;
-                    }
-                }
-                // If packet was received, break
-                if (notFiltered) break;
-            }
-            // Print result
-            if (!notFiltered) {
-                std::cout << dstIpv6 << " " << port << " " << "tcp filtered" << std::endl;
-            } else if (tcpRecive && (tcpRecive->th_flags & TH_SYN) && (tcpRecive->th_flags & TH_ACK)) {
-                std::cout << dstIpv6 << " " << port << " " << "tcp open" << std::endl;
-            } else if (tcpRecive && (tcpRecive->th_flags & TH_RST)) {
-                std::cout << dstIpv6 << " " << port << " " << "tcp closed" << std::endl;
-            }
-            // Increase source port
-            if (srcPort < MAX_SOURCE_PORT) srcPort++;
-            else srcPort = DEFAULT_SOURCE_PORT;
+template <typename Family>
+portState UdpProtocol::parse(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, ProbeKey& probe) {
+    // Error must quote datagram sent from interface
+    IpAddress quotedSrc;
+    size_t quotedLen;
+    const char* quoted = Family::portUnreachable(buffer, length, quotedSrc, probe.dst, quotedLen);
+    if (quoted == nullptr || quotedLen < sizeof(struct udphdr) || quotedSrc != local) return PORT_NONE;
+    // Error must be sent by destination itself, unreachable port reported by router or firewall is not closed port
+    if (from.ss_family != Family::domain || IpAddress::fromSockaddr((const struct sockaddr*)&from) != probe.dst) return PORT_NONE;
+
+    struct udphdr datagram;
+    memcpy(&datagram, quoted, sizeof(datagram));
+    probe.dstPort = ntohs(datagram.dest);
+    probe.srcPort = ntohs(datagram.source);
+    return PORT_UDP_CLOSED;
+}
 
-        }
-    }
-    // Free descriptors
-    this->closeSocket(fdSock);
-    this->closeEpoll(epollFd);
+template <typename Family>
+portState UdpProtocol::match(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, const IpAddress& dst, uint16_t dstPort, uint16_t srcPort) {
+    ProbeKey probe;
+    portState state = parse<Family>(buffer, length, from, local, probe);
+    if (state == PORT_NONE || !(probe == ProbeKey{dst, dstPort, srcPort})) return PORT_NONE;
+    return state;
+}
+
+template <typename Family>
+portState UdpProtocol::parseDatagram(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, ProbeKey& probe) {
+    // Sender of reply is destination of probe, any datagram from its port is answer of service
+    size_t datagramLen;
+    const char* datagram = Family::transport(buffer, length, from, local, probe.dst, datagramLen);
+    if (datagram == nullptr || datagramLen < sizeof(struct udphdr)) return PORT_NONE;
+
+    // Ports of reply are swapped ports of probe
+    struct udphdr reply;
+    memcpy(&reply, datagram, sizeof(reply));
+    probe.dstPort = ntohs(reply.source);
+    probe.srcPort = ntohs(reply.dest);
+    return PORT_UDP_OPEN;
 }
 
-void UdpIpv4Scanner::scan() {
-    // Source port
-    int srcPort = DEFAULT_SOURCE_PORT;
+template <typename Family>
+portState UdpProtocol::matchDatagram(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, const IpAddress& dst, uint16_t dstPort, uint16_t srcPort) {
+    ProbeKey probe;
+    portState state = parseDatagram<Family>(buffer, length, from, local, probe);
+    if (state == PORT_NONE || !(probe == ProbeKey{dst, dstPort, srcPort})) return PORT_NONE;
+    return state;
+}
+
+// Method for scanning ports, one engine for TCP IPv4, TCP IPv6, UDP IPv4, UDP IPv6
+
+template <typename Family, typename Protocol>
+void SequentialScanner<Family, Protocol>::scan() {
+    // Stage of resumed scan starts from saved position, finished stage is skipped
+    std::string stage = Checkpoint::stageName(Family::domain, Protocol::protocol);
+    uint64_t start = 0;
+    if (this->checkpoint) {
+        StageProgress progress = this->checkpoint->progress(stage);
+        if (progress.done) return;
+        start = progress.position;
+    }
+    // Address of interface and targets, converted once before scan
+    IpAddress local = this->plan.getSourceAddress(Family::domain);
+    const TargetGenerator& targets = Family::targets(this->plan);
+    const std::vector<uint16_t>& ports = Protocol::ports(this->plan);
+    uint64_t total = targets.size() * ports.size();
+    // Probes which differed in baseline are sent first, sweep of all positions skips them
+    std::vector<uint64_t> prioritized;
+    if (this->baseline && this->scanParams.isChangedFirst()) prioritized = this->baseline->priority(targets, ports, Protocol::protocol);
+    // Headers of probes with checksums prebuilt for address of interface
+    ProbeTemplate probeTemplate(local);
+
     // Create and bind socket to interface
-    int fdSock = this->createSocket(AF_INET, IPPROTO_UDP);
-    if(fdSock == -1) throw std::runtime_error("Could not create or bind socket!");
-    // Create and bind ICMP socket
-    int icmp = this->createSocket(AF_INET, IPPROTO_ICMP);
-    if (icmp == -1) {
-        this->closeSocket(fdSock);
-        throw std::runtime_error("Could not create or bind ICMP socket!");
+    int fdSock = this->createSocket(Family::domain, Protocol::protocol);
+    if (fdSock == -1) throw std::runtime_error("Could not create or bind socket!");
+    // Replies of TCP are received by the same socket, ICMP errors caused by UDP by ICMP socket
+    int recvSock = fdSock;
+    if (Protocol::repliesByIcmp) {
+        recvSock = this->createSocket(Family::domain, Family::icmpProtocol);
+        if (recvSock == -1) {
+            this->closeSocket(fdSock);
+            throw std::runtime_error("Could not create or bind ICMP socket!");
+        }
     }
     // Create epoll instance for timeout handling
     int epollFd = this->createEpoll();
-    if(epollFd == -1) {
+    // Function for freeing descriptors
+    auto closeDescriptors = [&]() {
         this->closeSocket(fdSock);
-        this->closeSocket(icmp);
+        if (recvSock != fdSock) this->closeSocket(recvSock);
+        if (epollFd != -1) this->closeEpoll(epollFd);
+    };
+    if (epollFd == -1) {
+        closeDescriptors();
         throw std::runtime_error("Could not create epoll instance!");
     }
-    // Add ICMP socket to epoll
+
+    // Add receiving socket to epoll
     struct epoll_event ev, events[MAX_EVENTS];
     ev.events = EPOLLIN;
-    ev.data.fd = fdSock;
-    // Add ICMP socket to epoll
-    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, icmp, &ev) == -1) {
-        this->closeSocket(fdSock);
-        this->closeEpoll(epollFd);
-        this->closeSocket(icmp);
+    ev.data.fd = recvSock;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, recvSock, &ev) == -1) {
+        closeDescriptors();
         throw std::runtime_error("Could not add socket to epoll!");
     }
-    // For each destination IP address and port
-    for (std::string dstIpv4 : scanParams.getIp4AddrDest()) {
-        for (int port : scanParams.getUdpPorts()) {
-            // Create UDP header
-            struct udphdr udpHeader;
-            memset(&udpHeader, 0, sizeof(udphdr));
-            udpHeader.source = htons(srcPort);
-            udpHeader.dest = htons(port);
-            udpHeader.len = htons(sizeof(struct udphdr));
-            
-            // Create pseudo header for checksum calculation
-            struct checkSumPseudoHdrIpv4 pseudoHdr;
-            memset(&pseudoHdr, 0, sizeof(struct checkSumPseudoHdrIpv4));
-            pseudoHdr.srcAddr = inet_addr(scanParams.getInterfaceIpv4().c_str());
-            pseudoHdr.dstAddr = inet_addr(dstIpv4.c_str());
-            pseudoHdr.protocol = IPPROTO_UDP;
-            pseudoHdr.zero = 0;
-            pseudoHdr.protocolLength = htons(sizeof(struct udphdr));
-
-            // Create datageam for checksum calculation
-            size_t datagramLength = sizeof(struct udphdr) + sizeof(struct checkSumPseudoHdrIpv4);
-            std::vector<char> datagram(datagramLength);
-            memcpy(datagram.data(), &pseudoHdr, sizeof(struct checkSumPseudoHdrIpv4));
-            memcpy(datagram.data() + sizeof(struct checkSumPseudoHdrIpv4), &udpHeader, sizeof(struct udphdr));
-            udpHeader.check = this->calculateChecksum(datagram.data(), datagramLength);
-
-            // Create socket destination address for sending
-            struct sockaddr_in sockDstAddr;
-            memset(&sockDstAddr, 0, sizeof(sockDstAddr));
-            sockDstAddr.sin_family = AF_INET;
-            sockDstAddr.sin_port = htons(port);
-            sockDstAddr.sin_addr.s_addr = inet_addr(dstIpv4.c_str());
-            // Flag for get ICMP packet
-            bool getIcmp = false;
+    // Replies of services to UDP probes are received by socket of probes
+    if (Protocol::repliesByDatagram) {
+        ev.data.fd = fdSock;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fdSock, &ev) == -1) {
+            closeDescriptors();
+            throw std::runtime_error("Could not add socket to epoll!");
+        }
+    }
 
+    // Destination of current position, its index, estimator of round trip time, pacer of probes and socket address
+    IpAddress target;
+    uint64_t targetIndex = UINT64_MAX;
+    RttEstimator rtt(this->plan.getTimeout());
+    UdpPacer pacer;
+    // Times of pacer are measured from start of scan
+    auto scanStart = std::chrono::steady_clock::now();
+    struct sockaddr_storage sockDstAddr;
+    socklen_t sockDstAddrLen = 0;
+
+    // For each destination IP address and port, position is index of target x port space, prioritized positions go first
+    for (uint64_t step = start; step < prioritized.size() + total; step++) {
+        uint64_t position = step < prioritized.size() ? prioritized[step] : step - prioritized.size();
+        if (step >= prioritized.size() && std::binary_search(prioritized.begin(), prioritized.end(), position)) continue;
+        uint16_t port = ports[position % ports.size()];
+        // Source port is derived from step, so resumed scan uses the same ports
+        int srcPort = DEFAULT_SOURCE_PORT + (int)(step % (MAX_SOURCE_PORT - DEFAULT_SOURCE_PORT + 1));
+        // Position of other destination starts new destination
+        if (position / ports.size() != targetIndex) {
+            targetIndex = position / ports.size();
+            target = targets.at(targetIndex);
+            probeTemplate.setDestination(target);
+            // Estimator of round trip time of destination, timeout is derived from it
+            rtt = RttEstimator(this->plan.getTimeout());
+            // Pacer of destination, it is paced only after its ICMP errors show rate limit
+            pacer = UdpPacer();
+            // Create socket destination address for sending, port of raw socket must be zero for IPv6 and is not used for IPv4
+            sockDstAddrLen = target.toSockaddr(sockDstAddr, 0);
+        }
+
+        // Create header of probe from template of destination
+        typename Protocol::Header header;
+        size_t headerLen = Protocol::build(probeTemplate, srcPort, port, header);
+        // State of port from reply, PORT_NONE until valid reply is received
+        portState state = PORT_NONE;
+        // Flag for probe refused by kernel
+        bool refused = false;
+        // Round trip time of reply (us)
+        uint32_t replyTime = 0;
+        // Flag for state given by ICMP error
+        bool unreachable = false;
+
+        // Probe without reply is sent again, until all attempts of protocol are used
+        for (int i = 0; i < Protocol::attempts && state == PORT_NONE; i++) {
+            // Probes answered by ICMP errors wait for pace of destination, then for token of rate limiter
+            if (Protocol::repliesByIcmp) std::this_thread::sleep_until(scanStart + std::chrono::microseconds(pacer.sendTime()));
+            this->rateLimiter.acquire();
             // Send packet
-            if (sendto(fdSock, (struct udphdr*) &udpHeader, sizeof(struct udphdr), 0, (struct sockaddr*)&sockDstAddr, sizeof(sockDstAddr)) == -1) {
-                this->closeSocket(fdSock);
-                this->closeEpoll(epollFd);
-                this->closeSocket(icmp);
+            if (sendto(fdSock, &header, headerLen, 0, (struct sockaddr*)&sockDstAddr, sockDstAddrLen) == -1) {
+                // Broadcast address of scanned block is refused by kernel
+                if (errno == EACCES) {
+                    refused = true;
+                    break;
+                }
+                closeDescriptors();
                 throw std::runtime_error("Could not send packet!");
-                
             }
-
-            // Start timeout
-            int timeout = scanParams.getTimeout();
+            uint64_t sentAt = SystemUtils::elapsedMicros(scanStart);
+            if (Protocol::repliesByIcmp) pacer.send(sentAt);
+            // Start timeout, derived from round trip time of destination
+            int timeout = rtt.timeout(i);
             auto startTime = std::chrono::steady_clock::now();
-            
+            auto sendTime = startTime;
+
             // Wait for response
-            while(!getIcmp && timeout > 0){
+            while (timeout > 0) {
                 // Wait for event
                 int epollState = epoll_wait(epollFd, events, MAX_EVENTS, timeout);
                 // Save time of event
@@ -501,246 +397,87 @@ void UdpIpv4Scanner::scan() {
 
                 // Check if epoll_wait failed
                 if (epollState == -1) {
-                    this->closeSocket(fdSock);
-                    this->closeEpoll(epollFd);
-                    this->closeSocket(icmp);
+                    closeDescriptors();
                     throw std::runtime_error("Epoll_wait failed!");
                 // Check timeout reached
                 } else if (epollState == 0) {
                     break;
                 }
-                
-                // Buffer for received packet
-                char buffer[MAX_BUFFER_SIZE];
-                int received = recvfrom(icmp, buffer, sizeof(buffer), 0, nullptr, nullptr);
-                if (received == -1){
-                    this->closeSocket(fdSock);
-                    this->closeEpoll(epollFd);
-                    this->closeSocket(icmp);
-                    throw std::runtime_error("Cannot receive packet!");
-                }
 
-                // Parse received packet
-                struct icmphdr* icmpHeader = (struct icmphdr*)(buffer + sizeof(struct iphdr));
-                struct iphdr* ipHeader = (struct iphdr*)(buffer);
-                unsigned char* innerIpStart = (unsigned char*)icmpHeader + sizeof(struct icmphdr);
-                struct iphdr* innerIp = (struct iphdr*)innerIpStart;
-                struct udphdr* innerUdp = (struct udphdr*)(innerIpStart + innerIp->ihl * 4);
-                char srcIp[INET_ADDRSTRLEN], dstIp[INET_ADDRSTRLEN];
-                if(inet_ntop(AF_INET, &ipHeader->saddr, dstIp, sizeof(srcIp)) == nullptr){
-                    this->closeSocket(fdSock);
-                    this->closeEpoll(epollFd);
-                    this->closeSocket(icmp);
-                    throw std::runtime_error("Inet_ntop failed!");
-                }
-                if(inet_ntop(AF_INET, &ipHeader->daddr, srcIp, sizeof(dstIp)) == nullptr){
-                    this->closeSocket(fdSock);
-                    this->closeEpoll(epollFd);
-                    this->closeSocket(icmp);
-                    throw std::runtime_error("Inet_ntop failed!");
-                }
-
-                // Check validity of received packet
-                bool matchAddr = dstIpv4 == std::string(dstIp) && scanParams.getInterfaceIpv4() == std::string(srcIp);
-                bool matchPort = ntohs(innerUdp->dest) == port && ntohs(innerUdp->source) == srcPort;
-                bool matchIcmp = icmpHeader->type == ICMP_UNREACH_PORT && icmpHeader->code == ICMP_UNREACH_PORT;
+                // Read packet of every ready socket, until one of them is reply to probe
+                for (int event = 0; event < epollState && state == PORT_NONE; event++) {
+                    int readySock = events[event].data.fd;
+                    // Buffer for received packet
+                    char buffer[MAX_BUFFER_SIZE];
+                    // Receive socket address
+                    struct sockaddr_storage recvAddr;
+                    socklen_t recvAddrLen = sizeof(recvAddr);
+                    ssize_t received = recvfrom(readySock, buffer, sizeof(buffer), 0, (struct sockaddr*)&recvAddr, &recvAddrLen);
+                    if (received == -1) {
+                        closeDescriptors();
+                        throw std::runtime_error("Cannot receive packet!");
+                    }
 
-                // If right packet was received and has right ICMP type then set prot like closed
-                if(matchAddr && matchPort && matchIcmp){
-                    getIcmp = true;
-                    std::cout << dstIpv4 << " " << port << " " << "udp closed" << std::endl;
+                    // Check validity of received packet, right packet gives state of port
+                    if constexpr (Protocol::repliesByDatagram) {
+                        if (readySock == fdSock) {
+                            state = Protocol::template matchDatagram<Family>(buffer, received, recvAddr, local, target, port, srcPort);
+                            continue;
+                        }
+                    }
+                    state = Protocol::template match<Family>(buffer, received, recvAddr, local, target, port, srcPort);
+                    unreachable = Protocol::repliesByIcmp && state != PORT_NONE;
+                }
+                if (state != PORT_NONE) {
+                    replyTime = std::chrono::duration_cast<std::chrono::microseconds>(now - sendTime).count();
+                    // Only reply to not retransmitted packet can be measured
+                    if (i == 0) rtt.sample(replyTime);
+                    // Cadence of ICMP errors gives pace of destination
+                    if (unreachable) pacer.unreachable(std::chrono::duration_cast<std::chrono::microseconds>(now - scanStart).count(), i > 0);
                     break;
                 }
-
             }
+            // Probe without reply of destination which answers by ICMP errors can be suppressed by their rate limit
+            if (Protocol::repliesByIcmp && state == PORT_NONE) pacer.lost(sentAt);
+        }
 
-            // If packet was not received, set port like open
-            if(!getIcmp){
-                std::cout << dstIpv4 << " " << port << " " << "udp open" << std::endl;
+        // Print result, port without reply has silent state of protocol
+        if (refused) state = Protocol::refusedState;
+        else if (state == PORT_NONE) state = Protocol::silentState;
+        if (state != PORT_NONE) this->writeResult(target, port, state, replyTime);
+
+        // Save progress periodically, probe of this step is resolved
+        if (this->checkpoint && this->checkpoint->due()) {
+            try {
+                this->checkpoint->update(stage, step + 1, {});
+                this->checkpoint->save();
+            } catch (...) {
+                closeDescriptors();
+                throw;
             }
-            // Increase source port
-            if (srcPort < MAX_SOURCE_PORT) srcPort++;
-            else srcPort = DEFAULT_SOURCE_PORT;
-            
         }
     }
     // Free descriptors
-    this->closeSocket(fdSock);
-    this->closeEpoll(epollFd);
-    this->closeSocket(icmp);
+    closeDescriptors();
+    // Finished stage is not scanned again after resume
+    if (this->checkpoint) {
+        this->checkpoint->finish(stage);
+        this->checkpoint->save();
+    }
 }
 
-void UdpIpv6Scanner::scan() {
-    int srcPort = DEFAULT_SOURCE_PORT;
-    // Create and bind socket to interface
-    int fdSock = this->createSocket(AF_INET6, IPPROTO_UDP);
-    if(fdSock == -1) throw std::runtime_error("Could not create or bind socket!");
-    // Create and bind ICMP socket
-    int icmp = this->createSocket(AF_INET6, IPPROTO_ICMPV6);
-    if (icmp == -1) {
-        this->closeSocket(fdSock);
-        throw std::runtime_error("Could not create or bind ICMP socket!");
-    }
-    // Create epoll instance for timeout handling
-    int epollFd = this->createEpoll();
-    if(epollFd == -1) {
-        this->closeSocket(fdSock);
-        this->closeSocket(icmp);
-        throw std::runtime_error("Could not create epoll instance!");
-    }
-    // Add ICMP socket to epoll
-    struct epoll_event ev, events[MAX_EVENTS];
-    ev.events = EPOLLIN;
-    ev.data.fd = fdSock;
-    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, icmp, &ev) == -1) {
-        this->closeSocket(fdSock);
-        this->closeEpoll(epollFd);
-        this->closeSocket(icmp);
-        throw std::runtime_error("Could not add socket to epoll!");
-    }
-    // For each destination IP address and port
-    for (std::string dstIpv6 : scanParams.getIp6AddrDest()) {
-        for (int port : scanParams.getUdpPorts()) {
-            // Create UDP header
-            struct udphdr udpHeader;
-            memset(&udpHeader, 0, sizeof(udphdr));
-            udpHeader.source = htons(srcPort);
-            udpHeader.dest = htons(port);
-            udpHeader.len = htons(sizeof(struct udphdr));
-            
-            // Create pseudo header for checksum calculation
-            struct checkSumPseudoHdrIpv6 pseudoHdr;
-            memset(&pseudoHdr, 0, sizeof(pseudoHdr));
-            if (inet_pton(AF_INET6, scanParams.getInterfaceIpv6().c_str(), &pseudoHdr.src) != 1) {
-                this->closeSocket(fdSock);
-                this->closeEpoll(epollFd);
-                this->closeSocket(icmp);
-                throw std::runtime_error("Inet_pton failed!");
-            }
-            if (inet_pton(AF_INET6, dstIpv6.c_str(), &pseudoHdr.dst) != 1) {
-                this->closeSocket(fdSock);
-                this->closeEpoll(epollFd);
-                this->closeSocket(icmp);
-                throw std::runtime_error("Inet_pton failed!");
-            }
-            pseudoHdr.length = htonl(sizeof(struct udphdr));
-            pseudoHdr.next_header = IPPROTO_UDP;
-
-            // Create datageam for checksum calculation
-            size_t datagramLength = sizeof(struct udphdr) + sizeof(struct checkSumPseudoHdrIpv6);
-            std::vector<char> datagram(datagramLength);
-            memcpy(datagram.data(), &pseudoHdr, sizeof(struct checkSumPseudoHdrIpv6));
-            memcpy(datagram.data() + sizeof(struct checkSumPseudoHdrIpv6), &udpHeader, sizeof(struct udphdr));
-            udpHeader.check = this->calculateChecksum(datagram.data(), datagramLength);
-
-            // Create socket destination address for sending
-            struct sockaddr_in6 sockDstAddr;
-            memset(&sockDstAddr, 0, sizeof(sockDstAddr));
-            sockDstAddr.sin6_family = AF_INET6;
-            if (inet_pton(AF_INET6, dstIpv6.c_str(), &sockDstAddr.sin6_addr) != 1) {
-                this->closeSocket(fdSock);
-                this->closeEpoll(epollFd);
-                this->closeSocket(icmp);
-                throw std::runtime_error("Inet_pton failed!");
-            }
+// Scanners of TCP and UDP ports with IPv4 and IPv6
 
-            // Flag for get ICMP packet
-            bool getIcmp = false;
-            // Send packet
-            if (sendto(fdSock, (struct udphdr*) &udpHeader, sizeof(struct udphdr), 0, (struct sockaddr*)&sockDstAddr, sizeof(sockDstAddr)) == -1) {
-                close(fdSock);
-                close(epollFd);
-                close(icmp);
-                throw std::runtime_error("Could not send packet!");
-            }
+template class SequentialScanner<Ipv4Family, TcpProtocol>;
+template class SequentialScanner<Ipv6Family, TcpProtocol>;
+template class SequentialScanner<Ipv4Family, UdpProtocol>;
+template class SequentialScanner<Ipv6Family, UdpProtocol>;
 
-            // Start timeout
-            int timeout = scanParams.getTimeout();
-            auto startTime = std::chrono::steady_clock::now();
-            
-            while (!getIcmp && timeout > 0) {
-                // Wait for event
-                int epollState = epoll_wait(epollFd, events, MAX_EVENTS, timeout);
-                // Save time of event
-                auto now = std::chrono::steady_clock::now();
-                // Calculate time delta
-                int delta = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
-                // Decrease spend time from timeout
-                timeout -= delta;
-                // Set new start time
-                startTime = now;
-            
-                // Check if epoll_wait failed
-                if (epollState == -1) {
-                    this->closeSocket(fdSock);
-                    this->closeEpoll(epollFd);
-                    throw std::runtime_error("Epoll_wait failed!");
-                // Check timeout reached
-                } else if (epollState == 0) {
-                    break;
-                }
-                
-                // Buffer for received packet
-                char buffer[MAX_BUFFER_SIZE];
-                // Receive packet
-                int received = recvfrom(icmp, buffer, sizeof(buffer), 0, nullptr, nullptr);
-                if (received == -1){
-                    this->closeSocket(fdSock);
-                    this->closeEpoll(epollFd);
-                    this->closeSocket(icmp);
-                    throw std::runtime_error("Cannot receive packet!");
-                }
-                
-                // Parse received packet
-                uint8_t icmpType = buffer[0];
-                uint8_t icmpCode = buffer[1];
-            
-                unsigned char* innerData = (unsigned char*)(buffer + 8); 
-                struct in6_addr* origSrcIp = (struct in6_addr*)(innerData + 8);  
-                struct in6_addr* origDstIp = (struct in6_addr*)(innerData + 24); 
-            
-                struct udphdr* innerUdp = (struct udphdr*)(innerData + 40); 
-                uint16_t udpSrcPort = ntohs(innerUdp->source);
-                uint16_t udpDstPort = ntohs(innerUdp->dest);
-            
-                char srcAddrStr[INET6_ADDRSTRLEN], dstAddrStr[INET6_ADDRSTRLEN];
-                if(inet_ntop(AF_INET6, origSrcIp, srcAddrStr, sizeof(srcAddrStr)) == nullptr){
-                    this->closeSocket(fdSock);
-                    this->closeEpoll(epollFd);
-                    this->closeSocket(icmp);
-                    throw std::runtime_error("Inet_ntop failed!");
-                }
-                if(inet_ntop(AF_INET6, origDstIp, dstAddrStr, sizeof(dstAddrStr)) == nullptr){
-                    this->closeSocket(fdSock);
-                    this->closeEpoll(epollFd);
-                    this->closeSocket(icmp);
-                    throw std::runtime_error("Inet_ntop failed!");
-                }
-                
-                // Check validity of received packet
-                bool matchPorts = (udpSrcPort == srcPort && udpDstPort == port);
-                bool matchIcmp = (icmpType == ICMP6_DST_UNREACH && icmpCode == ICMP6_DST_UNREACH_NOPORT);
-                bool matchIps = (scanParams.getInterfaceIpv6() == std::string(srcAddrStr) && dstIpv6 == std::string(dstAddrStr));
-                
-                // If right packet was received and has right ICMP type then set port like closed
-                if (matchPorts && matchIcmp && matchIps) {
-                    getIcmp = true;
-                    std::cout << dstIpv6 << " " << port << " udp closed" << std::endl;
-                }
-            }
-            
-            // If packet was not received, set port like open
-            if(!getIcmp){
-                std::cout << dstIpv6 << " " << port << " " << "udp open" << std::endl;
-            }
-            // Increase source port
-            if (srcPort < MAX_SOURCE_PORT) srcPort++;
-            else srcPort = DEFAULT_SOURCE_PORT;
-            
-        }
-    }
-    // Free descriptors
-    this->closeSocket(fdSock);
-    this->closeEpoll(epollFd);
-    this->closeSocket(icmp);
-}
\ No newline at end of file
+// Parsers of replies of protocols with IPv4 and IPv6, used also by concurrent scanner
+
+template portState TcpProtocol::parse<Ipv4Family>(const char*, size_t, const struct sockaddr_storage&, const IpAddress&, ProbeKey&);
+template portState TcpProtocol::parse<Ipv6Family>(const char*, size_t, const struct sockaddr_storage&, const IpAddress&, ProbeKey&);
+template portState UdpProtocol::parse<Ipv4Family>(const char*, size_t, const struct sockaddr_storage&, const IpAddress&, ProbeKey&);
+template portState UdpProtocol::parse<Ipv6Family>(const char*, size_t, const struct sockaddr_storage&, const IpAddress&, ProbeKey&);
+template portState UdpProtocol::parseDatagram<Ipv4Family>(const char*, size_t, const struct sockaddr_storage&, const IpAddress&, ProbeKey&);
+template portState UdpProtocol::parseDatagram<Ipv6Family>(const char*, size_t, const struct sockaddr_storage&, const IpAddress&, ProbeKey&);
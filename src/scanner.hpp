@@ -9,10 +9,28 @@
 #define SCANNER_HPP // SCANNER_HPP
 
 #include <iostream>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include "scanner_params.hpp"
+#include "scan_plan.hpp"
+#include "rate_limiter.hpp"
+#include "probe_template.hpp"
+#include "ip_address.hpp"
+#include "probe_table.hpp"
+#include "result_sink.hpp"
+#include "port_state.hpp"
+#include "checkpoint.hpp"
+#include "result_store.hpp"
+#include "baseline.hpp"
+#include "udp_payload.hpp"
+#include "udp_pacer.hpp"
 
 // Constants for max retrie of send packet on tcp protocol
 #define MAX_RETRIES 2
+// Constants for max retrie of send packet on udp protocol
+#define UDP_MAX_RETRIES 2
 // Constants for max recive buffer size
 #define MAX_BUFFER_SIZE 4096
 // Constants for max events in epoll
@@ -25,7 +43,7 @@
 /**
  * @brief Class for scanning ports
  * 
- * Parent class/Interface for classes TcpIpv4Scanner, TcpIpv6Scanner, UdpIpv4Scanner, UdpIpv6Scanner.
+ * Parent class/Interface for SequentialScanner (TcpIpv4Scanner, TcpIpv6Scanner, UdpIpv4Scanner, UdpIpv6Scanner) and asynchronous scanners.
  * This class is responsible for creating scan ports.
  */
 class Scanner{
@@ -42,7 +60,46 @@ class Scanner{
          * Only virtual method for scanning, will be implemented in child classes.
          */
         virtual void scan() = 0;
+        /**
+         * @brief Setter of writer of results
+         * 
+         * Without writer, results are printed to standard output in text format.
+         * 
+         * @param writer - buffered writer of results, it must live until end of scan
+         */
+        void setResultWriter(ResultWriter* writer) { this->resultWriter = writer; }
+        /**
+         * @brief Setter of checkpoint of resumable scan
+         * 
+         * With checkpoint, scan skips finished stages, continues from saved position and saves its progress periodically.
+         * 
+         * @param checkpoint - checkpoint of scan, it must live until end of scan
+         */
+        void setCheckpoint(Checkpoint* checkpoint) { this->checkpoint = checkpoint; }
+        /**
+         * @brief Setter of columnar store of results
+         * 
+         * @param store - store to which results are also written, it must live until end of scan
+         */
+        void setResultStore(ResultStore* store) { this->resultStore = store; }
+        /**
+         * @brief Setter of baseline of differential scan
+         * 
+         * With baseline, only results which differ from it are written, store and checkpoint get all results.
+         * 
+         * @param baseline - results of previous scan, it must live until end of scan
+         */
+        void setBaseline(const Baseline* baseline) { this->baseline = baseline; }
     protected:
+        /**
+         * @brief Method for reporting state of port
+         * 
+         * @param dst - scanned address
+         * @param port - scanned port
+         * @param state - state of port with protocol
+         * @param rtt - round trip time of reply (us), 0 if unknown
+         */
+        void writeResult(const IpAddress& dst, uint16_t port, portState state, uint32_t rtt = 0);
         /**
          * @brief Method for calculating checksum
          * 
@@ -79,116 +136,309 @@ class Scanner{
         void closeEpoll(int epollFd);
         // Object of ScannerParams with scan parameters
         ScannerParams scanParams;
+        // Scan parameters compiled to binary form once before scan
+        const ScanPlan plan;
+        // Pacer of sent packets, shared by all sends of scan
+        RateLimiter rateLimiter;
+        // Writer of results, nullptr for standard output
+        ResultWriter* resultWriter = nullptr;
+        // Checkpoint of resumable scan, nullptr for scan without checkpoint
+        Checkpoint* checkpoint = nullptr;
+        // Columnar store of results, nullptr for scan without store
+        ResultStore* resultStore = nullptr;
+        // Baseline of differential scan, nullptr for scan which reports all results
+        const Baseline* baseline = nullptr;
 };
 
 /**
- * @brief Class for scanning TCP ports with IPv4
- * 
- * Child class of Scanner for scanning TCP ports with IPv4.
+ * @brief Policy of IPv4 for SequentialScanner
+ *
+ * Raw IPv4 socket receives packets with IP header, ICMP errors quote IP header of variable length.
  */
-class TcpIpv4Scanner : public Scanner {
-    public:
-        /**
-         * @brief Construct a new TcpIpv4Scanner object
-         * 
-         * @param params - object of ScanParams with scan parameters
-         */
-        TcpIpv4Scanner(const ScannerParams& params);
-        /**
-         * @brief Method for scanning TCP ports with IPv4
-         * 
-         * Meethod will create and bind socket to interface and create epoll instance for timeout handling.
-         * For each destination IP address and port will create TCP header, pseudo header for checksum calculation and segment for checksum calculation.
-         * Will send part of segment(tcp header, cause ip header will be added by kernel) and wait for response.
-         * If response is received, will check validity of response. If response is valid, port will be marked as open or closed, it is indepeneed on response ([SYN, ACK] or RST)
-         * If timout is reached without response, part of segment will be send again.
-         * If valid response is not received after MAX_RETRIES, port will be marked as filtered.
-         * 
-         * @throw std::runtime_error if was detected interanl error of other function or system call or error with hadnling communication
-         */
-        void scan() override;
+struct Ipv4Family {
+    // Address family and protocol of ICMP errors
+    static constexpr int domain = AF_INET;
+    static constexpr int icmpProtocol = IPPROTO_ICMP;
+
+    /**
+     * @brief Method for getting IPv4 targets of plan
+     *
+     * @param plan - plan of scan
+     * @return generator of IPv4 addresses
+     */
+    static const TargetGenerator& targets(const ScanPlan& plan) { return plan.getIp4Targets(); }
+    /**
+     * @brief Method for finding transport header of packet received by raw socket of transport protocol
+     *
+     * @param buffer - received packet
+     * @param length - length of received packet
+     * @param from - socket address of sender
+     * @param local - address of interface, packet must be sent to it
+     * @param peer - sender of packet
+     * @param transportLen - length of transport header and data
+     * @return pointer to transport header, nullptr if packet is not for interface or is too short
+     */
+    static const char* transport(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, IpAddress& peer, size_t& transportLen);
+    /**
+     * @brief Method for finding packet quoted by ICMP port unreachable error
+     *
+     * @param buffer - packet received by ICMP socket
+     * @param length - length of received packet
+     * @param quotedSrc - source address of quoted packet
+     * @param quotedDst - destination address of quoted packet
+     * @param quotedLen - length of quoted transport header
+     * @return pointer to quoted transport header, nullptr if packet is not port unreachable error
+     */
+    static const char* portUnreachable(const char* buffer, size_t length, IpAddress& quotedSrc, IpAddress& quotedDst, size_t& quotedLen);
 };
 
 /**
- * @brief Class for scanning TCP ports with IPv6
- * 
- * Child class of Scanner for scanning TCP ports with IPv6.
+ * @brief Policy of IPv6 for SequentialScanner
+ *
+ * Raw IPv6 socket receives packets without IP header, ICMPv6 errors quote fixed IPv6 header.
  */
-class TcpIpv6Scanner : public Scanner {
-    public:
-        /**
-         * @brief Construct a new TcpIpv6Scanner object
-         * 
-         * @param params - object of ScanParams with scan parameters
-         */
-        TcpIpv6Scanner(const ScannerParams& params);
-        /**
-         * @brief Method for scanning TCP ports with IPv6
-         * 
-         * Meethod will create and bind socket to interface and create epoll instance for timeout handling.
-         * For each destination IP address and port will create TCP header, pseudo header for checksum calculation and segment for checksum calculation.
-         * Will send part of segment(tcp header, cause ip header will be added by kernel) and wait for response.
-         * If response is received, will check validity of response. If response is valid, port will be marked as open or closed, it is indepeneed on response ([SYN, ACK] or RST).
-         * If timout is reached without response, part of segment will be send again.
-         * If valid response is not received after MAX_RETRIES, port will be marked as filtered.
-         * 
-         * @throw std::runtime_error if was detected interanl error of other function or system call or error with hadnling communication
-         */
-        void scan() override;
+struct Ipv6Family {
+    // Address family and protocol of ICMP errors
+    static constexpr int domain = AF_INET6;
+    static constexpr int icmpProtocol = IPPROTO_ICMPV6;
+
+    /**
+     * @brief Method for getting IPv6 targets of plan
+     *
+     * @param plan - plan of scan
+     * @return generator of IPv6 addresses
+     */
+    static const TargetGenerator& targets(const ScanPlan& plan) { return plan.getIp6Targets(); }
+    /**
+     * @brief Method for finding transport header of packet received by raw socket of transport protocol
+     *
+     * @param buffer - received packet
+     * @param length - length of received packet
+     * @param from - socket address of sender
+     * @param local - address of interface, kernel delivers only packets sent to it
+     * @param peer - sender of packet
+     * @param transportLen - length of transport header and data
+     * @return pointer to transport header, nullptr if packet is too short
+     */
+    static const char* transport(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, IpAddress& peer, size_t& transportLen);
+    /**
+     * @brief Method for finding packet quoted by ICMPv6 port unreachable error
+     *
+     * @param buffer - packet received by ICMPv6 socket
+     * @param length - length of received packet
+     * @param quotedSrc - source address of quoted packet
+     * @param quotedDst - destination address of quoted packet
+     * @param quotedLen - length of quoted transport header
+     * @return pointer to quoted transport header, nullptr if packet is not port unreachable error
+     */
+    static const char* portUnreachable(const char* buffer, size_t length, IpAddress& quotedSrc, IpAddress& quotedDst, size_t& quotedLen);
 };
 
 /**
- * @brief Class for scanning UDP ports with IPv4
- * 
- * Child class of Scanner for scanning UDP ports with IPv4.
+ * @brief Policy of TCP for SequentialScanner
+ *
+ * SYN probe is retransmitted, SYN ACK reply means open port, RST reply closed port, no reply filtered port.
  */
-class UdpIpv4Scanner : public Scanner {
-    public:
-        /**
-         * @brief Construct a new UdpIpv4Scanner object
-         * 
-         * @param params - object of ScanParams with scan parameters
-         */
-        UdpIpv4Scanner(const ScannerParams& params);
-        /**
-         * @brief Method for scanning UDP ports with IPv4
-         * 
-         * Meethod will create and bind socket to interface and create epoll instance for timeout handling.
-         * For each destination IP address and port will create UDP header, pseudo header for checksum calculation and datagram for checksum calculation.
-         * Will send part of datagram(udp header, cause ip header will be added by kernel) and wait for response.
-         * If response is received, then is chacked validity of response.
-         * If response response is valid, and has right type of ICMP, then port will be marked as close, otherwise will be marked as open.
-         * 
-         * @throw std::runtime_error if was detected interanl error of other function or system call or error with hadnling communication
-         */
-        void scan() override;
+struct TcpProtocol {
+    // Protocol of probes, count of sends of probe and flag for replies received by ICMP socket
+    static constexpr int protocol = IPPROTO_TCP;
+    static constexpr int attempts = MAX_RETRIES;
+    static constexpr bool repliesByIcmp = false;
+    // Flag for replies of service received by socket of probes next to ICMP socket
+    static constexpr bool repliesByDatagram = false;
+    // Results of port without reply and of port whose probe was refused by kernel
+    static constexpr portState silentState = PORT_TCP_FILTERED;
+    static constexpr portState refusedState = PORT_TCP_FILTERED;
+    // Header of probe
+    typedef struct tcphdr Header;
+
+    /**
+     * @brief Method for getting TCP ports of plan
+     *
+     * @param plan - plan of scan
+     * @return array of TCP ports
+     */
+    static const std::vector<uint16_t>& ports(const ScanPlan& plan) { return plan.getTcpPorts(); }
+    /**
+     * @brief Method for building SYN probe from template
+     *
+     * @param probeTemplate - template with destination of probe
+     * @param srcPort - source port
+     * @param dstPort - destination port
+     * @param header - built header
+     * @return length of probe
+     */
+    static size_t build(const ProbeTemplate& probeTemplate, uint16_t srcPort, uint16_t dstPort, Header& header);
+    /**
+     * @brief Method for parsing reply to identification of probe which it answers
+     *
+     * @tparam Family - policy of address family
+     * @param buffer - packet received by TCP socket
+     * @param length - length of received packet
+     * @param from - socket address of sender
+     * @param local - address of interface
+     * @param probe - destination, destination port and source port of answered probe
+     * @return state of port, PORT_NONE if packet is not SYN-ACK or RST
+     */
+    template <typename Family>
+    static portState parse(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, ProbeKey& probe);
+    /**
+     * @brief Method for matching reply to probe
+     *
+     * @tparam Family - policy of address family
+     * @param buffer - packet received by TCP socket
+     * @param length - length of received packet
+     * @param from - socket address of sender
+     * @param local - address of interface
+     * @param dst - destination of probe
+     * @param dstPort - destination port of probe
+     * @param srcPort - source port of probe
+     * @return state of port, PORT_NONE if packet is not reply to probe
+     */
+    template <typename Family>
+    static portState match(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, const IpAddress& dst, uint16_t dstPort, uint16_t srcPort);
 };
 
 /**
- * @brief Class for scanning UDP ports with IPv6
- * 
- * Child class of Scanner for scanning UDP ports with IPv6.
+ * @brief Struct for UDP probe, header and payload of service of destination port
+ */
+struct UdpDatagram {
+    struct udphdr header;
+    uint8_t payload[UDP_PAYLOAD_MAX];
+};
+
+/**
+ * @brief Policy of UDP for SequentialScanner
+ *
+ * Datagram carries payload of service of port (UdpPayloads) and it is retransmitted. Reply of service means open port,
+ * ICMP port unreachable error closed port and no reply open or filtered port. ICMP errors are rate limited by targets,
+ * so probes of every target are paced by UdpPacer.
+ */
+struct UdpProtocol {
+    // Protocol of probes, count of sends of probe and flag for replies received by ICMP socket
+    static constexpr int protocol = IPPROTO_UDP;
+    static constexpr int attempts = UDP_MAX_RETRIES;
+    static constexpr bool repliesByIcmp = true;
+    // Flag for replies of service received by socket of probes next to ICMP socket
+    static constexpr bool repliesByDatagram = true;
+    // Results of port without reply and of port whose probe was refused by kernel, which is not reported
+    static constexpr portState silentState = PORT_UDP_OPEN_FILTERED;
+    static constexpr portState refusedState = PORT_NONE;
+    // Probe
+    typedef UdpDatagram Header;
+
+    /**
+     * @brief Method for getting UDP ports of plan
+     *
+     * @param plan - plan of scan
+     * @return array of UDP ports
+     */
+    static const std::vector<uint16_t>& ports(const ScanPlan& plan) { return plan.getUdpPorts(); }
+    /**
+     * @brief Method for building datagram probe from template, with payload of destination port
+     *
+     * @param probeTemplate - template with destination of probe
+     * @param srcPort - source port
+     * @param dstPort - destination port
+     * @param header - built datagram
+     * @return length of datagram
+     */
+    static size_t build(const ProbeTemplate& probeTemplate, uint16_t srcPort, uint16_t dstPort, Header& header);
+    /**
+     * @brief Method for parsing ICMP error to identification of probe which it answers
+     *
+     * @tparam Family - policy of address family
+     * @param buffer - packet received by ICMP socket
+     * @param length - length of received packet
+     * @param from - socket address of sender
+     * @param local - address of interface
+     * @param probe - destination, destination port and source port of answered probe
+     * @return state of port, PORT_NONE if packet is not port unreachable error caused by datagram of interface
+     */
+    template <typename Family>
+    static portState parse(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, ProbeKey& probe);
+    /**
+     * @brief Method for matching ICMP error to probe
+     *
+     * @tparam Family - policy of address family
+     * @param buffer - packet received by ICMP socket
+     * @param length - length of received packet
+     * @param from - socket address of sender
+     * @param local - address of interface
+     * @param dst - destination of probe
+     * @param dstPort - destination port of probe
+     * @param srcPort - source port of probe
+     * @return state of port, PORT_NONE if packet is not error caused by probe
+     */
+    template <typename Family>
+    static portState match(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, const IpAddress& dst, uint16_t dstPort, uint16_t srcPort);
+    /**
+     * @brief Method for parsing reply of service to identification of probe which it answers
+     *
+     * @tparam Family - policy of address family
+     * @param buffer - packet received by UDP socket
+     * @param length - length of received packet
+     * @param from - socket address of sender
+     * @param local - address of interface
+     * @param probe - destination, destination port and source port of answered probe
+     * @return state of port, PORT_NONE if packet is not UDP datagram sent to interface
+     */
+    template <typename Family>
+    static portState parseDatagram(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, ProbeKey& probe);
+    /**
+     * @brief Method for matching reply of service to probe
+     *
+     * @tparam Family - policy of address family
+     * @param buffer - packet received by UDP socket
+     * @param length - length of received packet
+     * @param from - socket address of sender
+     * @param local - address of interface
+     * @param dst - destination of probe
+     * @param dstPort - destination port of probe
+     * @param srcPort - source port of probe
+     * @return state of port, PORT_NONE if packet is not reply to probe
+     */
+    template <typename Family>
+    static portState matchDatagram(const char* buffer, size_t length, const struct sockaddr_storage& from, const IpAddress& local, const IpAddress& dst, uint16_t dstPort, uint16_t srcPort);
+};
+
+/**
+ * @brief Class for scanning ports one by one
+ *
+ * One engine for TCP and UDP over IPv4 and IPv6, parameterized by policy of address family and policy of protocol.
+ * Building of headers, matching of replies and checksums are resolved at compile time, there is no virtual call
+ * per probe. Each probe is sent and its reply is awaited before next probe, timeout is derived from round trip time.
+ *
+ * @tparam Family - Ipv4Family or Ipv6Family
+ * @tparam Protocol - TcpProtocol or UdpProtocol
  */
-class UdpIpv6Scanner : public Scanner {
+template <typename Family, typename Protocol>
+class SequentialScanner : public Scanner {
     public:
         /**
-         * @brief Construct a new UdpIpv6Scanner object
-         * 
+         * @brief Construct a new SequentialScanner object
+         *
          * @param params - object of ScanParams with scan parameters
          */
-        UdpIpv6Scanner(const ScannerParams& params);
-         /**
-         * @brief Method for scanning UDP ports with IPv6
-         * 
-         * Meethod will create and bind socket to interface and create epoll instance for timeout handling.
-         * For each destination IP address and port will create UDP header, pseudo header for checksum calculation and datagram for checksum calculation.
-         * Will send part of datagram(udp header, cause ip header will be added by kernel) and wait for response.
-         * If response is received, then is chacked validity of response.
-         * If response response is valid, and has right type of ICMP, then port will be marked as close, otherwise will be marked as open.
-         * 
+        SequentialScanner(const ScannerParams& params);
+        /**
+         * @brief Method for scanning ports
+         *
+         * Method will create and bind socket of protocol (and ICMP socket for UDP) to interface and create epoll instance for timeout handling.
+         * For each destination IP address and port will build header of probe from template, send it and wait for reply.
+         * TCP probe without valid reply is sent again and after MAX_RETRIES port is marked as filtered,
+         * UDP port with reply of service is marked as open at once and port without reply or ICMP error after UDP_MAX_RETRIES
+         * as open|filtered. UDP probes of destination are paced by cadence of its ICMP errors (UdpPacer).
+         *
          * @throw std::runtime_error if was detected interanl error of other function or system call or error with hadnling communication
          */
         void scan() override;
 };
 
+// Scanners of TCP and UDP ports with IPv4 and IPv6
+typedef SequentialScanner<Ipv4Family, TcpProtocol> TcpIpv4Scanner;
+typedef SequentialScanner<Ipv6Family, TcpProtocol> TcpIpv6Scanner;
+typedef SequentialScanner<Ipv4Family, UdpProtocol> UdpIpv4Scanner;
+typedef SequentialScanner<Ipv6Family, UdpProtocol> UdpIpv6Scanner;
+
 #endif // SCANNER_HPP
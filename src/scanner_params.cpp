@@ -16,21 +16,26 @@
 #include <net/if.h>
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <sys/random.h>
+#include <fstream>
+#include <sstream>
+#include "ip_address.hpp"
+#include "result_sink.hpp"
 
 // Constructor of the class ScannerParams
 
-ScannerParams::ScannerParams(std::string parsedInterface, std::string parseDomain, std::string parseTcpPorts, std::string parsedUdpPorts, std::string parseTimeout){
+ScannerParams::ScannerParams(std::string parsedInterface, std::string parseDomain, std::string parsedTargetList, std::string parseTcpPorts, std::string parsedUdpPorts, std::string parseTimeout, std::string parsedDnsCache){
     // Initialize all attributes to default values and call the setters
     this->interfaceName = parsedInterface;
     this->interfaceIpv4 = "";
     this->interfaceIpv6 = "";
-    this->ip4AddrDest = {};
-    this->ip6AddrDest = {};
+    this->ip4AddrDest = TargetGenerator();
+    this->ip6AddrDest = TargetGenerator();
     this->timeout = DEFAULT_TIMEOUT;
     this->tcpPorts = {};
     this->udpPorts = {};
 
-    this->setAddrsDest(parseDomain);
+    this->setAddrsDest(parseDomain, parsedTargetList, parsedDnsCache);
     this->setTimeout(parseTimeout);
     this->setPorts(parseTcpPorts, parsedUdpPorts);
     this->setInterfaceIpv();
@@ -42,11 +47,11 @@ std::string ScannerParams::getInterfaceName(){
     return this->interfaceName;
 }
 
-std::unordered_set<std::string> ScannerParams::getIp4AddrDest(){
+const TargetGenerator& ScannerParams::getIp4AddrDest(){
     return this->ip4AddrDest;
 }
 
-std::unordered_set<std::string> ScannerParams::getIp6AddrDest(){
+const TargetGenerator& ScannerParams::getIp6AddrDest(){
     return this->ip6AddrDest;
 }
 
@@ -54,11 +59,11 @@ int ScannerParams::getTimeout(){
     return this->timeout;
 }
 
-std::vector<int> ScannerParams::getTcpPorts(){
+const std::vector<int>& ScannerParams::getTcpPorts(){
     return this->tcpPorts;
 }
 
-std::vector<int> ScannerParams::getUdpPorts(){
+const std::vector<int>& ScannerParams::getUdpPorts(){
     return this->udpPorts;
 }
 
@@ -70,6 +75,244 @@ std::string ScannerParams::getInterfaceIpv6(){
     return this->interfaceIpv6;
 }
 
+bool ScannerParams::isAsyncMode(){
+    return this->asyncMode;
+}
+
+bool ScannerParams::isStatelessMode(){
+    return this->statelessMode;
+}
+
+// Setter for set the asynchronous mode
+
+void ScannerParams::setAsyncMode(bool asyncMode){
+    this->asyncMode = asyncMode;
+}
+
+// Setter for set the stateless mode
+
+void ScannerParams::setStatelessMode(bool statelessMode){
+    this->statelessMode = statelessMode;
+}
+
+bool ScannerParams::isBatchMode(){
+    return this->batchMode;
+}
+
+// Setter for set the batch mode
+
+void ScannerParams::setBatchMode(bool batchMode){
+    this->batchMode = batchMode;
+}
+
+bool ScannerParams::isRxRingMode(){
+    return this->rxRingMode;
+}
+
+// Setter for set the receive ring mode
+
+void ScannerParams::setRxRingMode(bool rxRingMode){
+    this->rxRingMode = rxRingMode;
+}
+
+bool ScannerParams::isTxRingMode(){
+    return this->txRingMode;
+}
+
+bool ScannerParams::isQdiscBypass(){
+    return this->qdiscBypass;
+}
+
+// Setter for set the transmit ring mode
+
+void ScannerParams::setTxRingMode(bool txRingMode){
+    this->txRingMode = txRingMode;
+}
+
+// Setter for set the bypass of queueing discipline
+
+void ScannerParams::setQdiscBypass(bool qdiscBypass){
+    this->qdiscBypass = qdiscBypass;
+}
+
+uint64_t ScannerParams::getRate(){
+    return this->rate;
+}
+
+uint64_t ScannerParams::getBurst(){
+    return this->burst;
+}
+
+unsigned ScannerParams::getThreads(){
+    return this->threads;
+}
+
+uint64_t ScannerParams::getSeed(){
+    return this->seed;
+}
+
+// Setter for set the rate
+
+void ScannerParams::setRate(std::string parsedRate){
+    // If the rate was not pasted, use the default
+    if (parsedRate.empty()){
+        this->rate = DEFAULT_RATE;
+        return;
+    }
+    // Regular expression for the rate, max 9 digits
+    std::regex rateReg("^[1-9][0-9]{0,8}$");
+    // Check if the pasted rate is valid, if yes, then set the rate
+    if(std::regex_match(parsedRate, rateReg)) this->rate = std::stoull(parsedRate);
+    else throw std::invalid_argument("");
+}
+
+// Setter for set the burst
+
+void ScannerParams::setBurst(std::string parsedBurst){
+    // If the burst was not pasted, use the default
+    if (parsedBurst.empty()){
+        this->burst = DEFAULT_BURST;
+        return;
+    }
+    // Regular expression for the burst, max 9 digits
+    std::regex burstReg("^[1-9][0-9]{0,8}$");
+    // Check if the pasted burst is valid, if yes, then set the burst
+    if(std::regex_match(parsedBurst, burstReg)) this->burst = std::stoull(parsedBurst);
+    else throw std::invalid_argument("");
+}
+
+// Setter for set the count of threads
+
+void ScannerParams::setThreads(std::string parsedThreads){
+    // If the count of threads was not pasted, use the default
+    if (parsedThreads.empty()){
+        this->threads = DEFAULT_THREADS;
+        return;
+    }
+    // Regular expression for the count of threads, max 2 digits
+    std::regex threadsReg("^[1-9][0-9]?$");
+    // Check if the pasted count is valid and not above the max, if yes, then set the count of threads
+    if(std::regex_match(parsedThreads, threadsReg) && std::stoul(parsedThreads) <= MAX_THREADS) this->threads = std::stoul(parsedThreads);
+    else throw std::invalid_argument("");
+}
+
+// Setter for set the seed
+
+void ScannerParams::setSeed(std::string parsedSeed){
+    // If the seed was not pasted, every scan has other order
+    if (parsedSeed.empty()){
+        if (getrandom(&this->seed, sizeof(this->seed), 0) != (ssize_t)sizeof(this->seed)) throw std::runtime_error("Getrandom failed!");
+        return;
+    }
+    // Regular expression for the seed, max 19 digits
+    std::regex seedReg("^[0-9]{1,19}$");
+    // Check if the pasted seed is valid, if yes, then set the seed
+    if(std::regex_match(parsedSeed, seedReg)) this->seed = std::stoull(parsedSeed);
+    else throw std::invalid_argument("");
+}
+
+// Setter for set the seed of resumed scan
+
+void ScannerParams::setSeed(uint64_t restoredSeed){
+    this->seed = restoredSeed;
+}
+
+bool ScannerParams::isConcurrentMode(){
+    return this->concurrentMode;
+}
+
+// Setter for set the concurrent mode
+
+void ScannerParams::setConcurrentMode(bool concurrentMode){
+    this->concurrentMode = concurrentMode;
+}
+
+std::string ScannerParams::getOutputFormat(){
+    return this->outputFormat;
+}
+
+// Setter for set the output format
+
+void ScannerParams::setOutputFormat(std::string parsedFormat){
+    // If the format was not pasted, use the default
+    if (parsedFormat.empty()){
+        this->outputFormat = DEFAULT_OUTPUT_FORMAT;
+        return;
+    }
+    // Check if the pasted format is known, if yes, then set the format
+    if (ResultSink::isFormat(parsedFormat)) this->outputFormat = parsedFormat;
+    else throw std::invalid_argument("");
+}
+
+std::string ScannerParams::getResumeFile(){
+    return this->resumeFile;
+}
+
+// Setter for set the resume file
+
+void ScannerParams::setResumeFile(std::string parsedResumeFile){
+    this->resumeFile = parsedResumeFile;
+}
+
+std::string ScannerParams::getStoreFile(){
+    return this->storeFile;
+}
+
+// Setter for set the store file
+
+void ScannerParams::setStoreFile(std::string parsedStoreFile){
+    this->storeFile = parsedStoreFile;
+}
+
+std::string ScannerParams::getBaselineFile(){
+    return this->baselineFile;
+}
+
+// Setter for set the baseline file
+
+void ScannerParams::setBaselineFile(std::string parsedBaselineFile){
+    this->baselineFile = parsedBaselineFile;
+}
+
+bool ScannerParams::isChangedFirst(){
+    return this->changedFirst;
+}
+
+// Setter for set the changed first mode
+
+void ScannerParams::setChangedFirst(bool changedFirst){
+    this->changedFirst = changedFirst;
+}
+
+bool ScannerParams::isConnectMode(){
+    return this->connectMode;
+}
+
+// Setter for set the connect mode
+
+void ScannerParams::setConnectMode(bool connectMode){
+    this->connectMode = connectMode;
+}
+
+unsigned ScannerParams::getConnectWindow(){
+    return this->connectWindow;
+}
+
+// Setter for set the connect window
+
+void ScannerParams::setConnectWindow(std::string parsedConnectWindow){
+    // If the connect window was not pasted, use the default
+    if (parsedConnectWindow.empty()){
+        this->connectWindow = DEFAULT_CONNECT_WINDOW;
+        return;
+    }
+    // Regular expression for the connect window, max 5 digits
+    std::regex windowReg("^[1-9][0-9]{0,4}$");
+    // Check if the pasted window is valid and not above the max, if yes, then set the connect window
+    if(std::regex_match(parsedConnectWindow, windowReg) && std::stoul(parsedConnectWindow) <= MAX_CONNECT_WINDOW) this->connectWindow = std::stoul(parsedConnectWindow);
+    else throw std::invalid_argument("");
+}
+
 // Method for converting the ports
 
 std::vector<int> ScannerParams::convertPorts(std::string convertPorts){
@@ -174,48 +417,82 @@ void ScannerParams::setInterfaceIpv(){
     if (this->interfaceIpv4.empty() && this->interfaceIpv6.empty()) throw std::invalid_argument("");
 }
 
-// Setter for set the destination address of domain
+// Setter for set the destination addresses of targets
 
-void ScannerParams::setAddrsDest(std::string domain){
+void ScannerParams::setAddrsDest(std::string domain, std::string targetList, std::string dnsCache){
     
-    // If the domain is empty, then was not pasted and the domain is invalid
-    if (domain.empty()) throw std::invalid_argument("");
+    // If the domain and list are empty, then target was not pasted and the input is invalid
+    if (domain.empty() && targetList.empty()) throw std::invalid_argument("");
     
-    // Get the list of addresses by the domain
-    struct addrinfo hints, *listOfAddrInfo;
-    memset(&hints, 0, sizeof(hints));
-    hints.ai_family = AF_UNSPEC;
-    int retVal = getaddrinfo(domain.c_str(), nullptr, &hints, &listOfAddrInfo);
-    
-    // Check the return value of getaddrinfo -> NONAME <=> invalid domain name or internal error
-    if(retVal == EAI_NONAME) throw std::invalid_argument("");
-    else if(retVal || listOfAddrInfo == nullptr) throw std::runtime_error("Internal error of getaddrinfo!");
+    // Collect target from the command line and targets from the list
+    std::vector<std::string> targets;
+    if (!domain.empty()) targets.push_back(domain);
+    if (!targetList.empty()) this->readTargetList(targetList, targets);
+
+    // Resolve domain names of all targets at once, addresses, CIDR blocks and ranges are not resolved
+    std::vector<std::string> names;
+    TargetRange range;
+    for (const std::string& target : targets) {
+        if (!TargetGenerator::parse(target, range)) names.push_back(target);
+    }
+    DnsResolver resolver(dnsCache);
+    std::unordered_map<std::string, DnsResult> resolved = resolver.resolve(names);
 
-    // Iterate over the list of addresses and find the ipv4 and ipv6 addresses
-    void* addr = nullptr;
-    for (struct addrinfo* element = listOfAddrInfo; element != nullptr; element = element->ai_next) {
-        // Ipv4
-        if (element->ai_family == AF_INET) {
-            sockaddr_in* ipv4 = (sockaddr_in*)(element->ai_addr);
-            addr = &(ipv4->sin_addr);
-            char ipv[INET_ADDRSTRLEN];
-            inet_ntop(element->ai_family, addr, ipv, INET_ADDRSTRLEN);
-            this->ip4AddrDest.insert(std::string(ipv));
+    // Add targets
+    for (const std::string& target : targets) this->addTarget(target, resolved);
+    // Duplicate addresses (hostname and its address, overlapping blocks, repeated lines) are scanned once
+    this->ip4AddrDest.normalize();
+    this->ip6AddrDest.normalize();
+
+    // If the addresses were not found, then the targets are invalid -> invalid argument
+    if(this->ip4AddrDest.empty() && this->ip6AddrDest.empty()) throw std::invalid_argument("");
+}
+
+// Method for adding one target
+
+void ScannerParams::addTarget(const std::string& target, const std::unordered_map<std::string, DnsResult>& resolved){
+
+    // Address, CIDR block or range is added as range of addresses without resolving
+    TargetRange range;
+    if (TargetGenerator::parse(target, range)) {
+        if (range.first.family == AF_INET) this->ip4AddrDest.add(range.first, range.count);
+        else this->ip6AddrDest.add(range.first, range.count);
+        return;
+    }
+
+    // Check the result of resolution -> NONAME <=> invalid domain name or internal error
+    const DnsResult& result = resolved.at(target);
+    if (result.status == DNS_NO_NAME) throw std::invalid_argument("");
+    else if (result.status == DNS_FAILED) throw std::runtime_error("Internal error of getaddrinfo!");
 
+    // Add the ipv4 and ipv6 addresses
+    for (const IpAddress& address : result.addresses) {
+        // Ipv4
+        if (address.family == AF_INET) this->ip4AddrDest.add(address, 1);
         // Ipv6
-        } else if(element->ai_family == AF_INET6){
-            sockaddr_in6* ipv6 = (sockaddr_in6*)(element->ai_addr);
-            addr = &(ipv6->sin6_addr);
-            char ipv[INET6_ADDRSTRLEN];
-            inet_ntop(element->ai_family, addr, ipv, INET6_ADDRSTRLEN);
-            this->ip6AddrDest.insert(std::string(ipv));
-        }
+        else this->ip6AddrDest.add(address, 1);
     }
+}
 
-    // Free the list of addresses
-    freeaddrinfo(listOfAddrInfo);
-    // If the addresses were not found, then the domain is invalid -> invalid argument
-    if(this->ip4AddrDest.empty() && this->ip6AddrDest.empty()) throw std::invalid_argument("");
+// Method for reading the list of targets
+
+void ScannerParams::readTargetList(std::string targetList, std::vector<std::string>& targets){
+
+    // Open the file, "-" is the standard input
+    std::ifstream file;
+    if (targetList != "-") {
+        file.open(targetList);
+        if (!file.is_open()) throw std::invalid_argument("");
+    }
+    std::istream& input = targetList == "-" ? std::cin : file;
+
+    // Every line can contain more targets separated by white space and comment after #
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream lineTargets(line.substr(0, line.find('#')));
+        std::string target;
+        while (lineTargets >> target) targets.push_back(target);
+    }
 }
 
 // Setter for set the timeout
@@ -12,9 +12,25 @@
 #include <string>
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
+#include <cstdint>
+#include "target_generator.hpp"
+#include "dns_resolver.hpp"
 
 // Default timeout for the scanner
 #define DEFAULT_TIMEOUT 5000
+// Default rate of sent packets, 0 is without limit
+#define DEFAULT_RATE 0
+// Default count of packets which can be sent at once
+#define DEFAULT_BURST 1
+// Default and max count of scanning threads
+#define DEFAULT_THREADS 1
+#define MAX_THREADS 64
+// Default and max count of connections of connect scan opened at once
+#define DEFAULT_CONNECT_WINDOW 4096
+#define MAX_CONNECT_WINDOW 65536
+// Default format of results
+#define DEFAULT_OUTPUT_FORMAT "text"
 
 /**
  * @class ScannerParams
@@ -38,13 +54,15 @@ class ScannerParams{
          * Constructor of the class ScannerParams, initializes all attributes to values parsed from the input arguments.
          * 
          * @param parsedInterface - name of the interface
-         * @param parseDomain - domain name
+         * @param parseDomain - domain name, address, CIDR block or range of addresses
+         * @param parsedTargetList - path of file with list of targets, "-" for standard input
          * @param parseTcpPorts - TCP ports
          * @param parsedUdpPorts - UDP ports
          * @param parseTimeout - timeout
+         * @param parsedDnsCache - path of file with cache of resolved domain names, empty for no cache
          * 
          */
-        ScannerParams(std::string parsedInterface, std::string parseDomain, std::string parseTcpPorts, std::string parsedUdpPorts, std::string parseTimeout);
+        ScannerParams(std::string parsedInterface, std::string parseDomain, std::string parsedTargetList, std::string parseTcpPorts, std::string parsedUdpPorts, std::string parseTimeout, std::string parsedDnsCache);
 
         /**
          * @brief Getter of the name of the interface
@@ -55,21 +73,21 @@ class ScannerParams{
          */
         std::string getInterfaceName();
         /**
-         * @brief Getter of the set of IPv4 addresses
+         * @brief Getter of the IPv4 addresses
          * 
-         * Method for getting the set of IPv4 addresses
+         * Method for getting the generator of IPv4 addresses
          * 
-         * @return set of IPv4 addresses
+         * @return generator of IPv4 addresses
          */
-        std::unordered_set<std::string> getIp4AddrDest();
+        const TargetGenerator& getIp4AddrDest();
         /**
-         * @brief Getter of the set of IPv6 addresses
+         * @brief Getter of the IPv6 addresses
          * 
-         * Method for getting the set of IPv6 addresses
+         * Method for getting the generator of IPv6 addresses
          * 
-         * @return set of IPv6 addresses
+         * @return generator of IPv6 addresses
          */
-        std::unordered_set<std::string> getIp6AddrDest();
+        const TargetGenerator& getIp6AddrDest();
         /**
          * @brief Getter of the timeout
          * 
@@ -85,7 +103,7 @@ class ScannerParams{
          * 
          * @return vector of TCP ports
          */
-        std::vector<int> getTcpPorts();
+        const std::vector<int>& getTcpPorts();
         /**
          * @brief Getter of the vector of UDP ports
          * 
@@ -93,7 +111,7 @@ class ScannerParams{
          * 
          * @return vector of UDP ports
          */
-        std::vector<int> getUdpPorts();
+        const std::vector<int>& getUdpPorts();
         /**
          * @brief Getter of the IPv4 address of the interface
          * 
@@ -110,19 +128,354 @@ class ScannerParams{
          * @return IPv6 address of the interface
          */
         std::string getInterfaceIpv6();
+        /**
+         * @brief Getter of the asynchronous mode
+         * 
+         * Method for getting if the TCP ports are scanned by pipelined asynchronous scanner
+         * 
+         * @return true if asynchronous mode is set, false otherwise
+         */
+        bool isAsyncMode();
+        /**
+         * @brief Setter of the asynchronous mode
+         * 
+         * Method for setting if the TCP ports are scanned by pipelined asynchronous scanner
+         * 
+         * @param asyncMode - true for asynchronous mode
+         */
+        void setAsyncMode(bool asyncMode);
+        /**
+         * @brief Getter of the stateless mode
+         * 
+         * Method for getting if the asynchronous scanner attributes replies only by cookies without table of probes
+         * 
+         * @return true if stateless mode is set, false otherwise
+         */
+        bool isStatelessMode();
+        /**
+         * @brief Setter of the stateless mode
+         * 
+         * Method for setting if the asynchronous scanner attributes replies only by cookies without table of probes
+         * 
+         * @param statelessMode - true for stateless mode
+         */
+        void setStatelessMode(bool statelessMode);
+        /**
+         * @brief Getter of the batch mode
+         * 
+         * Method for getting if the asynchronous scanner sends and receives packets in batches by sendmmsg and recvmmsg
+         * 
+         * @return true if batch mode is set, false otherwise
+         */
+        bool isBatchMode();
+        /**
+         * @brief Setter of the batch mode
+         * 
+         * Method for setting if the asynchronous scanner sends and receives packets in batches by sendmmsg and recvmmsg
+         * 
+         * @param batchMode - true for batch mode
+         */
+        void setBatchMode(bool batchMode);
+        /**
+         * @brief Getter of the receive ring mode
+         * 
+         * Method for getting if the asynchronous scanner receives replies by memory mapped ring of the interface
+         * 
+         * @return true if receive ring mode is set, false otherwise
+         */
+        bool isRxRingMode();
+        /**
+         * @brief Setter of the receive ring mode
+         * 
+         * Method for setting if the asynchronous scanner receives replies by memory mapped ring of the interface
+         * 
+         * @param rxRingMode - true for receive ring mode
+         */
+        void setRxRingMode(bool rxRingMode);
+        /**
+         * @brief Getter of the transmit ring mode
+         * 
+         * Method for getting if the asynchronous scanner sends complete frames by memory mapped ring of the interface
+         * 
+         * @return true if transmit ring mode is set, false otherwise
+         */
+        bool isTxRingMode();
+        /**
+         * @brief Setter of the transmit ring mode
+         * 
+         * Method for setting if the asynchronous scanner sends complete frames by memory mapped ring of the interface
+         * 
+         * @param txRingMode - true for transmit ring mode
+         */
+        void setTxRingMode(bool txRingMode);
+        /**
+         * @brief Getter of the bypass of queueing discipline
+         * 
+         * Method for getting if the frames of transmit ring are handed directly to driver of the interface
+         * 
+         * @return true if queueing discipline is bypassed, false otherwise
+         */
+        bool isQdiscBypass();
+        /**
+         * @brief Setter of the bypass of queueing discipline
+         * 
+         * Method for setting if the frames of transmit ring are handed directly to driver of the interface
+         * 
+         * @param qdiscBypass - true for bypass of queueing discipline
+         */
+        void setQdiscBypass(bool qdiscBypass);
+        /**
+         * @brief Getter of the rate
+         * 
+         * Method for getting the max count of sent packets per second
+         * 
+         * @return rate, 0 if rate is not limited
+         */
+        uint64_t getRate();
+        /**
+         * @brief Setter of the rate
+         * 
+         * Method for setting the max count of sent packets per second
+         * 
+         * @param parsedRate - parsed rate from the inputed arguments, empty for default
+         * 
+         * @throws std::invalid_argument if the rate is invalid
+         */
+        void setRate(std::string parsedRate);
+        /**
+         * @brief Getter of the burst
+         * 
+         * Method for getting the max count of packets sent at once by the rate limiter
+         * 
+         * @return burst
+         */
+        uint64_t getBurst();
+        /**
+         * @brief Setter of the burst
+         * 
+         * Method for setting the max count of packets sent at once by the rate limiter
+         * 
+         * @param parsedBurst - parsed burst from the inputed arguments, empty for default
+         * 
+         * @throws std::invalid_argument if the burst is invalid
+         */
+        void setBurst(std::string parsedBurst);
+        /**
+         * @brief Getter of the threads
+         * 
+         * Method for getting the count of sender threads, which share the scanned ports of asynchronous scanner
+         * 
+         * @return count of threads
+         */
+        unsigned getThreads();
+        /**
+         * @brief Setter of the threads
+         * 
+         * Method for setting the count of sender threads, which share the scanned ports of asynchronous scanner
+         * 
+         * @param parsedThreads - parsed count of threads from the inputed arguments, empty for default
+         * 
+         * @throws std::invalid_argument if the count of threads is invalid
+         */
+        void setThreads(std::string parsedThreads);
+        /**
+         * @brief Getter of the seed
+         * 
+         * Method for getting the seed of the pseudo-random order of probes of asynchronous, concurrent and connect scanner
+         * 
+         * @return seed
+         */
+        uint64_t getSeed();
+        /**
+         * @brief Setter of the seed
+         * 
+         * Method for setting the seed of the pseudo-random order of probes of asynchronous, concurrent and connect scanner
+         * 
+         * @param parsedSeed - parsed seed from the inputed arguments, empty for random seed
+         * 
+         * @throws std::invalid_argument if the seed is invalid
+         * @throws std::runtime_error if the random seed cannot be obtained
+         */
+        void setSeed(std::string parsedSeed);
+        /**
+         * @brief Setter of the seed
+         * 
+         * Method for setting the seed restored from checkpoint of resumed scan
+         * 
+         * @param restoredSeed - seed of scan which is resumed
+         */
+        void setSeed(uint64_t restoredSeed);
+        /**
+         * @brief Getter of the concurrent mode
+         * 
+         * Method for getting if TCP and UDP ports of IPv4 and IPv6 targets are scanned at once in one event loop
+         * 
+         * @return true if concurrent mode is set, false otherwise
+         */
+        bool isConcurrentMode();
+        /**
+         * @brief Setter of the concurrent mode
+         * 
+         * Method for setting if TCP and UDP ports of IPv4 and IPv6 targets are scanned at once in one event loop
+         * 
+         * @param concurrentMode - true for concurrent mode
+         */
+        void setConcurrentMode(bool concurrentMode);
+        /**
+         * @brief Getter of the output format
+         * 
+         * Method for getting the format of results -> text, ndjson, csv or binary
+         * 
+         * @return name of output format
+         */
+        std::string getOutputFormat();
+        /**
+         * @brief Setter of the output format
+         * 
+         * Method for setting the format of results
+         * 
+         * @param parsedFormat - parsed output format from the inputed arguments, empty for text format
+         * 
+         * @throws std::invalid_argument if the format is unknown
+         */
+        void setOutputFormat(std::string parsedFormat);
+        /**
+         * @brief Getter of the resume file
+         * 
+         * Method for getting the path of file with checkpoint of resumable scan
+         * 
+         * @return path of checkpoint, empty if scan is not resumable
+         */
+        std::string getResumeFile();
+        /**
+         * @brief Setter of the resume file
+         * 
+         * Method for setting the path of file with checkpoint of resumable scan
+         * 
+         * @param parsedResumeFile - parsed path of checkpoint from the inputed arguments, empty for scan without checkpoint
+         */
+        void setResumeFile(std::string parsedResumeFile);
+        /**
+         * @brief Getter of the store file
+         * 
+         * Method for getting the path of columnar store of results
+         * 
+         * @return path of result store, empty if results are not stored
+         */
+        std::string getStoreFile();
+        /**
+         * @brief Setter of the store file
+         * 
+         * Method for setting the path of columnar store of results
+         * 
+         * @param parsedStoreFile - parsed path of result store from the inputed arguments, empty for no store
+         */
+        void setStoreFile(std::string parsedStoreFile);
+        /**
+         * @brief Getter of the baseline file
+         * 
+         * Method for getting the path of result store of previous scan, only changes against it are reported
+         * 
+         * @return path of baseline, empty if all results are reported
+         */
+        std::string getBaselineFile();
+        /**
+         * @brief Setter of the baseline file
+         * 
+         * Method for setting the path of result store of previous scan, only changes against it are reported
+         * 
+         * @param parsedBaselineFile - parsed path of baseline from the inputed arguments, empty for scan without baseline
+         */
+        void setBaselineFile(std::string parsedBaselineFile);
+        /**
+         * @brief Getter of the changed first mode
+         * 
+         * Method for getting if probes of ports which differed in previous scan are sent before the others
+         * 
+         * @return true if changed first mode is set, false otherwise
+         */
+        bool isChangedFirst();
+        /**
+         * @brief Setter of the changed first mode
+         * 
+         * Method for setting if probes of ports which differed in previous scan are sent before the others
+         * 
+         * @param changedFirst - true for changed first mode
+         */
+        void setChangedFirst(bool changedFirst);
+        /**
+         * @brief Getter of the connect mode
+         * 
+         * Method for getting if TCP ports are scanned by non-blocking connect, which does not need raw sockets
+         * 
+         * @return true if connect mode is set, false otherwise
+         */
+        bool isConnectMode();
+        /**
+         * @brief Setter of the connect mode
+         * 
+         * Method for setting if TCP ports are scanned by non-blocking connect, which does not need raw sockets
+         * 
+         * @param connectMode - true for connect mode
+         */
+        void setConnectMode(bool connectMode);
+        /**
+         * @brief Getter of the connect window
+         * 
+         * Method for getting the max count of connections of connect scan opened at once
+         * 
+         * @return connect window
+         */
+        unsigned getConnectWindow();
+        /**
+         * @brief Setter of the connect window
+         * 
+         * Method for setting the max count of connections of connect scan opened at once
+         * 
+         * @param parsedConnectWindow - parsed connect window from the inputed arguments, empty for default
+         * 
+         * @throws std::invalid_argument if the connect window is invalid
+         */
+        void setConnectWindow(std::string parsedConnectWindow);
         
     private:
         /**
          * @brief Setter of the destination addresses
          * 
-         * Method for setting the destination addresses -> vector of IPv4 and IPv6 addresses
+         * Method for setting the destination addresses -> generators of IPv4 and IPv6 addresses
+         * Domain names of all targets are resolved at once by DnsResolver, then targets are added in their order
+         * 
+         * @param domain - target from the command line, empty if not pasted
+         * @param targetList - path of file with list of targets, empty if not pasted
+         * @param dnsCache - path of file with cache of resolved domain names, empty for no cache
+         * 
+         * @throws std::invalid_argument if no target was pasted or some target is invalid
+         * @throws std::runtime_error if the internal error of resolver or the cache cannot be written
+         */
+        void setAddrsDest(std::string domain, std::string targetList, std::string dnsCache);
+        /**
+         * @brief Method for adding one target
+         * 
+         * Method for adding address, CIDR block or range of addresses, other target is domain name with resolved addresses
+         * 
+         * @param target - target in text form
+         * @param resolved - results of resolution of domain names of targets
+         * 
+         * @throws std::invalid_argument if the target is invalid
+         * @throws std::runtime_error if the internal error of resolver
+         */
+        void addTarget(const std::string& target, const std::unordered_map<std::string, DnsResult>& resolved);
+        /**
+         * @brief Method for reading the list of targets
+         * 
+         * Method for reading targets from file, targets are separated by white space and # starts comment until end of line
          * 
-         * @param domain - domain name for resolved
+         * @param targetList - path of file, "-" for standard input
+         * @param targets - vector to which targets in text form are appended
          * 
-         * @throws std::invalid_argument if the domain name is invalid
-         * @throws std::runtime_error if the internal error of getaddrinfo or inet_ntop
+         * @throws std::invalid_argument if the file cannot be read
          */
-        void setAddrsDest(std::string domain);
+        void readTargetList(std::string targetList, std::vector<std::string>& targets);
         /**
          * @brief Setter of the timeout
          * 
@@ -166,13 +519,31 @@ class ScannerParams{
 
         // Attributes of the class
         std::string interfaceName;
-        std::unordered_set<std::string> ip4AddrDest;
-        std::unordered_set<std::string> ip6AddrDest;
+        TargetGenerator ip4AddrDest;
+        TargetGenerator ip6AddrDest;
         int timeout;
         std::vector<int> tcpPorts;
         std::vector<int>  udpPorts;
         std::string interfaceIpv4;
         std::string interfaceIpv6;
+        bool asyncMode = false;
+        bool statelessMode = false;
+        bool batchMode = false;
+        bool rxRingMode = false;
+        bool txRingMode = false;
+        bool qdiscBypass = false;
+        uint64_t rate = DEFAULT_RATE;
+        uint64_t burst = DEFAULT_BURST;
+        unsigned threads = DEFAULT_THREADS;
+        uint64_t seed = 0;
+        bool concurrentMode = false;
+        std::string outputFormat = DEFAULT_OUTPUT_FORMAT;
+        std::string resumeFile;
+        std::string storeFile;
+        std::string baselineFile;
+        bool changedFirst = false;
+        bool connectMode = false;
+        unsigned connectWindow = DEFAULT_CONNECT_WINDOW;
 
 };
 
@@ -0,0 +1,150 @@
+/**
+ * @file socket_filter.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of classic BPF filters of receiving sockets
+ */
+
+#include "socket_filter.hpp"
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+// Constants for return value of filter, which accepts whole packet
+#define FILTER_ACCEPT 0xFFFFFFFF
+// Constants for ICMP type and code of port unreachable
+#define ICMP_TYPE_UNREACH 3
+#define ICMP_CODE_PORT_UNREACH 3
+#define ICMPV6_TYPE_UNREACH 1
+#define ICMPV6_CODE_PORT_UNREACH 4
+// Constants for mark of jump to reject, which is resolved when program is finished
+#define JUMP_REJECT 0xFF
+
+// Method for generating filter of raw socket of scanner
+
+std::vector<struct sock_filter> SocketFilter::forRawSocket(int ipvType, int protocol, uint16_t minPort, uint16_t maxPort) {
+    if (protocol == IPPROTO_TCP) return tcpReplies(ipvType, ipvType == AF_INET, minPort, maxPort);
+    if (protocol == IPPROTO_UDP) return udpReplies(ipvType, minPort, maxPort);
+    if (protocol == IPPROTO_ICMP || protocol == IPPROTO_ICMPV6) return icmpPortUnreachable(ipvType, minPort, maxPort);
+    return dropAll();
+}
+
+// Function for finishing program by check of port in accumulator, jumps marked by JUMP_REJECT are resolved to reject
+
+static void finishProgram(std::vector<struct sock_filter>& program, uint16_t minPort, uint16_t maxPort, unsigned shard, unsigned shardCount) {
+    // Port must be in source port range of probes
+    program.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, minPort, 0, JUMP_REJECT));
+    program.push_back(BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, maxPort, JUMP_REJECT, 0));
+    // Port of shard is shard modulo count of shards from start of range
+    if (shardCount > 1) {
+        program.push_back(BPF_STMT(BPF_ALU | BPF_SUB | BPF_K, minPort));
+        program.push_back(BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, shardCount));
+        program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, shard, 0, JUMP_REJECT));
+    }
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, FILTER_ACCEPT));
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, 0));
+    // Jumps are relative to next instruction, reject is the last one
+    size_t reject = program.size() - 1;
+    for (size_t i = 0; i < reject; i++) {
+        if (BPF_CLASS(program[i].code) != BPF_JMP) continue;
+        if (program[i].jt == JUMP_REJECT) program[i].jt = reject - i - 1;
+        if (program[i].jf == JUMP_REJECT) program[i].jf = reject - i - 1;
+    }
+}
+
+// Function for generating filter of replies of transport protocol, destination port is the second word of TCP and UDP header
+
+static std::vector<struct sock_filter> transportReplies(int protocol, int ipvType, bool withIpHeader, uint16_t minPort, uint16_t maxPort, unsigned shard, unsigned shardCount) {
+    std::vector<struct sock_filter> program;
+    if (ipvType == AF_INET) {
+        // Protocol of IPv4 header must be protocol of probes, X = length of IPv4 header
+        program = {
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 9),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, (uint32_t)protocol, 0, JUMP_REJECT),
+            BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, 0),
+            BPF_STMT(BPF_LD | BPF_H | BPF_IND, 2),
+        };
+    } else if (withIpHeader) {
+        // Next header of IPv6 header must be protocol of probes, replies have no extension headers
+        program = {
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 6),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, (uint32_t)protocol, 0, JUMP_REJECT),
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 40 + 2),
+        };
+    } else {
+        // Packet starts by transport header
+        program = {
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 2),
+        };
+    }
+    // Destination port of reply must be source port of probe
+    finishProgram(program, minPort, maxPort, shard, shardCount);
+    return program;
+}
+
+// Method for generating filter of TCP replies
+
+std::vector<struct sock_filter> SocketFilter::tcpReplies(int ipvType, bool withIpHeader, uint16_t minPort, uint16_t maxPort, unsigned shard, unsigned shardCount) {
+    return transportReplies(IPPROTO_TCP, ipvType, withIpHeader, minPort, maxPort, shard, shardCount);
+}
+
+// Method for generating filter of UDP replies of services
+
+std::vector<struct sock_filter> SocketFilter::udpReplies(int ipvType, uint16_t minPort, uint16_t maxPort) {
+    return transportReplies(IPPROTO_UDP, ipvType, ipvType == AF_INET, minPort, maxPort, 0, 1);
+}
+
+// Method for generating filter of ICMP port unreachable quoting UDP probes
+
+std::vector<struct sock_filter> SocketFilter::icmpPortUnreachable(int ipvType, uint16_t minPort, uint16_t maxPort) {
+    std::vector<struct sock_filter> program;
+    if (ipvType == AF_INET) {
+        // Raw ICMP socket gets IPv4 header, X = length of IPv4 header -> start of ICMP header
+        program = {
+            BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, 0),
+            BPF_STMT(BPF_LD | BPF_B | BPF_IND, 0),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ICMP_TYPE_UNREACH, 0, JUMP_REJECT),
+            BPF_STMT(BPF_LD | BPF_B | BPF_IND, 1),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ICMP_CODE_PORT_UNREACH, 0, JUMP_REJECT),
+            // Quoted IPv4 header starts after 8 bytes of ICMP header, its protocol must be UDP
+            BPF_STMT(BPF_LD | BPF_B | BPF_IND, 8 + 9),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, JUMP_REJECT),
+            // X = start of quoted UDP header -> X + 8 + length of quoted IPv4 header
+            BPF_STMT(BPF_LD | BPF_B | BPF_IND, 8),
+            BPF_STMT(BPF_ALU | BPF_AND | BPF_K, 0x0f),
+            BPF_STMT(BPF_ALU | BPF_LSH | BPF_K, 2),
+            BPF_STMT(BPF_ALU | BPF_ADD | BPF_X, 0),
+            BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 8),
+            BPF_STMT(BPF_MISC | BPF_TAX, 0),
+            BPF_STMT(BPF_LD | BPF_H | BPF_IND, 0),
+        };
+    } else {
+        // Raw ICMPv6 socket gets ICMPv6 header, quoted IPv6 header starts after 8 bytes
+        program = {
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 0),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ICMPV6_TYPE_UNREACH, 0, JUMP_REJECT),
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 1),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ICMPV6_CODE_PORT_UNREACH, 0, JUMP_REJECT),
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 8 + 6),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, JUMP_REJECT),
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 8 + 40),
+        };
+    }
+    // Source port of quoted UDP probe must be source port of probe
+    finishProgram(program, minPort, maxPort, 0, 1);
+    return program;
+}
+
+// Method for generating filter which drops every packet
+
+std::vector<struct sock_filter> SocketFilter::dropAll() {
+    return { BPF_STMT(BPF_RET | BPF_K, 0) };
+}
+
+// Method for attaching filter to socket
+
+bool SocketFilter::attach(int fdSock, const std::vector<struct sock_filter>& program) {
+    struct sock_fprog filter;
+    filter.len = program.size();
+    filter.filter = const_cast<struct sock_filter*>(program.data());
+    return setsockopt(fdSock, SOL_SOCKET, SO_ATTACH_FILTER, &filter, sizeof(filter)) == 0;
+}
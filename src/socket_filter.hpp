@@ -0,0 +1,89 @@
+/**
+ * @file socket_filter.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for classic BPF filters of receiving sockets
+ */
+
+#ifndef SOCKET_FILTER_HPP
+#define SOCKET_FILTER_HPP // SOCKET_FILTER_HPP
+
+#include <cstdint>
+#include <vector>
+#include <linux/filter.h>
+
+/**
+ * @class SocketFilter
+ * @brief Class for generating and attaching classic BPF programs (SO_ATTACH_FILTER)
+ *
+ * Programs are run by kernel for every packet before it is queued to socket, so packets which are not replies
+ * to probes of scanner never wake up scanner and are never copied to userspace.
+ * Replies are recognized by source port range of probes -> TCP and UDP reply has it as destination port and ICMP port
+ * unreachable quotes UDP probe with it as source port.
+ */
+class SocketFilter{
+    public:
+        /**
+         * @brief Method for generating filter of raw socket of scanner
+         *
+         * TCP and UDP sockets accept only segments and datagrams to source port range, ICMP socket accepts only port
+         * unreachable quoting UDP datagram from source port range.
+         *
+         * @param ipvType - AF_INET or AF_INET6
+         * @param protocol - IPPROTO_TCP, IPPROTO_UDP, IPPROTO_ICMP or IPPROTO_ICMPV6
+         * @param minPort - first source port of probes
+         * @param maxPort - last source port of probes
+         * @return program of filter
+         */
+        static std::vector<struct sock_filter> forRawSocket(int ipvType, int protocol, uint16_t minPort, uint16_t maxPort);
+        /**
+         * @brief Method for generating filter of TCP replies for packets starting by IP header
+         *
+         * Raw IPv4 socket and packet socket get packets with IP header, raw IPv6 socket gets only TCP segment.
+         *
+         * @param ipvType - AF_INET or AF_INET6
+         * @param withIpHeader - true if packet starts by IP header
+         * @param minPort - first source port of probes
+         * @param maxPort - last source port of probes
+         * @param shard - index of shard of source ports, see ProbeCookie
+         * @param shardCount - count of shards, 1 accepts whole range
+         * @return program of filter
+         */
+        static std::vector<struct sock_filter> tcpReplies(int ipvType, bool withIpHeader, uint16_t minPort, uint16_t maxPort, unsigned shard = 0, unsigned shardCount = 1);
+        /**
+         * @brief Method for generating filter of UDP replies of services to probes
+         *
+         * Raw IPv4 socket gets packets with IP header, raw IPv6 socket gets only UDP datagram.
+         *
+         * @param ipvType - AF_INET or AF_INET6
+         * @param minPort - first source port of probes
+         * @param maxPort - last source port of probes
+         * @return program of filter
+         */
+        static std::vector<struct sock_filter> udpReplies(int ipvType, uint16_t minPort, uint16_t maxPort);
+        /**
+         * @brief Method for generating filter of ICMP port unreachable quoting UDP probes
+         *
+         * @param ipvType - AF_INET or AF_INET6
+         * @param minPort - first source port of probes
+         * @param maxPort - last source port of probes
+         * @return program of filter
+         */
+        static std::vector<struct sock_filter> icmpPortUnreachable(int ipvType, uint16_t minPort, uint16_t maxPort);
+        /**
+         * @brief Method for generating filter which drops every packet
+         *
+         * @return program of filter
+         */
+        static std::vector<struct sock_filter> dropAll();
+        /**
+         * @brief Method for attaching filter to socket
+         *
+         * @param fdSock - file descriptor of socket
+         * @param program - program of filter
+         * @return true if filter was attached, false otherwise
+         */
+        static bool attach(int fdSock, const std::vector<struct sock_filter>& program);
+};
+
+#endif // SOCKET_FILTER_HPP
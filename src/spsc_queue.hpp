@@ -0,0 +1,85 @@
+/**
+ * @file spsc_queue.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for lock-free queue between two threads
+ */
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP // SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Constants for size of cache line, indexes of producer and consumer are kept on separate lines
+#define CACHE_LINE_SIZE 64
+
+/**
+ * @class SpscQueue
+ * @brief Class for bounded lock-free queue with one producer thread and one consumer thread
+ *
+ * Items are stored in preallocated ring of power of two size. Producer writes only tail and consumer writes only head,
+ * every index is published by release store and read by acquire load, so there is no lock and no compare-and-swap.
+ * Each side keeps cached copy of index of other side and reloads it only when ring looks full or empty.
+ */
+template <typename T>
+class SpscQueue{
+    public:
+        /**
+         * @brief Construct of SpscQueue
+         *
+         * @param capacity - min count of items in queue, rounded up to power of two
+         */
+        SpscQueue(size_t capacity) {
+            size_t size = 1;
+            while (size < capacity) size <<= 1;
+            this->items.resize(size);
+            this->mask = size - 1;
+        }
+        /**
+         * @brief Method for inserting item, called only by producer thread
+         *
+         * @param item - inserted item
+         * @return true if item was inserted, false if queue is full
+         */
+        bool push(const T& item) {
+            size_t tail = this->tail.load(std::memory_order_relaxed);
+            if (tail - this->cachedHead > this->mask) {
+                this->cachedHead = this->head.load(std::memory_order_acquire);
+                if (tail - this->cachedHead > this->mask) return false;
+            }
+            this->items[tail & this->mask] = item;
+            this->tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+        /**
+         * @brief Method for removing item, called only by consumer thread
+         *
+         * @param item - removed item
+         * @return true if item was removed, false if queue is empty
+         */
+        bool pop(T& item) {
+            size_t head = this->head.load(std::memory_order_relaxed);
+            if (head == this->cachedTail) {
+                this->cachedTail = this->tail.load(std::memory_order_acquire);
+                if (head == this->cachedTail) return false;
+            }
+            item = this->items[head & this->mask];
+            this->head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        // Ring of items and mask of its positions
+        std::vector<T> items;
+        size_t mask;
+        // Position of next read, written by consumer, with cached tail of consumer
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{0};
+        size_t cachedTail = 0;
+        // Position of next write, written by producer, with cached head of producer
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{0};
+        size_t cachedHead = 0;
+};
+
+#endif // SPSC_QUEUE_HPP
@@ -0,0 +1,33 @@
+/**
+ * @file system_utils.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of helpers of descriptors and time
+ */
+
+#include "system_utils.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Method for writing whole buffer to descriptor, write can be partial
+
+bool SystemUtils::writeAll(int fd, const char* data, size_t length) {
+    size_t written = 0;
+    while (written < length) {
+        ssize_t count = ::write(fd, data + written, length - written);
+        if (count == -1) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        written += count;
+    }
+    return true;
+}
+
+// Method for setting descriptor non-blocking
+
+bool SystemUtils::setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file system_utils.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Library for helpers of descriptors and time shared by scanners and stores
+ */
+
+#ifndef SYSTEM_UTILS_HPP
+#define SYSTEM_UTILS_HPP // SYSTEM_UTILS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+
+/**
+ * @class SystemUtils
+ * @brief Class for helpers of descriptors and time
+ */
+class SystemUtils{
+    public:
+        /**
+         * @brief Method for writing whole buffer to descriptor, partial and interrupted writes are continued
+         *
+         * @param fd - descriptor
+         * @param data - data to write
+         * @param length - length of data in bytes
+         * @return false if write failed
+         */
+        static bool writeAll(int fd, const char* data, size_t length);
+        /**
+         * @brief Method for setting descriptor non-blocking
+         *
+         * @param fd - descriptor
+         * @return false if flags of descriptor cannot be changed
+         */
+        static bool setNonBlocking(int fd);
+        /**
+         * @brief Method for getting time elapsed from start of scan
+         *
+         * @param startTime - start of scan
+         * @return elapsed time (us)
+         */
+        static uint64_t elapsedMicros(std::chrono::steady_clock::time_point startTime) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+        }
+};
+
+#endif // SYSTEM_UTILS_HPP
@@ -0,0 +1,255 @@
+/**
+ * @file target_generator.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of generator of scanned addresses from ranges
+ */
+
+#include "target_generator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+
+// Function for reading big endian 32 bit word of address
+
+static uint32_t readWord(const uint8_t* bytes) {
+    uint32_t word;
+    memcpy(&word, bytes, 4);
+    return ntohl(word);
+}
+
+// Function for reading big endian 64 bit half of IPv6 address
+
+static uint64_t readHalf(const uint8_t* bytes) {
+    return (uint64_t)readWord(bytes) << 32 | readWord(bytes + 4);
+}
+
+// Function for writing big endian 64 bit half of IPv6 address
+
+static void writeHalf(uint8_t* bytes, uint64_t half) {
+    uint32_t high = htonl((uint32_t)(half >> 32));
+    uint32_t low = htonl((uint32_t)half);
+    memcpy(bytes, &high, 4);
+    memcpy(bytes + 4, &low, 4);
+}
+
+// Function for converting address of any family from text
+
+static bool fromText(const std::string& text, IpAddress& address) {
+    address = IpAddress();
+    if (inet_pton(AF_INET, text.c_str(), address.bytes) == 1) address.family = AF_INET;
+    else if (inet_pton(AF_INET6, text.c_str(), address.bytes) == 1) address.family = AF_INET6;
+    return address.family != AF_UNSPEC;
+}
+
+// Function for checking if text is decimal number with at most 3 digits
+
+static bool isSmallNumber(const std::string& text) {
+    return !text.empty() && text.size() <= 3 && std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+// Method for adding offset to address
+
+IpAddress TargetGenerator::advance(const IpAddress& address, uint64_t offset) {
+    IpAddress result = address;
+    if (address.family == AF_INET) {
+        uint32_t word = htonl(readWord(address.bytes) + (uint32_t)offset);
+        memcpy(result.bytes, &word, 4);
+        return result;
+    }
+    // Offset is added to low half of IPv6 address with carry to high half
+    uint64_t low = readHalf(address.bytes + 8);
+    uint64_t sum = low + offset;
+    if (sum < low) writeHalf(result.bytes, readHalf(address.bytes) + 1);
+    writeHalf(result.bytes + 8, sum);
+    return result;
+}
+
+// Method for getting offset of address from first address of range
+
+bool TargetGenerator::distance(const IpAddress& first, const IpAddress& address, uint64_t& offset) {
+    if (address.family == AF_INET) {
+        uint32_t low = readWord(first.bytes);
+        uint32_t high = readWord(address.bytes);
+        offset = high - low;
+        return high >= low;
+    }
+    // Offset of IPv6 address can carry from low to high half
+    uint64_t firstHigh = readHalf(first.bytes);
+    uint64_t high = readHalf(address.bytes);
+    uint64_t firstLow = readHalf(first.bytes + 8);
+    uint64_t low = readHalf(address.bytes + 8);
+    offset = low - firstLow;
+    if (high == firstHigh) return low >= firstLow;
+    return high - firstHigh == 1 && low < firstLow;
+}
+
+// Method for comparing addresses, IPv4 addresses are before IPv6 ones
+
+bool TargetGenerator::lower(const IpAddress& left, const IpAddress& right) {
+    if (left.family != right.family) return left.family == AF_INET;
+    // Bytes of address are in network order -> lexicographic order is numeric order
+    return memcmp(left.bytes, right.bytes, left.length()) < 0;
+}
+
+// Method for adding range of addresses
+
+void TargetGenerator::add(const IpAddress& first, uint64_t count) {
+    if (count == 0) return;
+    // Range which continues last range extends it, consecutive addresses of list are kept as one range
+    if (!this->ranges.empty()) {
+        TargetRange& last = this->ranges.back();
+        if (last.first.family == first.family && last.count + count <= MAX_RANGE_SIZE && advance(last.first, last.count) == first) {
+            last.count += count;
+            this->total += count;
+            return;
+        }
+    }
+    this->ranges.push_back(TargetRange{first, count});
+    this->starts.push_back(this->total);
+    this->total += count;
+}
+
+// Method for sorting ranges and merging overlapping and consecutive ones
+
+void TargetGenerator::normalize() {
+    std::sort(this->ranges.begin(), this->ranges.end(), [](const TargetRange& left, const TargetRange& right) { return lower(left.first, right.first); });
+
+    // Range which starts in previous range or right after it extends previous range
+    std::vector<TargetRange> merged;
+    for (const TargetRange& range : this->ranges) {
+        uint64_t offset;
+        if (!merged.empty() && merged.back().first.family == range.first.family && distance(merged.back().first, range.first, offset) && offset <= merged.back().count) {
+            merged.back().count = std::max(merged.back().count, offset + range.count);
+        } else {
+            merged.push_back(range);
+        }
+    }
+
+    // Merged range is split again into ranges of at most MAX_RANGE_SIZE addresses
+    this->ranges.clear();
+    this->starts.clear();
+    this->total = 0;
+    for (TargetRange range : merged) {
+        while (range.count > 0) {
+            uint64_t count = std::min<uint64_t>(range.count, MAX_RANGE_SIZE);
+            this->ranges.push_back(TargetRange{range.first, count});
+            this->starts.push_back(this->total);
+            this->total += count;
+            range.count -= count;
+            if (range.count > 0) range.first = advance(range.first, count);
+        }
+    }
+    this->reset();
+}
+
+// Method for getting address by its index
+
+IpAddress TargetGenerator::at(uint64_t index) const {
+    // Last range which starts before or at index
+    size_t range = std::upper_bound(this->starts.begin(), this->starts.end(), index) - this->starts.begin() - 1;
+    return advance(this->ranges[range].first, index - this->starts[range]);
+}
+
+// Method for getting next address
+
+bool TargetGenerator::next(IpAddress& address) {
+    if (this->cursorRange == this->ranges.size()) return false;
+    address = advance(this->ranges[this->cursorRange].first, this->cursorOffset);
+    // Move to next address, after last address of range to next range
+    if (++this->cursorOffset == this->ranges[this->cursorRange].count) {
+        this->cursorOffset = 0;
+        this->cursorRange++;
+    }
+    return true;
+}
+
+// Method for starting generating from first address again
+
+void TargetGenerator::reset() {
+    this->cursorRange = 0;
+    this->cursorOffset = 0;
+}
+
+// Method for computing fingerprint of ranges
+
+uint64_t TargetGenerator::fingerprint() const {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto mix = [&hash](const void* data, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            hash ^= ((const uint8_t*)data)[i];
+            hash *= 0x100000001b3ULL;
+        }
+    };
+    for (const TargetRange& range : this->ranges) {
+        mix(&range.first.family, sizeof(range.first.family));
+        mix(range.first.bytes, range.first.length());
+        mix(&range.count, sizeof(range.count));
+    }
+    return hash;
+}
+
+// Method for finding index of address
+
+bool TargetGenerator::indexOf(const IpAddress& address, uint64_t& index) const {
+    // Last range which starts before or at address, ranges are sorted and disjoint
+    auto range = std::upper_bound(this->ranges.begin(), this->ranges.end(), address, [](const IpAddress& value, const TargetRange& range) { return lower(value, range.first); });
+    if (range == this->ranges.begin()) return false;
+    range--;
+    uint64_t offset;
+    if (range->first.family != address.family || !distance(range->first, address, offset) || offset >= range->count) return false;
+    index = this->starts[range - this->ranges.begin()] + offset;
+    return true;
+}
+
+// Method for parsing literal target
+
+bool TargetGenerator::parse(const std::string& target, TargetRange& range) {
+    // CIDR block -> address/prefix, slash cannot be in hostname
+    size_t slash = target.find('/');
+    if (slash != std::string::npos) {
+        std::string prefix = target.substr(slash + 1);
+        if (!fromText(target.substr(0, slash), range.first) || !isSmallNumber(prefix)) throw std::invalid_argument("");
+        int bits = std::stoi(prefix);
+        int addressBits = range.first.family == AF_INET ? 32 : 128;
+        int minBits = range.first.family == AF_INET ? 0 : MIN_IPV6_PREFIX;
+        if (bits < minBits || bits > addressBits) throw std::invalid_argument("");
+        // Host part of address is cleared -> first address of block
+        for (int bit = bits; bit < addressBits; bit++) range.first.bytes[bit / 8] &= ~(0x80 >> (bit % 8));
+        range.count = 1ULL << (addressBits - bits);
+        return true;
+    }
+
+    // Range -> first-last, or first-last octet for IPv4
+    size_t dash = target.find('-');
+    if (dash != std::string::npos) {
+        // Hostname can contain dash too
+        if (!fromText(target.substr(0, dash), range.first)) return false;
+        std::string end = target.substr(dash + 1);
+        IpAddress last = range.first;
+        if (range.first.family == AF_INET && isSmallNumber(end)) {
+            if (std::stoi(end) > 255) throw std::invalid_argument("");
+            last.bytes[3] = (uint8_t)std::stoi(end);
+        } else if (!fromText(end, last) || last.family != range.first.family) {
+            throw std::invalid_argument("");
+        }
+        // Count of addresses, IPv6 range must differ only in low half
+        uint64_t low, high;
+        if (range.first.family == AF_INET) {
+            low = readWord(range.first.bytes);
+            high = readWord(last.bytes);
+        } else {
+            if (readHalf(range.first.bytes) != readHalf(last.bytes)) throw std::invalid_argument("");
+            low = readHalf(range.first.bytes + 8);
+            high = readHalf(last.bytes + 8);
+        }
+        if (high < low || high - low >= MAX_RANGE_SIZE) throw std::invalid_argument("");
+        range.count = high - low + 1;
+        return true;
+    }
+
+    // Single address
+    range.count = 1;
+    return fromText(target, range.first);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file target_generator.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for generator of scanned addresses from ranges
+ */
+
+#ifndef TARGET_GENERATOR_HPP
+#define TARGET_GENERATOR_HPP // TARGET_GENERATOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "ip_address.hpp"
+
+// Constants for max count of addresses of one range -> IPv4 /0 or IPv6 /96
+#define MAX_RANGE_SIZE (1ULL << 32)
+// Constants for shortest IPv6 prefix which can be scanned
+#define MIN_IPV6_PREFIX 96
+
+/**
+ * @brief Struct for range of consecutive addresses
+ */
+struct TargetRange {
+    // First address of range
+    IpAddress first;
+    // Count of addresses of range
+    uint64_t count;
+};
+
+/**
+ * @class TargetGenerator
+ * @brief Class for generator of scanned addresses of one family
+ *
+ * Targets are stored only as ranges of consecutive addresses (CIDR blocks, address ranges, single addresses),
+ * addresses are computed on demand, so /8 takes the same memory as single address.
+ * After all ranges are added, normalize() sorts them and merges overlapping ones, so every address is generated once
+ * (hostname and its literal address, overlapping blocks, repeated lines of list).
+ * Addresses can be read one by one by next() or by their index by at(), which finds range by binary search of
+ * indexes of first addresses of ranges, indexOf() finds range of address by binary search of sorted ranges.
+ */
+class TargetGenerator{
+    public:
+        /**
+         * @brief Method for adding range of addresses
+         *
+         * Range which continues last added range is merged into it, other ranges are merged by normalize().
+         *
+         * @param first - first address of range
+         * @param count - count of addresses of range
+         */
+        void add(const IpAddress& first, uint64_t count);
+        /**
+         * @brief Method for sorting ranges and merging overlapping and consecutive ones, called after last add()
+         */
+        void normalize();
+        /**
+         * @brief Method for getting count of all addresses
+         *
+         * @return count of addresses
+         */
+        uint64_t size() const { return this->total; }
+        /**
+         * @brief Method for checking if there is no address
+         *
+         * @return true if there is no address
+         */
+        bool empty() const { return this->total == 0; }
+        /**
+         * @brief Method for getting address by its index
+         *
+         * @param index - index of address from 0 to size() - 1
+         * @return address
+         */
+        IpAddress at(uint64_t index) const;
+        /**
+         * @brief Method for getting next address
+         *
+         * @param address - next address
+         * @return true if address was generated, false if all addresses were generated
+         */
+        bool next(IpAddress& address);
+        /**
+         * @brief Method for starting generating from first address again
+         */
+        void reset();
+        /**
+         * @brief Method for computing fingerprint of ranges
+         *
+         * @return FNV-1a hash of all ranges, the same targets give the same fingerprint
+         */
+        uint64_t fingerprint() const;
+        /**
+         * @brief Method for finding index of address
+         *
+         * @param address - searched address
+         * @param index - index of address, as used by at()
+         * @return true if address is one of targets
+         */
+        bool indexOf(const IpAddress& address, uint64_t& index) const;
+        /**
+         * @brief Method for parsing literal target
+         *
+         * Target can be address (192.0.2.1, 2001:db8::1), CIDR block (192.0.2.0/24, 2001:db8::/112),
+         * IPv4 range (192.0.2.1-192.0.2.20 or 192.0.2.1-20) or IPv6 range (2001:db8::1-2001:db8::ff).
+         *
+         * @param target - target in text form
+         * @param range - parsed range
+         * @return true if target is literal, false if it can be hostname
+         *
+         * @throws std::invalid_argument if target is block or range with invalid prefix or bounds
+         */
+        static bool parse(const std::string& target, TargetRange& range);
+
+    private:
+        /**
+         * @brief Method for adding offset to address
+         *
+         * @param address - first address
+         * @param offset - offset less than MAX_RANGE_SIZE
+         * @return address increased by offset
+         */
+        static IpAddress advance(const IpAddress& address, uint64_t offset);
+        /**
+         * @brief Method for getting offset of address from first address of range
+         *
+         * @param first - first address
+         * @param address - address of the same family
+         * @param offset - offset of address from first address
+         * @return true if address is not lower than first address and offset fits in 64 bits
+         */
+        static bool distance(const IpAddress& first, const IpAddress& address, uint64_t& offset);
+        /**
+         * @brief Method for comparing addresses, IPv4 addresses are before IPv6 ones
+         *
+         * @param left - first address
+         * @param right - second address
+         * @return true if left address is lower than right address
+         */
+        static bool lower(const IpAddress& left, const IpAddress& right);
+        // Sorted ranges of addresses and index of first address of each range
+        std::vector<TargetRange> ranges;
+        std::vector<uint64_t> starts;
+        // Count of all addresses
+        uint64_t total = 0;
+        // Position of next generated address
+        size_t cursorRange = 0;
+        uint64_t cursorOffset = 0;
+};
+
+#endif // TARGET_GENERATOR_HPP
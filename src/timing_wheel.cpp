@@ -0,0 +1,131 @@
+/**
+ * @file timing_wheel.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of hierarchical timing wheel of probe deadlines
+ */
+
+#include "timing_wheel.hpp"
+
+// Constants for empty link
+#define NO_ENTRY UINT32_MAX
+// Constants for max distance of timer from current tick, which wheel can hold
+#define WHEEL_RANGE (1ULL << (WHEEL_FIRST_BITS + (WHEEL_LEVELS - 1) * WHEEL_LEVEL_BITS))
+
+// Constructor
+
+TimingWheel::TimingWheel(size_t capacity) : next(capacity, NO_ENTRY), prev(capacity, NO_ENTRY), slotOf(capacity, NO_ENTRY), expiry(capacity, 0), now(0), count(0) {
+    // Slots of all levels are stored one after another
+    size_t slotCount = 0;
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        this->levelStart[level] = slotCount;
+        slotCount += slotsOf(level);
+    }
+    this->heads.assign(slotCount, NO_ENTRY);
+    this->occupied.assign((slotCount + 63) / 64, 0);
+}
+
+// Method for putting entry to slot by its expiry
+
+void TimingWheel::link(uint32_t id) {
+    // Timer in past is put to the slot processed as next one, timer too far is put to the last level
+    uint64_t target = this->expiry[id] < this->now ? this->now : this->expiry[id];
+    if (target - this->now >= WHEEL_RANGE) target = this->now + WHEEL_RANGE - 1;
+    uint64_t distance = target - this->now;
+
+    // Find lowest level which covers distance of timer
+    int level = 0;
+    while (level < WHEEL_LEVELS - 1 && distance >= (1ULL << (shiftOf(level + 1)))) level++;
+    size_t slot = this->levelStart[level] + ((target >> shiftOf(level)) & (slotsOf(level) - 1));
+
+    // Put entry at head of slot list
+    this->prev[id] = NO_ENTRY;
+    this->next[id] = this->heads[slot];
+    if (this->heads[slot] != NO_ENTRY) this->prev[this->heads[slot]] = id;
+    this->heads[slot] = id;
+    this->slotOf[id] = (uint32_t)slot;
+    this->occupied[slot / 64] |= 1ULL << (slot % 64);
+}
+
+// Method for removing entry from its slot
+
+void TimingWheel::unlink(uint32_t id) {
+    size_t slot = this->slotOf[id];
+    if (this->prev[id] != NO_ENTRY) this->next[this->prev[id]] = this->next[id];
+    else this->heads[slot] = this->next[id];
+    if (this->next[id] != NO_ENTRY) this->prev[this->next[id]] = this->prev[id];
+    if (this->heads[slot] == NO_ENTRY) this->occupied[slot / 64] &= ~(1ULL << (slot % 64));
+    this->slotOf[id] = NO_ENTRY;
+}
+
+// Method for scheduling timer of entry
+
+void TimingWheel::schedule(uint32_t id, uint64_t expiry) {
+    if (this->slotOf[id] != NO_ENTRY) this->unlink(id);
+    else this->count++;
+    this->expiry[id] = expiry;
+    this->link(id);
+}
+
+// Method for cancelling timer of entry
+
+void TimingWheel::cancel(uint32_t id) {
+    if (this->slotOf[id] == NO_ENTRY) return;
+    this->unlink(id);
+    this->count--;
+}
+
+// Method for advancing time of wheel, current tick is the next tick which was not processed yet
+
+void TimingWheel::advance(uint64_t now, std::vector<uint32_t>& expired) {
+    expired.clear();
+    while (this->now <= now) {
+        size_t index = this->now & (slotsOf(0) - 1);
+        // On start of new round of lower level, slot of higher level is cascaded down
+        for (int level = 1; index == 0 && level < WHEEL_LEVELS; level++) {
+            index = (this->now >> shiftOf(level)) & (slotsOf(level) - 1);
+            size_t slot = this->levelStart[level] + index;
+            uint32_t id = this->heads[slot];
+            while (id != NO_ENTRY) {
+                uint32_t following = this->next[id];
+                this->unlink(id);
+                this->link(id);
+                id = following;
+            }
+        }
+
+        // All timers of current slot of first level expire
+        size_t slot = this->now & (slotsOf(0) - 1);
+        uint32_t id = this->heads[slot];
+        while (id != NO_ENTRY) {
+            uint32_t following = this->next[id];
+            this->unlink(id);
+            // Timer which was limited by range of wheel is put back
+            if (this->expiry[id] > this->now) {
+                this->link(id);
+            } else {
+                expired.push_back(id);
+                this->count--;
+            }
+            id = following;
+        }
+        this->now++;
+    }
+}
+
+// Method for getting tick of nearest event of wheel
+
+uint64_t TimingWheel::nextEvent() const {
+    if (this->count == 0) return UINT64_MAX;
+    // Current tick starting round has pending cascade, which can bring nearer timers
+    if ((this->now & (slotsOf(0) - 1)) == 0) return this->now;
+    // Find first occupied slot of first level until end of its round
+    size_t position = this->now & (slotsOf(0) - 1);
+    while (position < slotsOf(0)) {
+        uint64_t word = this->occupied[position / 64] >> (position % 64);
+        if (word) return this->now + (position + __builtin_ctzll(word) - (this->now & (slotsOf(0) - 1)));
+        position = (position / 64 + 1) * 64;
+    }
+    // Otherwise next event is cascade on start of next round
+    return (this->now | (slotsOf(0) - 1)) + 1;
+}
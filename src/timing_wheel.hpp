@@ -0,0 +1,121 @@
+/**
+ * @file timing_wheel.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for hierarchical timing wheel of probe deadlines
+ */
+
+#ifndef TIMING_WHEEL_HPP
+#define TIMING_WHEEL_HPP // TIMING_WHEEL_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Constants for count of levels of wheel
+#define WHEEL_LEVELS 4
+// Constants for bits of slot position on first level -> 256 slots
+#define WHEEL_FIRST_BITS 8
+// Constants for bits of slot position on higher levels -> 64 slots
+#define WHEEL_LEVEL_BITS 6
+
+/**
+ * @class TimingWheel
+ * @brief Class for hierarchical timing wheel
+ *
+ * Wheel schedules timers of entries identified by numbers 0 .. capacity - 1, which are identifiers of ProbeTable records.
+ * Time is measured in ticks, first level has one slot per tick, every higher level has slots covering whole lower level.
+ * Timer is put into the lowest level which covers it and moved (cascaded) to lower level when its slot is reached,
+ * so scheduling and cancelling costs O(1) and advancing costs O(expired timers + elapsed ticks).
+ * Entries of slots are intrusive doubly linked lists in preallocated arrays, so nothing is allocated after construction.
+ */
+class TimingWheel{
+    public:
+        /**
+         * @brief Construct of TimingWheel
+         *
+         * @param capacity - count of entries which can have timer
+         */
+        TimingWheel(size_t capacity);
+        /**
+         * @brief Method for scheduling timer of entry
+         *
+         * If entry already has timer, it is rescheduled.
+         *
+         * @param id - entry
+         * @param expiry - tick of expiration, ticks in past expire on next advance
+         */
+        void schedule(uint32_t id, uint64_t expiry);
+        /**
+         * @brief Method for cancelling timer of entry
+         *
+         * @param id - entry
+         */
+        void cancel(uint32_t id);
+        /**
+         * @brief Method for advancing time of wheel
+         *
+         * @param now - current tick
+         * @param expired - vector which will be filled by entries with expired timers
+         */
+        void advance(uint64_t now, std::vector<uint32_t>& expired);
+        /**
+         * @brief Method for getting tick of nearest event of wheel
+         *
+         * Event is expiration of timer or cascade of higher level slot with timers, so waiting until this tick never misses timer.
+         *
+         * @return tick of nearest event, UINT64_MAX if there is no timer
+         */
+        uint64_t nextEvent() const;
+        /**
+         * @brief Getter of current tick of wheel
+         *
+         * @return current tick
+         */
+        uint64_t current() const { return this->now; }
+
+    private:
+        /**
+         * @brief Method for putting entry to slot by its expiry
+         *
+         * @param id - entry
+         */
+        void link(uint32_t id);
+        /**
+         * @brief Method for removing entry from its slot
+         *
+         * @param id - entry
+         */
+        void unlink(uint32_t id);
+        /**
+         * @brief Method for getting count of slots on level
+         *
+         * @param level - level of wheel
+         * @return count of slots
+         */
+        static size_t slotsOf(int level) { return level == 0 ? (1u << WHEEL_FIRST_BITS) : (1u << WHEEL_LEVEL_BITS); }
+        /**
+         * @brief Method for getting count of bits of ticks below level
+         *
+         * @param level - level of wheel
+         * @return shift of tick for slot position on level
+         */
+        static int shiftOf(int level) { return level == 0 ? 0 : WHEEL_FIRST_BITS + (level - 1) * WHEEL_LEVEL_BITS; }
+
+        // Heads of slot lists of all levels, first slot of level is at levelStart[level]
+        std::vector<uint32_t> heads;
+        size_t levelStart[WHEEL_LEVELS];
+        // Occupancy bitmap of slots of all levels
+        std::vector<uint64_t> occupied;
+        // Links and expiry of entries
+        std::vector<uint32_t> next;
+        std::vector<uint32_t> prev;
+        std::vector<uint32_t> slotOf;
+        std::vector<uint64_t> expiry;
+        // Current tick
+        uint64_t now;
+        // Count of scheduled timers
+        size_t count;
+};
+
+#endif // TIMING_WHEEL_HPP
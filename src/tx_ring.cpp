@@ -0,0 +1,103 @@
+/**
+ * @file tx_ring.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of memory mapped transmit ring of packet socket
+ */
+
+#include "tx_ring.hpp"
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <linux/if_packet.h>
+
+// Constants for offset of data in frame of ring
+#define TX_RING_DATA_OFFSET (TPACKET_ALIGN(sizeof(struct tpacket2_hdr)))
+
+// Constructor
+
+TxRing::TxRing(const std::string& interface, bool qdiscBypass) : fdSock(-1), ring(nullptr), ringSize(0), current(0), pending(0) {
+    // Create packet socket for sending only, protocol 0 does not receive anything
+    this->fdSock = socket(AF_PACKET, SOCK_RAW, 0);
+    if (this->fdSock == -1) throw std::runtime_error("Could not create packet socket!");
+
+    // Set version of ring, its geometry and optional bypass of queueing discipline
+    int version = TPACKET_V2;
+    struct tpacket_req request;
+    memset(&request, 0, sizeof(request));
+    request.tp_block_size = TX_RING_FRAME_SIZE * 64;
+    request.tp_frame_size = TX_RING_FRAME_SIZE;
+    request.tp_frame_nr = TX_RING_FRAME_COUNT;
+    request.tp_block_nr = TX_RING_FRAME_COUNT / 64;
+    int bypass = 1;
+    if (setsockopt(this->fdSock, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) == -1 ||
+        (qdiscBypass && setsockopt(this->fdSock, SOL_PACKET, PACKET_QDISC_BYPASS, &bypass, sizeof(bypass)) == -1) ||
+        setsockopt(this->fdSock, SOL_PACKET, PACKET_TX_RING, &request, sizeof(request)) == -1) {
+        close(this->fdSock);
+        throw std::runtime_error("Could not set packet ring!");
+    }
+
+    // Map ring to memory of process
+    this->ringSize = (size_t)TX_RING_FRAME_SIZE * TX_RING_FRAME_COUNT;
+    void* mapped = mmap(nullptr, this->ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, this->fdSock, 0);
+    if (mapped == MAP_FAILED) {
+        close(this->fdSock);
+        throw std::runtime_error("Could not map packet ring!");
+    }
+    this->ring = (char*)mapped;
+
+    // Bind socket to interface, frames are sent by this interface
+    struct sockaddr_ll sockAddr;
+    memset(&sockAddr, 0, sizeof(sockAddr));
+    sockAddr.sll_family = AF_PACKET;
+    sockAddr.sll_ifindex = if_nametoindex(interface.c_str());
+    if (sockAddr.sll_ifindex == 0 || bind(this->fdSock, (struct sockaddr*)&sockAddr, sizeof(sockAddr)) == -1) {
+        munmap(this->ring, this->ringSize);
+        close(this->fdSock);
+        throw std::runtime_error("Could not bind packet socket!");
+    }
+}
+
+// Destructor
+
+TxRing::~TxRing() {
+    munmap(this->ring, this->ringSize);
+    close(this->fdSock);
+}
+
+// Method for getting free frame for writing
+
+char* TxRing::frame() {
+    struct tpacket2_hdr* frameHeader = this->header(this->current);
+    uint32_t status = __atomic_load_n(&frameHeader->tp_status, __ATOMIC_ACQUIRE);
+    if (status == TP_STATUS_WRONG_FORMAT) throw std::runtime_error("Could not send packet!");
+    // Frame is still waiting for sending or being sent
+    if (status != TP_STATUS_AVAILABLE) return nullptr;
+    return (char*)frameHeader + TX_RING_DATA_OFFSET;
+}
+
+// Method for marking frame as ready for sending
+
+void TxRing::commit(size_t length) {
+    struct tpacket2_hdr* frameHeader = this->header(this->current);
+    frameHeader->tp_len = length;
+    __atomic_store_n(&frameHeader->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+    this->current = (this->current + 1) % TX_RING_FRAME_COUNT;
+    this->pending++;
+}
+
+// Method for sending all ready frames
+
+int TxRing::flush() {
+    if (this->pending == 0) return 1;
+    if (send(this->fdSock, nullptr, 0, MSG_DONTWAIT) == -1) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS || errno == EINTR) return 0;
+        return -1;
+    }
+    this->pending = 0;
+    return 1;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file tx_ring.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for memory mapped transmit ring of packet socket
+ */
+
+#ifndef TX_RING_HPP
+#define TX_RING_HPP // TX_RING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Constants for size of one frame of ring
+#define TX_RING_FRAME_SIZE 2048
+// Constants for count of frames of ring
+#define TX_RING_FRAME_COUNT 4096
+
+/**
+ * @class TxRing
+ * @brief Class for TPACKET_V2 transmit ring of AF_PACKET socket
+ *
+ * Complete link layer frames are written directly to memory shared with kernel and all written frames are sent
+ * by one send call, so frames do not pass IP stack of kernel. With bypass of queueing discipline frames are handed
+ * directly to driver of interface.
+ */
+class TxRing{
+    public:
+        /**
+         * @brief Construct of TxRing
+         *
+         * @param interface - name of interface
+         * @param qdiscBypass - true for bypass of queueing discipline of interface
+         *
+         * @throw std::runtime_error if socket or ring cannot be created
+         */
+        TxRing(const std::string& interface, bool qdiscBypass);
+        /**
+         * @brief Destructor of TxRing, unmaps ring and closes socket
+         */
+        ~TxRing();
+        TxRing(const TxRing&) = delete;
+        TxRing& operator=(const TxRing&) = delete;
+        /**
+         * @brief Method for getting free frame for writing
+         *
+         * @return pointer to data of frame, nullptr if all frames wait for sending
+         *
+         * @throw std::runtime_error if kernel rejected previously sent frame
+         */
+        char* frame();
+        /**
+         * @brief Method for marking frame got by frame() as ready for sending
+         *
+         * @param length - length of written frame
+         */
+        void commit(size_t length);
+        /**
+         * @brief Method for sending all ready frames
+         *
+         * @return 1 if frames were handed to kernel or there are none, 0 if kernel is busy, -1 if error
+         */
+        int flush();
+
+    private:
+        /**
+         * @brief Method for getting header of frame of ring
+         *
+         * @param index - index of frame
+         * @return pointer to header of frame
+         */
+        struct tpacket2_hdr* header(size_t index) { return (struct tpacket2_hdr*)(this->ring + index * TX_RING_FRAME_SIZE); }
+        // File descriptor of packet socket
+        int fdSock;
+        // Mapped memory of ring
+        char* ring;
+        size_t ringSize;
+        // Next frame for writing
+        size_t current;
+        // Count of frames ready for sending since last flush
+        size_t pending;
+};
+
+#endif // TX_RING_HPP
@@ -0,0 +1,54 @@
+/**
+ * @file udp_pacer.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of pacer of UDP probes of one target adapted to rate limit of its ICMP errors
+ */
+
+#include "udp_pacer.hpp"
+#include <algorithm>
+
+// Constructor
+
+UdpPacer::UdpPacer() : interval(0), lastSend(0), backoffAt(0), lastError(0), errorGap(0), streak(0), sent(false), errors(false) {}
+
+// Method for recording sent probe
+
+void UdpPacer::send(uint64_t now) {
+    this->lastSend = now;
+    this->sent = true;
+}
+
+// Method for recording probe which expired without reply
+
+void UdpPacer::lost(uint64_t sentAt) {
+    // Target without ICMP errors filters probes or has open ports, it is not rate limited
+    if (!this->errors) return;
+    // Probe was sent before last backoff, its pace is already slowed down
+    if (this->interval != 0 && sentAt <= this->backoffAt) return;
+    // Silent probe of target which answers by errors -> backoff, until error of retransmission shows real pace
+    this->interval = std::min<uint64_t>(std::max<uint64_t>(this->interval * 2, UDP_PACE_MIN_INTERVAL), UDP_PACE_MAX_INTERVAL);
+    this->backoffAt = this->lastSend;
+    this->streak = 0;
+}
+
+// Method for recording ICMP port unreachable error of target
+
+void UdpPacer::unreachable(uint64_t now, bool retransmitted) {
+    if (this->errors) this->errorGap = now - this->lastError;
+    this->lastError = now;
+    this->errors = true;
+
+    // Error of retransmission was suppressed at first send -> limit is confirmed, pace is not faster than errors came
+    if (retransmitted) {
+        this->interval = std::min<uint64_t>(std::max(this->interval, this->errorGap), UDP_PACE_MAX_INTERVAL);
+        this->streak = 0;
+        return;
+    }
+    // Errors of first sends -> target allows faster pace, interval is shortened by quarter
+    if (this->interval != 0 && ++this->streak >= UDP_PACE_RECOVERY) {
+        this->interval -= this->interval / 4;
+        if (this->interval < UDP_PACE_MIN_INTERVAL / 4) this->interval = 0;
+        this->streak = 0;
+    }
+}
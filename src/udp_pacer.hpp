@@ -0,0 +1,80 @@
+/**
+ * @file udp_pacer.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for pacer of UDP probes of one target adapted to rate limit of its ICMP errors
+ */
+
+#ifndef UDP_PACER_HPP
+#define UDP_PACER_HPP // UDP_PACER_HPP
+
+#include <cstdint>
+
+// Constants for interval between probes of rate limited target, first backoff and upper bound (us)
+#define UDP_PACE_MIN_INTERVAL 250000
+#define UDP_PACE_MAX_INTERVAL 1000000
+// Constants for count of ICMP errors answering first sends after which interval is shortened by quarter
+#define UDP_PACE_RECOVERY 8
+
+/**
+ * @class UdpPacer
+ * @brief Class for pacing UDP probes of one target by cadence of its ICMP port unreachable errors
+ *
+ * Linux and most routers send ICMP errors from token bucket (e.g. burst of 6 and then one per second), so probes sent
+ * faster stay without error and closed port looks as open|filtered. Target which already sent ICMP error and then leaves
+ * probe without reply may be rate limited, its interval between probes is doubled from UDP_PACE_MIN_INTERVAL up to
+ * UDP_PACE_MAX_INTERVAL. Error answering retransmitted probe confirms the limit, interval is then at least time between
+ * last two errors of target. Every UDP_PACE_RECOVERY errors answering first sends shorten interval by quarter, so pace
+ * follows the fastest rate target answers. Target which never sent ICMP error is not paced.
+ */
+class UdpPacer{
+    public:
+        /**
+         * @brief Construct of UdpPacer, target is not paced until it is found rate limited
+         */
+        UdpPacer();
+        /**
+         * @brief Method for getting time when next probe of target can be sent
+         *
+         * @return time of next probe (us), in the same clock as times given to pacer
+         */
+        uint64_t sendTime() const { return this->sent ? this->lastSend + this->interval : 0; }
+        /**
+         * @brief Method for recording sent probe
+         *
+         * @param now - time of send (us)
+         */
+        void send(uint64_t now);
+        /**
+         * @brief Method for recording probe which expired without reply
+         *
+         * Probes sent before last backoff were sent too fast already, only one of them doubles interval.
+         *
+         * @param sentAt - time of send of expired probe (us)
+         */
+        void lost(uint64_t sentAt);
+        /**
+         * @brief Method for recording ICMP port unreachable error of target
+         *
+         * @param now - time of reception (us)
+         * @param retransmitted - true if error answers retransmitted probe
+         */
+        void unreachable(uint64_t now, bool retransmitted);
+
+    private:
+        // Interval between probes of target, 0 for target without limit (us)
+        uint64_t interval;
+        // Time of last sent probe, of last backoff and of last ICMP error (us)
+        uint64_t lastSend;
+        uint64_t backoffAt;
+        uint64_t lastError;
+        // Time between last two ICMP errors (us)
+        uint64_t errorGap;
+        // Count of ICMP errors answering first sends since last change of interval
+        uint32_t streak;
+        // Flags for sent probe and received ICMP error
+        bool sent;
+        bool errors;
+};
+
+#endif // UDP_PACER_HPP
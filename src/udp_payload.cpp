@@ -0,0 +1,84 @@
+/**
+ * @file udp_payload.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Implementation of payloads of UDP probes of well-known services
+ */
+
+#include "udp_payload.hpp"
+
+// DNS -> standard query of NS records of root zone with recursion desired, also refusing server answers it
+static const uint8_t dnsQuery[] = {
+    0x49, 0x50, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x02, 0x00, 0x01,
+};
+
+// TFTP -> read request of file in octet mode, missing file is answered by error packet
+static const uint8_t tftpRead[] = {
+    0x00, 0x01, 'i', 'p', 'k', 0x00, 'o', 'c', 't', 'e', 't', 0x00,
+};
+
+// ONC RPC -> NULL call of portmapper (program 100000, version 2) without authentication
+static const uint8_t rpcNull[] = {
+    0x49, 0x50, 0x4b, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+    0x00, 0x01, 0x86, 0xa0, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+};
+
+// NTP -> client request of version 4 (mode 3), rest of 48 bytes is zero
+static const uint8_t ntpRequest[48] = {
+    0xe3, 0x00, 0x06, 0xec,
+};
+
+// NetBIOS name service -> node status request of wildcard name "*"
+static const uint8_t netbiosStatus[] = {
+    0x80, 0xf0, 0x00, 0x10, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x20, 'C', 'K', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A',
+    'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 0x00,
+    0x00, 0x21, 0x00, 0x01,
+};
+
+// SNMP -> version 1 get request of sysDescr.0 with community "public"
+static const uint8_t snmpGet[] = {
+    0x30, 0x29, 0x02, 0x01, 0x00, 0x04, 0x06, 'p', 'u', 'b', 'l', 'i', 'c',
+    0xa0, 0x1c, 0x02, 0x04, 0x49, 0x50, 0x4b, 0x34, 0x02, 0x01, 0x00, 0x02, 0x01, 0x00,
+    0x30, 0x0e, 0x30, 0x0c, 0x06, 0x08, 0x2b, 0x06, 0x01, 0x02, 0x01, 0x01, 0x01, 0x00, 0x05, 0x00,
+};
+
+// SSDP -> search of all devices and services
+static const char ssdpSearch[] =
+    "M-SEARCH * HTTP/1.1\r\n"
+    "HOST: 239.255.255.250:1900\r\n"
+    "MAN: \"ssdp:discover\"\r\n"
+    "MX: 1\r\n"
+    "ST: ssdp:all\r\n"
+    "\r\n";
+
+// mDNS -> unicast query of PTR records of service discovery (_services._dns-sd._udp.local)
+static const uint8_t mdnsQuery[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x09, '_', 's', 'e', 'r', 'v', 'i', 'c', 'e', 's', 0x07, '_', 'd', 'n', 's', '-', 's', 'd',
+    0x04, '_', 'u', 'd', 'p', 0x05, 'l', 'o', 'c', 'a', 'l', 0x00, 0x00, 0x0c, 0x00, 0x01,
+};
+
+// Payloads sorted by port, string payload is sent without terminating zero
+static const UdpPayload payloads[] = {
+    {53, dnsQuery, sizeof(dnsQuery)},
+    {69, tftpRead, sizeof(tftpRead)},
+    {111, rpcNull, sizeof(rpcNull)},
+    {123, ntpRequest, sizeof(ntpRequest)},
+    {137, netbiosStatus, sizeof(netbiosStatus)},
+    {161, snmpGet, sizeof(snmpGet)},
+    {1900, (const uint8_t*)ssdpSearch, sizeof(ssdpSearch) - 1},
+    {5353, mdnsQuery, sizeof(mdnsQuery)},
+};
+
+// Method for finding payload of port
+
+const UdpPayload* UdpPayloads::find(uint16_t port) {
+    for (const UdpPayload& payload : payloads) {
+        if (payload.port == port) return &payload;
+    }
+    return nullptr;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file udp_payload.hpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Header file for payloads of UDP probes of well-known services
+ */
+
+#ifndef UDP_PAYLOAD_HPP
+#define UDP_PAYLOAD_HPP // UDP_PAYLOAD_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+// Constants for max length of payload of UDP probe
+#define UDP_PAYLOAD_MAX 128
+
+/**
+ * @brief Struct for payload of UDP probe of one port
+ */
+struct UdpPayload {
+    // Destination port of probe
+    uint16_t port;
+    // Payload and its length
+    const uint8_t* data;
+    size_t length;
+};
+
+/**
+ * @class UdpPayloads
+ * @brief Class for library of payloads of UDP probes keyed by destination port
+ *
+ * Empty datagram is ignored by most services, so open port is silent and it cannot be told from filtered one.
+ * Probe of well-known port carries request of its service (DNS query, NTP client request, SNMP get, ...), which is
+ * answered by open service, so port is confirmed open by the reply instead of waiting for timeout.
+ */
+class UdpPayloads{
+    public:
+        /**
+         * @brief Method for finding payload of port
+         *
+         * @param port - destination port of probe
+         * @return payload of port, nullptr if port has no payload and probe is empty datagram
+         */
+        static const UdpPayload* find(uint16_t port);
+};
+
+#endif // UDP_PAYLOAD_HPP
@@ -0,0 +1,55 @@
+/**
+ * @file checksum_bench.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Microbenchmark of checksum implementations
+ */
+
+#include "checksum.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+
+// Constants for total count of summed bytes of each measurement
+#define BENCH_BYTES (256ULL * 1024 * 1024)
+
+// Function for measuring throughput of implementation for one length of data
+
+static double measure(ChecksumSumFunction function, const std::vector<unsigned char>& buffer, size_t length) {
+    size_t rounds = BENCH_BYTES / length;
+    // Result is accumulated, so calls cannot be removed by compiler
+    volatile uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; round++) sink = sink + function(buffer.data() + (round & 1), length);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return (double)(rounds * length) / seconds / 1e9;
+}
+
+int main() {
+    const size_t lengths[] = {20, 40, 64, 576, 1500, 9000, 65536};
+    std::vector<unsigned char> buffer(65536 + 1);
+    for (size_t i = 0; i < buffer.size(); i++) buffer[i] = (unsigned char)(i * 131 + 7);
+
+    struct { const char* name; ChecksumSumFunction function; } variants[] = {
+        {"reference", Checksum::sumReference},
+        {"scalar", Checksum::sumScalar},
+        {"sse2", Checksum::sumSse2},
+        {"avx2", Checksum::sumAvx2},
+    };
+
+    std::cout << "Selected implementation: " << Checksum::implementation() << std::endl;
+    std::cout << "Throughput in GB/s, unaligned data" << std::endl;
+    std::cout << std::setw(10) << "length";
+    for (auto& variant : variants) std::cout << std::setw(11) << variant.name;
+    std::cout << std::endl;
+    for (size_t length : lengths) {
+        std::cout << std::setw(10) << length;
+        for (auto& variant : variants) {
+            if (variant.function) std::cout << std::setw(11) << std::fixed << std::setprecision(2) << measure(variant.function, buffer, length);
+            else std::cout << std::setw(11) << "-";
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
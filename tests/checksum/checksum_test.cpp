@@ -0,0 +1,82 @@
+/**
+ * @file checksum_test.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Test of checksum implementations against reference implementation
+ */
+
+#include "checksum.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstring>
+
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define NC "\033[0m"
+
+// Constants for max length and count of random buffers
+#define MAX_LENGTH 4096
+#define RANDOM_ROUNDS 20000
+
+// Count of failed tests
+static int failed = 0;
+
+// Function for printing result of test
+
+static void report(const std::string& name, bool passed) {
+    std::cout << name << std::endl;
+    if (passed) std::cout << GREEN << "PASSED" << NC << std::endl;
+    else {
+        std::cout << RED << "FAILED" << NC << std::endl;
+        failed++;
+    }
+    std::cout << "-------------------------" << std::endl;
+}
+
+// Function for checking implementation on random buffers of all lengths and alignments
+
+static bool matchesReference(ChecksumSumFunction function) {
+    std::mt19937 random(1071);
+    std::vector<unsigned char> buffer(MAX_LENGTH + 64);
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        // Short buffers are checked for every length, long ones randomly, some of them full of 0xFF to check carries
+        size_t length = round < MAX_LENGTH ? round : random() % MAX_LENGTH;
+        size_t offset = random() % 64;
+        bool ones = round % 7 == 0;
+        for (size_t i = 0; i < length; i++) buffer[offset + i] = ones ? 0xFF : random();
+        const unsigned char* data = buffer.data() + offset;
+        if (Checksum::fold(function(data, length)) != Checksum::fold(Checksum::sumReference(data, length))) return false;
+    }
+    return true;
+}
+
+int main() {
+    // Example of RFC 1071, section 3 -> sum ddf2, checksum 220d in network byte order
+    const unsigned char example[] = {0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7};
+    uint16_t checksum = Checksum::compute(example, sizeof(example));
+    const unsigned char* bytes = (const unsigned char*)&checksum;
+    report("TEST01: RFC 1071 example", bytes[0] == 0x22 && bytes[1] == 0x0d);
+
+    // Empty data has zero sum
+    report("TEST02: empty data", Checksum::compute(example, 0) == 0xFFFF);
+
+    // Data with its checksum sums to zero
+    unsigned char header[20];
+    for (size_t i = 0; i < sizeof(header); i++) header[i] = (unsigned char)(i * 37 + 11);
+    header[10] = header[11] = 0;
+    checksum = Checksum::compute(header, sizeof(header));
+    memcpy(header + 10, &checksum, 2);
+    report("TEST03: verification of header with checksum", Checksum::compute(header, sizeof(header)) == 0);
+
+    // Implementations against reference
+    report("TEST04: scalar implementation", matchesReference(Checksum::sumScalar));
+    if (Checksum::sumSse2) report("TEST05: SSE2 implementation", matchesReference(Checksum::sumSse2));
+    else std::cout << "TEST05: SSE2 is not supported, skipped" << std::endl;
+    if (Checksum::sumAvx2) report("TEST06: AVX2 implementation", matchesReference(Checksum::sumAvx2));
+    else std::cout << "TEST06: AVX2 is not supported, skipped" << std::endl;
+    report(std::string("TEST07: selected implementation (") + Checksum::implementation() + ")", matchesReference(Checksum::sum));
+
+    return failed == 0 ? 0 : 1;
+}
@@ -42,3 +42,21 @@ test_program_invalid "TEST12: ./ipk-l4-scan --interface lo 2001:0db8:85a3:0000:0
 test_program_invalid "TEST13: ./ipk-l4-scan --interface lo 127.0.0.1 --wait 10 --pt 22.2 --pu 53,123" --interface lo 127.0.0.1 --wait 10 --pt 22.2 --pu 53,123
 test_program_invalid "TEST14: ./ipk-l4-scan --interface lo 127.0.0.1.1 --wait 10 --pt 22 --pu 53,123" --interface lo 127.0.0.1.1 --wait 10 --pt 22 --pu 53,123
 test_program_invalid "TEST15: ./ipk-l4-scan --interface lo www.google.com" --interface lo www.google.com -t 100000000000
+test_program_invalid "TEST16: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 -a --async" --interface lo 127.0.0.1 -t 22 -a --async
+test_program_invalid "TEST17: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --stateless --stateless" --interface lo 127.0.0.1 -t 22 --stateless --stateless
+test_program_invalid "TEST18: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --rate 0" --interface lo 127.0.0.1 -t 22 --rate 0
+test_program_invalid "TEST19: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --rate 1000 --burst 8 --burst 8" --interface lo 127.0.0.1 -t 22 --rate 1000 --burst 8 --burst 8
+test_program_invalid "TEST20: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --batch --batch" --interface lo 127.0.0.1 -t 22 --batch --batch
+test_program_invalid "TEST21: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --rx-ring --rx-ring" --interface lo 127.0.0.1 -t 22 --rx-ring --rx-ring
+test_program_invalid "TEST22: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --tx-ring --qdisc-bypass --qdisc-bypass" --interface lo 127.0.0.1 -t 22 --tx-ring --qdisc-bypass --qdisc-bypass
+test_program_invalid "TEST23: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --threads 65" --interface lo 127.0.0.1 -t 22 --threads 65
+test_program_invalid "TEST24: ./ipk-l4-scan --interface lo 127.0.0.0/33 -t 22" --interface lo 127.0.0.0/33 -t 22
+test_program_invalid "TEST25: ./ipk-l4-scan --interface lo -iL nonexistent.txt -t 22" --interface lo -iL nonexistent.txt -t 22
+test_program_invalid "TEST26: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --seed abc" --interface lo 127.0.0.1 -t 22 --seed abc
+test_program_invalid "TEST27: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --concurrent -a" --interface lo 127.0.0.1 -t 22 --concurrent -a
+test_program_invalid "TEST28: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --format xml" --interface lo 127.0.0.1 -t 22 --format xml
+test_program_invalid "TEST29: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --stateless --resume scan.chk" --interface lo 127.0.0.1 -t 22 --stateless --resume scan.chk
+test_program_invalid "TEST30: ./ipk-l4-scan query scan.ipkc --state up" query scan.ipkc --state up
+test_program_invalid "TEST31: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --changed-first" --interface lo 127.0.0.1 -t 22 --changed-first
+test_program_invalid "TEST32: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 -u 53 --connect" --interface lo 127.0.0.1 -t 22 -u 53 --connect
+test_program_invalid "TEST33: ./ipk-l4-scan --interface lo 127.0.0.1 -t 22 --stateless --baseline scan.ipkc" --interface lo 127.0.0.1 -t 22 --stateless --baseline scan.ipkc
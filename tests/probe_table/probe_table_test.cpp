@@ -0,0 +1,142 @@
+/**
+ * @file probe_table_test.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Test of table of probes against std::unordered_map
+ */
+
+#include "probe_table.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <unordered_map>
+#include <arpa/inet.h>
+
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define NC "\033[0m"
+
+// Constants for capacity of tested table and count of random operations
+#define TABLE_CAPACITY 1024
+#define RANDOM_ROUNDS 2000000
+
+// Count of failed tests
+static int failed = 0;
+
+// Function for printing result of test
+
+static void report(const std::string& name, bool passed) {
+    std::cout << name << std::endl;
+    if (passed) std::cout << GREEN << "PASSED" << NC << std::endl;
+    else {
+        std::cout << RED << "FAILED" << NC << std::endl;
+        failed++;
+    }
+    std::cout << "-------------------------" << std::endl;
+}
+
+// Function for creating random key, small ranges of values give duplicate keys and long clusters of index
+
+static ProbeKey randomKey(std::mt19937& random, const std::vector<IpAddress>& addresses) {
+    return ProbeKey{addresses[random() % addresses.size()], (uint16_t)(random() % 64), (uint16_t)(50000 + random() % 16)};
+}
+
+// Function for checking that table holds exactly probes of reference
+
+static bool matchesReference(const ProbeTable& table, const std::unordered_map<ProbeKey, uint32_t, ProbeKeyHash>& reference) {
+    if (table.size() != reference.size() || table.empty() != reference.empty() || table.full() != (reference.size() == TABLE_CAPACITY)) return false;
+    for (const auto& [key, id] : reference) {
+        if (table.find(key) != id || !(table.at(id).key == key)) return false;
+    }
+    // Indexes of all stored probes are collected, index of record is its identifier here
+    std::vector<uint64_t> indexes, expected;
+    table.indexes(indexes);
+    for (const auto& [key, id] : reference) expected.push_back(id);
+    std::sort(indexes.begin(), indexes.end());
+    std::sort(expected.begin(), expected.end());
+    return indexes == expected;
+}
+
+// Function for random inserts, finds and erases compared with reference
+
+static bool randomOperations(const std::vector<IpAddress>& addresses) {
+    std::mt19937 random(1071);
+    ProbeTable table(TABLE_CAPACITY);
+    std::unordered_map<ProbeKey, uint32_t, ProbeKeyHash> reference;
+    std::vector<ProbeKey> stored;
+    std::vector<bool> used(TABLE_CAPACITY, false);
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        // Inserts prevail in phases, so table is filled to full and emptied again
+        bool filling = (round / 50000) % 2 == 0;
+        uint32_t operation = random() % 10;
+        if (operation < (filling ? 6u : 3u)) {
+            ProbeKey key = randomKey(random, addresses);
+            uint32_t id = table.insert(key);
+            bool expected = reference.count(key) == 0 && reference.size() < TABLE_CAPACITY;
+            if ((id != NO_PROBE) != expected) return false;
+            if (id == NO_PROBE) continue;
+            // Identifier of new record is not used by other stored probe
+            if (id >= TABLE_CAPACITY || used[id]) return false;
+            used[id] = true;
+            table.at(id).index = id;
+            reference[key] = id;
+            stored.push_back(key);
+        } else if (operation < 8 && !stored.empty()) {
+            size_t position = random() % stored.size();
+            ProbeKey key = stored[position];
+            stored[position] = stored.back();
+            stored.pop_back();
+            used[reference[key]] = false;
+            table.erase(reference[key]);
+            reference.erase(key);
+            if (table.find(key) != NO_PROBE) return false;
+        } else {
+            ProbeKey key = randomKey(random, addresses);
+            auto entry = reference.find(key);
+            if (table.find(key) != (entry == reference.end() ? NO_PROBE : entry->second)) return false;
+        }
+        if (round % 997 == 0 && !matchesReference(table, reference)) return false;
+    }
+    return matchesReference(table, reference);
+}
+
+int main() {
+    // Addresses of both families, IPv4 address and IPv6 address with the same first bytes are different keys
+    std::vector<IpAddress> addresses;
+    for (const char* address : {"192.0.2.1", "192.0.2.2", "198.51.100.7", "10.0.0.1"}) addresses.push_back(IpAddress::fromString(AF_INET, address));
+    for (const char* address : {"2001:db8::1", "2001:db8::2", "c000:201::", "fe80::1"}) addresses.push_back(IpAddress::fromString(AF_INET6, address));
+
+    // Empty table
+    ProbeTable table(4);
+    ProbeKey key{addresses[0], 80, 50000};
+    report("TEST01: empty table", table.empty() && table.size() == 0 && table.find(key) == NO_PROBE);
+
+    // Inserted probe is found, the same probe cannot be inserted twice, reply with swapped ports is other key
+    uint32_t id = table.insert(key);
+    bool passed = id != NO_PROBE && table.find(key) == id && table.insert(key) == NO_PROBE && table.size() == 1;
+    passed = passed && table.find(ProbeKey{addresses[0], 50000, 80}) == NO_PROBE;
+    report("TEST02: insert and find", passed);
+
+    // Full table refuses new probe, erased probe frees its record
+    for (uint16_t port = 81; port < 84; port++) table.insert(ProbeKey{addresses[0], port, 50000});
+    passed = table.full() && table.insert(ProbeKey{addresses[1], 80, 50000}) == NO_PROBE;
+    table.erase(id);
+    passed = passed && !table.full() && table.find(key) == NO_PROBE && table.insert(ProbeKey{addresses[1], 80, 50000}) == id;
+    report("TEST03: full table and reuse of record", passed);
+
+    // Erased probe clears flag of queue of retransmissions, so its stale identifier is skipped
+    table.at(id).queued = true;
+    table.erase(id);
+    report("TEST04: erase clears queued flag", !table.at(id).queued && table.size() == 3);
+
+    // Table without records
+    ProbeTable none(0);
+    report("TEST05: table without records", none.full() && none.insert(key) == NO_PROBE && none.find(key) == NO_PROBE);
+
+    // Random operations against reference
+    report("TEST06: random insert/find/erase against std::unordered_map", randomOperations(addresses));
+
+    return failed == 0 ? 0 : 1;
+}
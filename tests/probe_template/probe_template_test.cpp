@@ -0,0 +1,164 @@
+/**
+ * @file probe_template_test.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Test of incremental checksums of prebuilt probes against full recomputation
+ */
+
+#include "probe_template.hpp"
+#include "pseudo_headers.hpp"
+#include "checksum.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstring>
+#include <arpa/inet.h>
+
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define NC "\033[0m"
+
+// Constants for count of random probes of each family
+#define RANDOM_ROUNDS 20000
+
+// Count of failed tests
+static int failed = 0;
+
+// Function for printing result of test
+
+static void report(const std::string& name, bool passed) {
+    std::cout << name << std::endl;
+    if (passed) std::cout << GREEN << "PASSED" << NC << std::endl;
+    else {
+        std::cout << RED << "FAILED" << NC << std::endl;
+        failed++;
+    }
+    std::cout << "-------------------------" << std::endl;
+}
+
+// Function for full computation of checksum of segment with pseudo header, checksum field of segment must be zero
+
+static uint16_t fullChecksum(const IpAddress& src, const IpAddress& dst, int protocol, const void* segment, size_t segmentLen) {
+    std::vector<char> buffer(sizeof(struct checkSumPseudoHdrIpv6) + segmentLen);
+    size_t pseudoHdrLen;
+    if (src.family == AF_INET) {
+        struct checkSumPseudoHdrIpv4 pseudoHdr;
+        memset(&pseudoHdr, 0, sizeof(pseudoHdr));
+        memcpy(&pseudoHdr.srcAddr, src.bytes, 4);
+        memcpy(&pseudoHdr.dstAddr, dst.bytes, 4);
+        pseudoHdr.protocol = protocol;
+        pseudoHdr.protocolLength = htons(segmentLen);
+        pseudoHdrLen = sizeof(pseudoHdr);
+        memcpy(buffer.data(), &pseudoHdr, pseudoHdrLen);
+    } else {
+        struct checkSumPseudoHdrIpv6 pseudoHdr;
+        memset(&pseudoHdr, 0, sizeof(pseudoHdr));
+        memcpy(&pseudoHdr.src, src.bytes, 16);
+        memcpy(&pseudoHdr.dst, dst.bytes, 16);
+        pseudoHdr.length = htonl(segmentLen);
+        pseudoHdr.next_header = protocol;
+        pseudoHdrLen = sizeof(pseudoHdr);
+        memcpy(buffer.data(), &pseudoHdr, pseudoHdrLen);
+    }
+    memcpy(buffer.data() + pseudoHdrLen, segment, segmentLen);
+    return Checksum::compute(buffer.data(), pseudoHdrLen + segmentLen);
+}
+
+// Function for checking TCP SYN header of probe against full computation
+
+static bool tcpMatches(const ProbeTemplate& probeTemplate, const IpAddress& src, const IpAddress& dst, uint16_t srcPort, uint16_t dstPort, uint32_t seq) {
+    struct tcphdr tcpHeader;
+    probeTemplate.buildTcpSyn(srcPort, dstPort, seq, tcpHeader);
+    uint16_t checksum = tcpHeader.th_sum;
+    tcpHeader.th_sum = 0;
+    return checksum == fullChecksum(src, dst, IPPROTO_TCP, &tcpHeader, sizeof(tcpHeader)) && ntohs(tcpHeader.th_sport) == srcPort &&
+           ntohs(tcpHeader.th_dport) == dstPort && ntohl(tcpHeader.th_seq) == seq && tcpHeader.th_flags == TH_SYN;
+}
+
+// Function for checking UDP datagram of probe against full computation
+
+static bool udpMatches(const ProbeTemplate& probeTemplate, const IpAddress& src, const IpAddress& dst, uint16_t srcPort, uint16_t dstPort, const uint8_t* payload, size_t payloadLen) {
+    char datagram[sizeof(struct udphdr) + UDP_PAYLOAD_MAX];
+    size_t length = probeTemplate.buildUdp(srcPort, dstPort, payload, payloadLen, datagram);
+    if (length != sizeof(struct udphdr) + payloadLen || memcmp(datagram + sizeof(struct udphdr), payload, payloadLen) != 0) return false;
+    struct udphdr udpHeader;
+    memcpy(&udpHeader, datagram, sizeof(udpHeader));
+    if (ntohs(udpHeader.len) != length || ntohs(udpHeader.source) != srcPort || ntohs(udpHeader.dest) != dstPort) return false;
+    uint16_t checksum = udpHeader.check;
+    udpHeader.check = 0;
+    memcpy(datagram, &udpHeader, sizeof(udpHeader));
+    uint16_t expected = fullChecksum(src, dst, IPPROTO_UDP, datagram, length);
+    // Zero checksum of UDP is sent as all ones
+    return checksum == (expected == 0 ? 0xFFFF : expected);
+}
+
+// Function for creating random address of family
+
+static IpAddress randomAddress(std::mt19937& random, sa_family_t family) {
+    IpAddress address;
+    address.family = family;
+    for (size_t i = 0; i < address.length(); i++) address.bytes[i] = random();
+    return address;
+}
+
+// Function for random probes of one family, destination changes between probes, so checksums are patched repeatedly
+
+static bool randomProbes(sa_family_t family) {
+    std::mt19937 random(1071);
+    IpAddress src = randomAddress(random, family);
+    ProbeTemplate probeTemplate(src);
+    IpAddress dst = randomAddress(random, family);
+    uint8_t payload[UDP_PAYLOAD_MAX];
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        if (round % 3 == 0) {
+            dst = randomAddress(random, family);
+            probeTemplate.setDestination(dst);
+        }
+        uint16_t srcPort = random(), dstPort = random();
+        if (!tcpMatches(probeTemplate, src, dst, srcPort, dstPort, random())) return false;
+        // Every length of payload including odd ones, some of them full of 0xFF to check carries
+        size_t payloadLen = round % (UDP_PAYLOAD_MAX + 1);
+        bool ones = round % 7 == 0;
+        for (size_t i = 0; i < payloadLen; i++) payload[i] = ones ? 0xFF : random();
+        if (!udpMatches(probeTemplate, src, dst, srcPort, dstPort, payload, payloadLen)) return false;
+    }
+    return true;
+}
+
+int main() {
+    // Probes to fixed addresses of both families
+    IpAddress src4 = IpAddress::fromString(AF_INET, "192.0.2.1");
+    IpAddress dst4 = IpAddress::fromString(AF_INET, "198.51.100.7");
+    IpAddress src6 = IpAddress::fromString(AF_INET6, "2001:db8::1");
+    IpAddress dst6 = IpAddress::fromString(AF_INET6, "2001:db8:ffff::abcd");
+    ProbeTemplate template4(src4), template6(src6);
+    template4.setDestination(dst4);
+    template6.setDestination(dst6);
+    report("TEST01: TCP SYN over IPv4", tcpMatches(template4, src4, dst4, 50000, 80, 0x12345678) && tcpMatches(template4, src4, dst4, 65535, 65535, 0xFFFFFFFF));
+    report("TEST02: TCP SYN over IPv6", tcpMatches(template6, src6, dst6, 50000, 443, 0x9abcdef0) && tcpMatches(template6, src6, dst6, 0, 0, 0));
+
+    // Empty, even and odd payloads, the last byte of odd payload is padded by zero
+    const uint8_t payload[] = {0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde};
+    bool passed = true;
+    for (size_t payloadLen : {0, 1, 2, 3, 7}) {
+        passed = passed && udpMatches(template4, src4, dst4, 50000, 53, payloadLen ? payload : nullptr, payloadLen);
+        passed = passed && udpMatches(template6, src6, dst6, 50000, 53, payloadLen ? payload : nullptr, payloadLen);
+    }
+    report("TEST03: UDP with empty, even and odd payloads", passed);
+
+    // Destination changed back and forth patches checksum only by difference of addresses
+    template4.setDestination(src4);
+    template4.setDestination(dst4);
+    template6.setDestination(IpAddress::fromString(AF_INET6, "::"));
+    template6.setDestination(dst6);
+    passed = tcpMatches(template4, src4, dst4, 1, 2, 3) && udpMatches(template4, src4, dst4, 1, 2, payload, 5);
+    passed = passed && tcpMatches(template6, src6, dst6, 1, 2, 3) && udpMatches(template6, src6, dst6, 1, 2, payload, 5);
+    report("TEST04: repeated change of destination", passed);
+
+    // Random probes against full computation
+    report("TEST05: random probes over IPv4 against full computation", randomProbes(AF_INET));
+    report("TEST06: random probes over IPv6 against full computation", randomProbes(AF_INET6));
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file scan_permutation_test.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Test of pseudo-random order of probes
+ */
+
+#include "scan_permutation.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define NC "\033[0m"
+
+// Constants for seeds of tested permutations
+#define TEST_SEED 1071
+#define OTHER_SEED 1072
+
+// Count of failed tests
+static int failed = 0;
+
+// Function for printing result of test
+
+static void report(const std::string& name, bool passed) {
+    std::cout << name << std::endl;
+    if (passed) std::cout << GREEN << "PASSED" << NC << std::endl;
+    else {
+        std::cout << RED << "FAILED" << NC << std::endl;
+        failed++;
+    }
+    std::cout << "-------------------------" << std::endl;
+}
+
+// Function for checking that every index of 0 .. size - 1 is returned for exactly one position
+
+static bool isBijection(uint64_t size, uint64_t seed) {
+    ScanPermutation permutation(size, seed);
+    std::vector<bool> seen(size, false);
+    for (uint64_t index = 0; index < size; index++) {
+        uint64_t value = permutation.at(index);
+        if (value >= size || seen[value]) return false;
+        seen[value] = true;
+    }
+    return true;
+}
+
+// Function for getting whole order of permutation
+
+static std::vector<uint64_t> order(uint64_t size, uint64_t seed) {
+    ScanPermutation permutation(size, seed);
+    std::vector<uint64_t> values;
+    for (uint64_t index = 0; index < size; index++) values.push_back(permutation.at(index));
+    return values;
+}
+
+int main() {
+    // Sizes below and above even count of bits, one and two indexes have only trivial halves
+    const uint64_t sizes[] = {1, 2, 3, 17, 100003};
+
+    int test = 1;
+    for (uint64_t size : sizes) {
+        bool passed = isBijection(size, TEST_SEED) && isBijection(size, OTHER_SEED);
+        report("TEST0" + std::to_string(test++) + ": bijection onto [0," + std::to_string(size) + ")", passed);
+    }
+
+    // The same seed gives the same order, also from other instance
+    bool passed = true;
+    for (uint64_t size : sizes) passed = passed && order(size, TEST_SEED) == order(size, TEST_SEED);
+    report("TEST06: the same seed gives the same order", passed);
+
+    // Other seed gives other order, where there are enough orders to differ
+    passed = order(17, TEST_SEED) != order(17, OTHER_SEED) && order(100003, TEST_SEED) != order(100003, OTHER_SEED);
+    report("TEST07: other seed gives other order", passed);
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file timing_wheel_test.cpp
+ * @author Martin Zůbek, x253206
+ * @date 17.10. 2026
+ * @brief Test of hierarchical timing wheel against reference of timers
+ */
+
+#include "timing_wheel.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define NC "\033[0m"
+
+// Constants for count of entries of tested wheel and count of random operations
+#define WHEEL_CAPACITY 512
+#define RANDOM_ROUNDS 300000
+// Constants for max distance of timer which wheel holds without limiting it
+#define TEST_WHEEL_RANGE (1ULL << (WHEEL_FIRST_BITS + (WHEEL_LEVELS - 1) * WHEEL_LEVEL_BITS))
+// Constants for entry without timer in reference
+#define NO_TIMER UINT64_MAX
+
+// Count of failed tests
+static int failed = 0;
+
+// Function for printing result of test
+
+static void report(const std::string& name, bool passed) {
+    std::cout << name << std::endl;
+    if (passed) std::cout << GREEN << "PASSED" << NC << std::endl;
+    else {
+        std::cout << RED << "FAILED" << NC << std::endl;
+        failed++;
+    }
+    std::cout << "-------------------------" << std::endl;
+}
+
+/**
+ * @brief Reference of timing wheel, expiry of every entry is kept in array and found by scan of all entries
+ */
+struct ReferenceWheel {
+    std::vector<uint64_t> expiry = std::vector<uint64_t>(WHEEL_CAPACITY, NO_TIMER);
+    // Next tick which was not processed yet
+    uint64_t now = 0;
+
+    void advance(uint64_t tick, std::vector<uint32_t>& expired) {
+        expired.clear();
+        if (tick < this->now) return;
+        for (uint32_t id = 0; id < WHEEL_CAPACITY; id++) {
+            if (this->expiry[id] != NO_TIMER && this->expiry[id] <= tick) {
+                expired.push_back(id);
+                this->expiry[id] = NO_TIMER;
+            }
+        }
+        this->now = tick + 1;
+    }
+
+    uint64_t nearest() const {
+        uint64_t nearest = NO_TIMER;
+        for (uint64_t tick : this->expiry) nearest = std::min(nearest, tick);
+        return nearest;
+    }
+};
+
+// Function for advancing wheel and reference, both must expire the same entries
+
+static bool advanceBoth(TimingWheel& wheel, ReferenceWheel& reference, uint64_t tick) {
+    std::vector<uint32_t> expired, expected;
+    wheel.advance(tick, expired);
+    reference.advance(tick, expected);
+    std::sort(expired.begin(), expired.end());
+    return expired == expected && wheel.current() == reference.now;
+}
+
+// Function for checking that next event of wheel does not skip nearest timer
+
+static bool nextEventValid(const TimingWheel& wheel, const ReferenceWheel& reference) {
+    uint64_t nearest = reference.nearest();
+    uint64_t event = wheel.nextEvent();
+    if (nearest == NO_TIMER) return event == UINT64_MAX;
+    return event >= wheel.current() && event <= std::max(nearest, wheel.current());
+}
+
+// Function for checking timer at distance which crosses boundary of levels, it expires exactly at its tick
+
+static bool expiresAt(uint64_t start, uint64_t distance) {
+    TimingWheel wheel(4);
+    std::vector<uint32_t> expired;
+    wheel.advance(start, expired);
+    wheel.schedule(1, start + distance);
+    wheel.schedule(2, start + distance + 1);
+    // Nearest event never lies after timer, so waiting for it is safe
+    while (wheel.nextEvent() < start + distance) {
+        wheel.advance(wheel.nextEvent(), expired);
+        if (!expired.empty()) return false;
+    }
+    if (wheel.nextEvent() != start + distance) return false;
+    wheel.advance(start + distance, expired);
+    if (expired != std::vector<uint32_t>{1}) return false;
+    wheel.advance(start + distance + 1, expired);
+    return expired == std::vector<uint32_t>{2} && wheel.nextEvent() == UINT64_MAX;
+}
+
+// Function for random schedules, cancels and advances compared with reference
+
+static bool randomOperations() {
+    std::mt19937 random(1071);
+    TimingWheel wheel(WHEEL_CAPACITY);
+    ReferenceWheel reference;
+    // Distances of timers and steps of time are spread over all levels of wheel
+    const uint64_t distances[] = {4, 300, 20000, 1500000, TEST_WHEEL_RANGE / 4};
+    const uint64_t steps[] = {2, 40, 600, 30000};
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        uint32_t operation = random() % 100;
+        uint32_t id = random() % WHEEL_CAPACITY;
+        if (operation < 55) {
+            // New timer or rescheduled one, some of them are in past
+            uint64_t distance = random() % (distances[random() % 5] + 1);
+            uint64_t expiry = (random() % 20 == 0 && wheel.current() > distance) ? wheel.current() - distance : wheel.current() + distance;
+            wheel.schedule(id, expiry);
+            reference.expiry[id] = expiry;
+        } else if (operation < 70) {
+            wheel.cancel(id);
+            reference.expiry[id] = NO_TIMER;
+        } else if (operation < 85) {
+            // Scanners wait exactly for next event of wheel
+            if (!nextEventValid(wheel, reference)) return false;
+            uint64_t event = wheel.nextEvent();
+            if (event != UINT64_MAX && !advanceBoth(wheel, reference, event)) return false;
+        } else {
+            uint64_t step = random() % steps[random() % 4];
+            if (!advanceBoth(wheel, reference, wheel.current() + step)) return false;
+        }
+        if (!nextEventValid(wheel, reference)) return false;
+    }
+    // All remaining timers expire
+    uint64_t nearest;
+    while ((nearest = reference.nearest()) != NO_TIMER) {
+        if (!advanceBoth(wheel, reference, std::max(nearest, wheel.current()))) return false;
+    }
+    return wheel.nextEvent() == UINT64_MAX;
+}
+
+int main() {
+    // Empty wheel has no event and advance expires nothing
+    TimingWheel wheel(8);
+    std::vector<uint32_t> expired;
+    wheel.advance(1000, expired);
+    report("TEST01: empty wheel", wheel.nextEvent() == UINT64_MAX && expired.empty() && wheel.current() == 1001);
+
+    // Timer in past expires on next advance, cancelled timer does not expire, rescheduled timer expires once at new tick
+    wheel.schedule(0, 10);
+    wheel.schedule(1, 1005);
+    wheel.cancel(1);
+    wheel.schedule(2, 1003);
+    wheel.schedule(2, 1004);
+    wheel.advance(1001, expired);
+    bool passed = expired == std::vector<uint32_t>{0};
+    wheel.advance(1003, expired);
+    passed = passed && expired.empty();
+    wheel.advance(1010, expired);
+    passed = passed && expired == std::vector<uint32_t>{2} && wheel.nextEvent() == UINT64_MAX;
+    report("TEST02: past, cancelled and rescheduled timers", passed);
+
+    // Timers at boundaries of levels are cascaded down and expire exactly at their tick
+    passed = true;
+    std::vector<uint64_t> boundaries;
+    for (int level = 1; level < WHEEL_LEVELS; level++) {
+        uint64_t boundary = 1ULL << (WHEEL_FIRST_BITS + (level - 1) * WHEEL_LEVEL_BITS);
+        boundaries.insert(boundaries.end(), {boundary - 1, boundary, boundary + 1, boundary * 3 + 7});
+    }
+    for (uint64_t distance : boundaries) {
+        for (uint64_t start : {0ULL, 1ULL, 255ULL, 256ULL, 12345ULL, 16383ULL}) passed = passed && expiresAt(start, distance);
+    }
+    report("TEST03: cascading of timers at boundaries of levels", passed);
+
+    // Timer beyond range of wheel is limited to last level and put back until its tick
+    report("TEST04: timer beyond range of wheel", expiresAt(77, TEST_WHEEL_RANGE + 5000));
+
+    // Random operations against reference
+    report("TEST05: random schedule/cancel/advance/nextEvent against reference", randomOperations());
+
+    return failed == 0 ? 0 : 1;
+}